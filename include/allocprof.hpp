@@ -0,0 +1,176 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <string_view>
+
+namespace UTIL
+{
+    // What the calling thread is doing, for attributing heap use. Set with AllocPhaseScope.
+    enum class AllocPhase : uint8_t
+    {
+        Other,
+        Load,     // reading and indexing the database
+        Sort,     // reordering the list
+        Render,   // building and presenting screens
+        Generate, // figure metadata and directories
+        Image,    // decoding, resizing and encoding images, previews included
+        Network,  // the download loop, i.e. curl
+    };
+
+    inline constexpr int ALLOC_PHASE_COUNT = 7;
+    inline constexpr std::string_view ALLOC_PHASE_NAMES[] = {"other", "load", "sort", "render", "generate", "image", "network"};
+
+    // Frees and live bytes belong to the phase that allocated the block
+    struct AllocStats
+    {
+        uint64_t allocations = 0, frees = 0, bytes = 0;
+        int64_t live = 0, peak = 0; // bytes
+    };
+
+#ifdef AMIIBO_ALLOC_PROFILE
+    inline constexpr bool ALLOC_PROFILING = true;
+
+    namespace detail
+    {
+        struct AllocCounters
+        {
+            std::atomic<uint64_t> allocations{0}, frees{0}, bytes{0};
+            std::atomic<int64_t> live{0}, peak{0};
+        };
+
+        // Constant-initialized, so usable by allocations made before main
+        inline std::array<AllocCounters, ALLOC_PHASE_COUNT + 1> allocCounters; // last one: all phases
+        inline thread_local AllocPhase allocPhase = AllocPhase::Other;
+
+        // In front of every tracked block; 16 bytes keep malloc's alignment for the caller
+        struct alignas(16) AllocHeader
+        {
+            uint64_t size;
+            uint8_t phase;
+        };
+        static_assert(sizeof(AllocHeader) == 16);
+
+        inline void raisePeak(std::atomic<int64_t> &peak, int64_t live) noexcept
+        {
+            int64_t seen = peak.load(std::memory_order_relaxed);
+            while (live > seen && !peak.compare_exchange_weak(seen, live, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        inline void countAlloc(AllocCounters &c, uint64_t size) noexcept
+        {
+            c.allocations.fetch_add(1, std::memory_order_relaxed);
+            c.bytes.fetch_add(size, std::memory_order_relaxed);
+            raisePeak(c.peak, c.live.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed) + static_cast<int64_t>(size));
+        }
+
+        inline void countFree(AllocCounters &c, uint64_t size) noexcept
+        {
+            c.frees.fetch_add(1, std::memory_order_relaxed);
+            c.live.fetch_sub(static_cast<int64_t>(size), std::memory_order_relaxed);
+        }
+
+        inline void *track(void *base, size_t size) noexcept
+        {
+            if (!base)
+                return nullptr;
+            const auto phase = detail::allocPhase;
+            auto *header = static_cast<AllocHeader *>(base);
+            header->size = size;
+            header->phase = static_cast<uint8_t>(phase);
+            countAlloc(allocCounters[static_cast<int>(phase)], size);
+            countAlloc(allocCounters[ALLOC_PHASE_COUNT], size);
+            return header + 1;
+        }
+
+        [[nodiscard]] inline AllocHeader *untrack(void *p) noexcept
+        {
+            auto *header = static_cast<AllocHeader *>(p) - 1;
+            countFree(allocCounters[header->phase], header->size);
+            countFree(allocCounters[ALLOC_PHASE_COUNT], header->size);
+            return header;
+        }
+
+        [[nodiscard]] inline AllocStats snapshot(const AllocCounters &c) noexcept
+        {
+            AllocStats stats;
+            stats.allocations = c.allocations.load(std::memory_order_relaxed);
+            stats.frees = c.frees.load(std::memory_order_relaxed);
+            stats.bytes = c.bytes.load(std::memory_order_relaxed);
+            stats.live = c.live.load(std::memory_order_relaxed);
+            stats.peak = c.peak.load(std::memory_order_relaxed);
+            return stats;
+        }
+    } // namespace detail
+
+    // malloc/realloc/free that count; operator new and stb's allocation macros go here.
+    // Blocks must be released with trackedFree / trackedRealloc.
+    [[nodiscard]] inline void *trackedMalloc(size_t size) noexcept
+    {
+        return detail::track(std::malloc(sizeof(detail::AllocHeader) + size), size);
+    }
+
+    inline void trackedFree(void *p) noexcept
+    {
+        if (p)
+            std::free(detail::untrack(p));
+    }
+
+    // Counted as a free of the old block and an allocation in the current phase
+    [[nodiscard]] inline void *trackedRealloc(void *p, size_t size) noexcept
+    {
+        if (!p)
+            return trackedMalloc(size);
+        auto *header = static_cast<detail::AllocHeader *>(p) - 1;
+        void *moved = std::realloc(header, sizeof(detail::AllocHeader) + size);
+        if (!moved)
+            return nullptr; // the old block is untouched and still counted
+        auto *old = static_cast<detail::AllocHeader *>(moved);
+        detail::countFree(detail::allocCounters[old->phase], old->size);
+        detail::countFree(detail::allocCounters[ALLOC_PHASE_COUNT], old->size);
+        return detail::track(moved, size);
+    }
+
+    // Attributes the calling thread's allocations to a phase until the end of the block
+    class AllocPhaseScope
+    {
+        AllocPhase previous_;
+
+    public:
+        explicit AllocPhaseScope(AllocPhase phase) noexcept : previous_(detail::allocPhase) { detail::allocPhase = phase; }
+        ~AllocPhaseScope() { detail::allocPhase = previous_; }
+        AllocPhaseScope(const AllocPhaseScope &) = delete;
+        AllocPhaseScope &operator=(const AllocPhaseScope &) = delete;
+    };
+
+    [[nodiscard]] inline AllocStats allocStats(AllocPhase phase) noexcept { return detail::snapshot(detail::allocCounters[static_cast<int>(phase)]); }
+    [[nodiscard]] inline AllocStats allocTotals() noexcept { return detail::snapshot(detail::allocCounters[ALLOC_PHASE_COUNT]); }
+#else
+    inline constexpr bool ALLOC_PROFILING = false;
+
+    class AllocPhaseScope
+    {
+    public:
+        explicit AllocPhaseScope(AllocPhase) noexcept {}
+        AllocPhaseScope(const AllocPhaseScope &) = delete;
+        AllocPhaseScope &operator=(const AllocPhaseScope &) = delete;
+    };
+
+    [[nodiscard]] inline AllocStats allocStats(AllocPhase) noexcept { return {}; }
+    [[nodiscard]] inline AllocStats allocTotals() noexcept { return {}; }
+#endif
+
+    // Releases memory stb handed out (STBIW_MALLOC / STBI_MALLOC), whichever allocator backs it
+    inline void stbFree(void *p) noexcept
+    {
+#ifdef AMIIBO_ALLOC_PROFILE
+        trackedFree(p);
+#else
+        std::free(p);
+#endif
+    }
+} // namespace UTIL
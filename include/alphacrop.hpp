@@ -0,0 +1,152 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define AMIIBO_ALPHACROP_NEON 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define AMIIBO_ALPHACROP_SSE2 1
+#endif
+
+namespace UTIL
+{
+    // Pixel rectangle, right/bottom exclusive
+    struct CropRect
+    {
+        int left = 0, top = 0, right = 0, bottom = 0;
+
+        [[nodiscard]] int width() const noexcept { return right - left; }
+        [[nodiscard]] int height() const noexcept { return bottom - top; }
+    };
+
+    namespace detail
+    {
+        // First pixel in [begin, end) of an RGBA row with non-zero alpha, or end
+        [[nodiscard]] inline int firstOpaqueRgba(const uint8_t *row, int begin, int end) noexcept
+        {
+            int x = begin;
+#if defined(AMIIBO_ALPHACROP_NEON)
+            for (; x + 16 <= end; x += 16)
+            {
+                const uint8x16x4_t px = vld4q_u8(row + x * 4);
+                if (vmaxvq_u8(px.val[3]) != 0)
+                    break;
+            }
+#elif defined(AMIIBO_ALPHACROP_SSE2)
+            const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+            const __m128i zero = _mm_setzero_si128();
+            for (; x + 4 <= end; x += 4)
+            {
+                const __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + x * 4));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(px, alphaMask), zero)) != 0xFFFF)
+                    break;
+            }
+#endif
+            for (; x < end; ++x)
+                if (row[x * 4 + 3])
+                    return x;
+            return end;
+        }
+
+        // Last pixel in [begin, end) of an RGBA row with non-zero alpha, or begin - 1
+        [[nodiscard]] inline int lastOpaqueRgba(const uint8_t *row, int begin, int end) noexcept
+        {
+            int x = end;
+#if defined(AMIIBO_ALPHACROP_NEON)
+            for (; x - 16 >= begin; x -= 16)
+            {
+                const uint8x16x4_t px = vld4q_u8(row + (x - 16) * 4);
+                if (vmaxvq_u8(px.val[3]) != 0)
+                    break;
+            }
+#elif defined(AMIIBO_ALPHACROP_SSE2)
+            const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+            const __m128i zero = _mm_setzero_si128();
+            for (; x - 4 >= begin; x -= 4)
+            {
+                const __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + (x - 4) * 4));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(px, alphaMask), zero)) != 0xFFFF)
+                    break;
+            }
+#endif
+            for (--x; x >= begin; --x)
+                if (row[x * 4 + 3])
+                    return x;
+            return begin - 1;
+        }
+
+        [[nodiscard]] inline bool rowHasAlpha(const uint8_t *row, int width, int channels) noexcept
+        {
+            if (channels == 4)
+                return firstOpaqueRgba(row, 0, width) < width;
+            for (int x = 0; x < width; ++x)
+                if (row[x * channels + channels - 1])
+                    return true;
+            return false;
+        }
+    } // namespace detail
+
+    // Bounding box of all pixels with non-zero alpha. Returns nullopt for images without
+    // an alpha channel and for fully transparent images, where there is nothing to crop to.
+    [[nodiscard]] inline std::optional<CropRect> findOpaqueBounds(const uint8_t *data, int width, int height, int channels) noexcept
+    {
+        if (!data || width <= 0 || height <= 0 || (channels != 2 && channels != 4))
+            return std::nullopt;
+
+        const auto rowPtr = [&](int y)
+        { return data + static_cast<size_t>(y) * static_cast<size_t>(width) * static_cast<size_t>(channels); };
+
+        int top = 0;
+        while (top < height && !detail::rowHasAlpha(rowPtr(top), width, channels))
+            ++top;
+        if (top == height)
+            return std::nullopt;
+
+        int bottom = height;
+        while (bottom - 1 > top && !detail::rowHasAlpha(rowPtr(bottom - 1), width, channels))
+            --bottom;
+
+        // Each row only needs scanning outside the span found so far
+        int left = width, right = 0;
+        for (int y = top; y < bottom; ++y)
+        {
+            const uint8_t *row = rowPtr(y);
+            if (channels == 4)
+            {
+                left = std::min(left, detail::firstOpaqueRgba(row, 0, left));
+                right = std::max(right, detail::lastOpaqueRgba(row, right, width) + 1);
+            }
+            else
+            {
+                for (int x = 0; x < left; ++x)
+                    if (row[x * 2 + 1])
+                    {
+                        left = x;
+                        break;
+                    }
+                for (int x = width - 1; x >= right; --x)
+                    if (row[x * 2 + 1])
+                    {
+                        right = x + 1;
+                        break;
+                    }
+            }
+        }
+
+        return CropRect{left, top, std::max(right, left + 1), bottom};
+    }
+
+    // Grow a rect by padding pixels on every side, clamped to the image
+    [[nodiscard]] constexpr CropRect padCropRect(CropRect rect, int padding, int width, int height) noexcept
+    {
+        rect.left = std::max(0, rect.left - padding);
+        rect.top = std::max(0, rect.top - padding);
+        rect.right = std::min(width, rect.right + padding);
+        rect.bottom = std::min(height, rect.bottom + padding);
+        return rect;
+    }
+} // namespace UTIL
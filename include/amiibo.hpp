@@ -1,13 +1,16 @@
 #pragma once
 
-#include <fstream>
 #include <vector>
 #include <algorithm>
+#include <cerrno>
 #include <filesystem>
 #include <optional>
 #include <string>
 #include <string_view>
 
+#include "catalog.hpp"
+#include "durable.hpp"
+#include "textnorm.hpp"
 #include "util.hpp"
 #include "libs/json.hpp"
 
@@ -16,7 +19,7 @@ using json = nlohmann::json;
 class Amiibo
 {
 private:
-    static constexpr std::string_view AMIIBO_BASE_PATH = "sdmc:/emuiibo/amiibo/";
+    static constexpr std::string_view AMIIBO_BASE_PATH = UTIL::AMIIBO_FIGURES_PATH;
 
     struct AmiiboId
     {
@@ -39,8 +42,9 @@ private:
         }
     };
 
-    // Helper function to sanitize names for filesystem
-    [[nodiscard]] static std::string sanitizePath(std::string_view input)
+    // Directory names as earlier versions wrote them: non-ASCII bytes dropped outright.
+    // Only used to find figures generated before names were transliterated.
+    [[nodiscard]] static std::string legacySanitizePath(std::string_view input)
     {
         std::string result;
         result.reserve(input.size());
@@ -65,34 +69,41 @@ private:
         return static_cast<int>(val);
     }
 
-    // Helper to validate and get amiibo data
-    [[nodiscard]] bool validateAmiiboData(std::string &head, std::string &tail) const
+    // Helper to build amiibo path
+    [[nodiscard]] std::string buildAmiiboPath(std::string_view amiiboId, bool legacy = false) const
     {
-        if (!amiibo_.contains("head") || !amiibo_.contains("tail"))
+        if (record_.amiiboSeries.empty() || record_.name.empty())
+            return {};
+
+        std::string series, name;
+        if (legacy)
         {
-            std::fputs("Error: Missing head or tail in amiibo data\n", stderr);
-            return false;
+            series = legacySanitizePath(record_.amiiboSeries);
+            name = legacySanitizePath(record_.name);
         }
-        head = amiibo_["head"].get<std::string>();
-        tail = amiibo_["tail"].get<std::string>();
-        return true;
+        else
+        {
+            series = UTIL::foldText(record_.amiiboSeries, UTIL::TextForm::Path);
+            name = UTIL::foldText(record_.name, UTIL::TextForm::Path);
+        }
+        return std::string(AMIIBO_BASE_PATH) + series + "/" + name + "_" + std::string(amiiboId) + "/";
     }
 
-    // Helper to build amiibo path
-    [[nodiscard]] std::string buildAmiiboPath(std::string_view amiiboId) const
+    // The figure's directory if it is on the card under either spelling, else the current one
+    [[nodiscard]] std::string findAmiiboPath(std::string_view amiiboId) const
     {
-        if (!amiibo_.contains("amiiboSeries") || !amiibo_.contains("name"))
-            return {};
-
-        const auto series = sanitizePath(amiibo_["amiiboSeries"].get<std::string>());
-        const auto name = sanitizePath(amiibo_["name"].get<std::string>());
-        return std::string(AMIIBO_BASE_PATH) + series + "/" + name + "_" + std::string(amiiboId) + "/";
+        std::string path = buildAmiiboPath(amiiboId);
+        std::error_code ec;
+        if (path.empty() || std::filesystem::exists(path, ec))
+            return path;
+        std::string legacy = buildAmiiboPath(amiiboId, true);
+        return legacy != path && std::filesystem::exists(legacy, ec) ? legacy : path;
     }
 
-    json amiibo_;
+    UTIL::AmiiboRecord record_;
 
 public:
-    explicit Amiibo(const json &data) : amiibo_(data) {}
+    explicit Amiibo(UTIL::AmiiboRecord record) : record_(std::move(record)) {}
     ~Amiibo() = default;
 
     Amiibo(const Amiibo &) = delete;
@@ -100,33 +111,69 @@ public:
     Amiibo(Amiibo &&) noexcept = default;
     Amiibo &operator=(Amiibo &&) noexcept = default;
 
-    [[nodiscard]] const json &data() const noexcept { return amiibo_; }
+    [[nodiscard]] const UTIL::AmiiboRecord &record() const noexcept { return record_; }
+
+    // head + tail, empty if either is missing
+    [[nodiscard]] std::string id() const { return record_.id(); }
 
-    [[nodiscard]] bool generate(bool withImage = false)
+    // Where generate() stores the image, empty if the data is incomplete
+    [[nodiscard]] std::string imagePath() const
     {
+        const std::string amiiboId = id();
+        if (!AmiiboId::parse(amiiboId))
+            return {};
+        const std::string path = findAmiiboPath(amiiboId);
+        return path.empty() ? std::string() : path + "amiibo.png";
+    }
+
+    // Image URL from the database entry, empty if there is none
+    [[nodiscard]] const std::string &imageUrl() const noexcept { return record_.image; }
+
+    [[nodiscard]] bool generate(bool withImage = false, const UTIL::ImageOptions &imageOptions = {})
+    {
+        const UTIL::TraceScope trace("generate", "figure");
+        const UTIL::AllocPhaseScope phase(UTIL::AllocPhase::Generate);
+        const std::string path = writeFigure();
+        if (path.empty())
+            return false;
+
+        // Download image if requested
+        const std::string url = imageUrl();
+        if (withImage && !url.empty())
+        {
+            const std::string imagePath = path + "amiibo.png";
+            if (UTIL::downloadFile(url, imagePath) == 0)
+                (void)UTIL::loadAndResizeImageInRatio(imagePath, imageOptions); // failures are reported per stage
+        }
+        return true;
+    }
+
+    // Create the figure directory with amiibo.flag and amiibo.json. Returns the directory,
+    // or an empty string if the figure exists already (*exists set) or could not be written.
+    [[nodiscard]] std::string writeFigure(bool *exists = nullptr)
+    {
+        if (exists)
+            *exists = false;
         // Get current date/time
         const time_t unixTime = std::time(nullptr);
-        const struct tm *ts = std::gmtime(&unixTime);
+        struct tm tsBuf{};
+        const struct tm *ts = gmtime_r(&unixTime, &tsBuf); // figures are generated in parallel
         if (!ts)
         {
-            std::fputs("Error: Failed to get current time\n", stderr);
-            return false;
+            UTIL::report(UTIL::ProgressStage::Validate, UTIL::ProgressCode::InvalidData);
+            return {};
         }
         const int day = ts->tm_mday;
         const int month = ts->tm_mon + 1;
         const int year = ts->tm_year + 1900;
 
         // Validate and parse amiibo data
-        std::string head, tail;
-        if (!validateAmiiboData(head, tail))
-            return false;
-
-        const std::string amiiboId = head + tail;
+        const std::string amiiboId = this->id();
         const auto id = AmiiboId::parse(amiiboId);
         if (!id)
         {
-            std::fputs("Amiibo ID is invalid\n", stderr);
-            return false;
+            UTIL::report(UTIL::ProgressStage::Validate, UTIL::ProgressCode::InvalidData);
+            return {};
         }
 
         // Convert hex values to integers
@@ -138,13 +185,13 @@ public:
 
         if (!cgid || !cvar || !ftype || !mnum || !snum)
         {
-            std::fputs("Error: Invalid hex values in amiibo ID\n", stderr);
-            return false;
+            UTIL::report(UTIL::ProgressStage::Validate, UTIL::ProgressCode::InvalidData);
+            return {};
         }
 
         // Build amiibo data JSON
         json amiiboData;
-        amiiboData["name"] = amiibo_["name"];
+        amiiboData["name"] = record_.name;
         amiiboData["write_counter"] = 0;
         amiiboData["version"] = 0;
         amiiboData["first_write_date"] = {{"y", year}, {"m", month}, {"d", day}};
@@ -168,70 +215,58 @@ public:
         const std::string path = buildAmiiboPath(amiiboId);
         if (path.empty())
         {
-            std::fputs("Error: Missing amiiboSeries or name\n", stderr);
-            return false;
+            UTIL::report(UTIL::ProgressStage::Validate, UTIL::ProgressCode::InvalidData);
+            return {};
         }
 
-        // Check if already exists
+        // Check if already exists, also under the name older versions gave it
         std::error_code ec;
-        if (std::filesystem::exists(path, ec))
+        if (std::filesystem::exists(findAmiiboPath(amiiboId), ec))
         {
-            std::puts("Amiibo already exists.");
-            return false;
+            UTIL::report(UTIL::ProgressStage::Directory, UTIL::ProgressCode::Exists);
+            if (exists)
+                *exists = true;
+            return {};
         }
 
         // Create directory
-        if (!std::filesystem::create_directories(path, ec) && ec)
-        {
-            std::fprintf(stderr, "Error: Failed to create directory: %s\n", ec.message().c_str());
-            return false;
-        }
-
-        // Write amiibo.flag
-        if (std::ofstream flag(path + "amiibo.flag"); !flag)
-        {
-            std::fputs("Error: Failed to create amiibo.flag\n", stderr);
-            return false;
-        }
-
-        // Write amiibo.json
-        if (std::ofstream jsonFile(path + "amiibo.json"); jsonFile)
-            jsonFile << amiiboData.dump(2);
-        else
         {
-            std::fputs("Error: Failed to create amiibo.json\n", stderr);
-            return false;
+            const UTIL::TraceScope trace("mkdir", "sd");
+            if (!std::filesystem::create_directories(path, ec) && ec)
+            {
+                UTIL::report(UTIL::ProgressStage::Directory, UTIL::ProgressCode::IoError, ec.value());
+                return {};
+            }
         }
 
-        // Download image if requested
-        if (withImage && amiibo_.contains("image"))
+        // amiibo.json first and amiibo.flag last: emuiibo only lists folders with the flag,
+        // so an interrupted write never shows up as a figure
+        const UTIL::TraceScope trace("metadata", "sd");
+        if (!UTIL::writeWholeFile(path + "amiibo.json", amiiboData.dump(2)) || !UTIL::writeWholeFile(path + "amiibo.flag", {}))
         {
-            const std::string imageUrl = amiibo_["image"].get<std::string>();
-            const std::string imagePath = path + "amiibo.png";
-            if (UTIL::downloadFile(imageUrl, imagePath) == 0)
-            {
-                if (!UTIL::loadAndResizeImageInRatio(imagePath))
-                    std::fputs("Warning: Failed to resize image\n", stderr);
-            }
+            UTIL::report(UTIL::ProgressStage::Metadata, UTIL::ProgressCode::IoError, errno);
+            return {};
         }
 
-        return true;
+        return path;
     }
 
     [[nodiscard]] bool erase()
     {
-        std::string head, tail;
-        if (!validateAmiiboData(head, tail))
+        if (record_.head.empty() || record_.tail.empty())
+        {
+            std::fputs("Error: Missing head or tail in amiibo data\n", stderr);
             return false;
+        }
 
-        const std::string amiiboId = head + tail;
+        const std::string amiiboId = record_.id();
         if (!AmiiboId::parse(amiiboId))
         {
             std::fputs("Amiibo ID is invalid\n", stderr);
             return false;
         }
 
-        const std::string path = buildAmiiboPath(amiiboId);
+        const std::string path = findAmiiboPath(amiiboId);
         if (path.empty())
         {
             std::fputs("Error: Missing amiiboSeries or name\n", stderr);
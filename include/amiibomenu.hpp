@@ -5,53 +5,158 @@
 #include <string_view>
 #include <filesystem>
 #include <algorithm>
+#include <atomic>
+#include <climits>
 #include <cstdint>
 #include <cstdlib>
 #include <fstream>
+#include <iterator>
+#include <memory>
+#include <vector>
 
-#include "libs/json.hpp"
 #include "amiibo.hpp"
-
-using json = nlohmann::json;
+#include "catalog.hpp"
+#include "config.hpp"
+#include "coverage.hpp"
+#include "downloader.hpp"
+#include "durable.hpp"
+#include "history.hpp"
+#include "kinetic.hpp"
+#include "preview.hpp"
+#include "scheduler.hpp"
+#include "terminal.hpp"
+#include "treewalk.hpp"
+#include "textnorm.hpp"
 
 class AmiiboMenu
 {
-    static constexpr int VISIBLE_ITEMS = 38;
+    // Screen layout in terminal rows/columns; the preview panel sits right of the list
+    static constexpr int LIST_TOP = 5;
+    static constexpr int VISIBLE_ITEMS = UI::Terminal::ROWS - LIST_TOP;
+    static constexpr int PREVIEW_COL = 124;
+    static constexpr int PREVIEW_X = PREVIEW_COL * UI::FONT::GLYPH_WIDTH;
+    static constexpr int PREVIEW_Y = LIST_TOP * UI::FONT::GLYPH_HEIGHT;
+    static constexpr int PREVIEW_WIDTH = 256;
+    static constexpr int PREVIEW_HEIGHT = 330;
+
+    // Main loop runs at display rate; D-pad repeat keeps the old 250 ms delay / 50 ms rate
+    static constexpr u64 FRAME_NS = 16666667ULL;
+    static constexpr int DOWNLOAD_PENDING = INT_MIN; // no result code uses it
+    static constexpr int HOLD_DELAY_FRAMES = 15;
+    static constexpr int HOLD_REPEAT_FRAMES = 3;
+
     static constexpr int SORT_OPTIONS_COUNT = 4;
     static constexpr std::string_view SORT_FIELDS[] = {"amiiboSeries", "amiiboSeries", "name", "name"};
+    // Ranks of the folded keys, so "Pokémon" sorts with "Pokemon" and case does not split the list
+    static constexpr uint32_t UTIL::AmiiboRecord::*SORT_MEMBERS[] = {
+        &UTIL::AmiiboRecord::seriesRank, &UTIL::AmiiboRecord::seriesRank, &UTIL::AmiiboRecord::nameRank, &UTIL::AmiiboRecord::nameRank};
     static constexpr char SORT_DIRECTIONS[] = {'A', 'D', 'A', 'D'};
 
-    json amiibodata_;
+    // How one figure of a generation batch ended
+    enum class FigureResult : uint8_t
+    {
+        Pending,
+        Generated,
+        NoImage, // written, but the image download or resize failed
+        Exists,
+        Failed,
+    };
+
+    struct Entry
+    {
+        UTIL::AmiiboRecord record;
+        bool selected = false;
+        bool fresh = false; // added or changed by the last database update
+        uint32_t catalogIndex = 0; // position in the loaded catalog, the coverage bit
+    };
+
+    std::vector<Entry> amiibos_;
+    std::vector<Entry> hiddenAmiibos_; // filtered out while newOnly_ is set
+    bool newOnly_ = false;
+    int freshCount_ = 0;
+    UTIL::CollectionCoverage coverage_;
+    std::vector<std::string> seriesLabels_; // per series rank, as displayed
+    int coverageCursor_ = 0;
+    UTIL::CatalogKeys keys_; // what the records' sort ranks refer to
     int selectedCount_ = 0;
     int cursorIndex_ = 0;
     int scrollOffset_ = 0;
     int sortIndex_ = 0;
     bool withImage_ = false;
+    UTIL::ImageOptions imageOptions_{};
+    UTIL::Durability durability_ = UTIL::Durability::Batch;
     bool shouldExit_ = false;
     PadState pad_{};
     int holdUpTicks_ = 0;
     int holdDownTicks_ = 0;
+    UI::KineticScroller scroller_{static_cast<float>(UI::FONT::GLYPH_HEIGHT)};
+    bool touchHeld_ = false;
+    int touchRow_ = -1;
+    std::unique_ptr<UTIL::Scheduler> scheduler_ = std::make_unique<UTIL::Scheduler>(); // before preview_, which queues on it
+    std::unique_ptr<UTIL::Downloader> downloader_;                                      // shared by previews, images and the database
+    std::unique_ptr<UTIL::PreviewLoader> preview_;
+    std::shared_ptr<const UTIL::PreviewImage> shownPreview_;
+    std::string_view previewLabel_;
 
-    template <typename T>
-    [[nodiscard]] static T getJsonValue(const json &obj, std::string_view key, const T &defVal = T{})
+    [[nodiscard]] int total() const noexcept { return static_cast<int>(amiibos_.size()); }
+    [[nodiscard]] bool isValidIndex(int idx) const noexcept { return idx >= 0 && idx < total(); }
+
+    // Adds the catalog to the history when it differs from the newest snapshot, and
+    // returns the ids the last change added or modified, ascending
+    [[nodiscard]] static std::vector<uint64_t> updateHistory(UTIL::CatalogSnapshot snapshot)
     {
-        const std::string keyStr(key);
-        if (obj.contains(keyStr))
-        {
-            try
-            {
-                return obj[keyStr].get<T>();
-            }
-            catch (...)
-            {
-            }
-        }
-        return defVal;
+        std::vector<UTIL::CatalogSnapshot> history;
+        (void)UTIL::loadHistory(UTIL::HISTORY_PATH, history); // missing or unreadable: start over
+        if (UTIL::pushSnapshot(history, std::move(snapshot)) && !UTIL::saveHistory(UTIL::HISTORY_PATH, history))
+            UTIL::printError("Warning: Failed to save catalog history\n");
+        if (history.size() < 2)
+            return {};
+
+        const auto diff = UTIL::diffSnapshots(history[history.size() - 2], history.back());
+        std::vector<uint64_t> fresh;
+        fresh.reserve(diff.added.size() + diff.changed.size());
+        std::merge(diff.added.begin(), diff.added.end(), diff.changed.begin(), diff.changed.end(), std::back_inserter(fresh));
+        return fresh;
     }
 
-    [[nodiscard]] bool isValidIndex(int idx) const noexcept
+    void setCatalog(std::vector<UTIL::AmiiboRecord> records)
     {
-        return idx >= 0 && idx < static_cast<int>(amiibodata_["amiibo"].size());
+        const UTIL::AllocPhaseScope phase(UTIL::AllocPhase::Load);
+        keys_ = UTIL::rankCatalog(records);
+        // Grouped by series, each series' coverage bits are one short run; the list is sorted after
+        std::stable_sort(records.begin(), records.end(), [](const UTIL::AmiiboRecord &a, const UTIL::AmiiboRecord &b)
+                         { return a.seriesRank < b.seriesRank; });
+        const std::vector<uint64_t> fresh = updateHistory(UTIL::makeSnapshot(records));
+
+        newOnly_ = false;
+        hiddenAmiibos_.clear();
+        freshCount_ = 0;
+        amiibos_.clear();
+        amiibos_.reserve(records.size());
+
+        // What is on the card is listed once here; generate and delete keep it current
+        const std::vector<uint64_t> installed = UTIL::scanInstalledIds(*scheduler_, UTIL::AMIIBO_FIGURES_PATH);
+        std::vector<uint32_t> seriesOf(records.size());
+        seriesLabels_.assign(keys_.series.size(), {});
+        for (size_t i = 0; i < records.size(); ++i)
+        {
+            seriesOf[i] = records[i].seriesRank;
+            if (seriesLabels_[seriesOf[i]].empty())
+                seriesLabels_[seriesOf[i]] = UTIL::foldText(records[i].amiiboSeries.empty() ? "Unknown" : records[i].amiiboSeries, UTIL::TextForm::Display);
+        }
+        coverage_ = UTIL::CollectionCoverage(std::move(seriesOf), keys_.series.size());
+        coverageCursor_ = 0;
+
+        for (size_t i = 0; i < records.size(); ++i)
+        {
+            auto &record = records[i];
+            const auto id = UTIL::packAmiiboId(record);
+            const bool isFresh = id && std::binary_search(fresh.begin(), fresh.end(), *id);
+            freshCount_ += isFresh ? 1 : 0;
+            if (id && std::binary_search(installed.begin(), installed.end(), *id))
+                coverage_.setInstalled(i, true);
+            amiibos_.push_back({std::move(record), false, isFresh, static_cast<uint32_t>(i)});
+        }
     }
 
     void adjustScrollOffset() noexcept
@@ -61,12 +166,84 @@ class AmiiboMenu
         else if (cursorIndex_ >= scrollOffset_ + VISIBLE_ITEMS)
             scrollOffset_ = cursorIndex_ - VISIBLE_ITEMS + 1;
 
-        const int maxOffset = std::max(0, static_cast<int>(amiibodata_["amiibo"].size()) - VISIBLE_ITEMS);
+        const int maxOffset = std::max(0, total() - VISIBLE_ITEMS);
         scrollOffset_ = std::clamp(scrollOffset_, 0, maxOffset);
+        scroller_.jumpTo(scrollOffset_);
+    }
+
+    // No card access here: the image path is resolved by the loader's worker
+    [[nodiscard]] static UTIL::PreviewSource previewSource(const UTIL::AmiiboRecord &record)
+    {
+        auto amiibo = std::make_shared<const Amiibo>(record);
+        std::string key = amiibo->id();
+        return {std::move(key), record.image, [amiibo = std::move(amiibo)]
+                { return amiibo->imagePath(); }};
+    }
+
+    // Cursor row first, then its neighbours so scrolling finds them already decoded
+    void requestPreviews()
+    {
+        if (!preview_ || !isValidIndex(cursorIndex_))
+            return;
+
+        std::vector<UTIL::PreviewSource> sources;
+        sources.reserve(1 + 2 * UTIL::PREVIEW_PREFETCH_ROWS);
+        sources.push_back(previewSource(amiibos_[cursorIndex_].record));
+        for (int d = 1; d <= UTIL::PREVIEW_PREFETCH_ROWS; ++d)
+        {
+            for (const int idx : {cursorIndex_ + d, cursorIndex_ - d})
+                if (isValidIndex(idx))
+                    sources.push_back(previewSource(amiibos_[idx].record));
+        }
+        preview_->want(std::move(sources));
+    }
+
+    // Show the cursor figure in the panel, rescaling only when the image changes
+    void refreshPreview()
+    {
+        previewLabel_ = {};
+        if (!preview_ || !isValidIndex(cursorIndex_))
+            return;
+
+        std::shared_ptr<const UTIL::PreviewImage> image;
+        const auto state = preview_->get(amiibos_[cursorIndex_].record.id(), image);
+        if (state == UTIL::PreviewLoader::State::Pending)
+            previewLabel_ = "Loading...";
+        else if (state == UTIL::PreviewLoader::State::Missing)
+            previewLabel_ = "No image";
+
+        auto *terminal = UI::activeTerminal();
+        if (!terminal || image == shownPreview_)
+            return;
+        shownPreview_ = image;
+        if (!image)
+        {
+            terminal->hideImage();
+            return;
+        }
+
+        const float scale = std::min(static_cast<float>(PREVIEW_WIDTH) / image->width,
+                                     static_cast<float>(PREVIEW_HEIGHT) / image->height);
+        const int width = std::clamp(static_cast<int>(image->width * scale), 1, PREVIEW_WIDTH);
+        const int height = std::clamp(static_cast<int>(image->height * scale), 1, PREVIEW_HEIGHT);
+        const int offset = ((PREVIEW_HEIGHT - height) / 2 * PREVIEW_WIDTH + (PREVIEW_WIDTH - width) / 2) * 4;
+
+        std::vector<uint8_t> panel(static_cast<size_t>(PREVIEW_WIDTH) * PREVIEW_HEIGHT * 4, 0);
+        stbir_resize_uint8_linear(image->rgba.data(), image->width, image->height, 0,
+                                  panel.data() + offset, width, height, PREVIEW_WIDTH * 4, STBIR_RGBA);
+        terminal->setImage(PREVIEW_X, PREVIEW_Y, PREVIEW_WIDTH, PREVIEW_HEIGHT, panel.data());
     }
 
 public:
-    explicit AmiiboMenu(const json &data) : amiibodata_(data) { sortAmiibo(); }
+    explicit AmiiboMenu(std::vector<UTIL::AmiiboRecord> records, const UTIL::Config &config = {})
+        : imageOptions_(config.image), durability_(config.output.durability),
+          downloader_(std::make_unique<UTIL::Downloader>(config.download))
+    {
+        setCatalog(std::move(records));
+        if (config.preview.enabled)
+            preview_ = std::make_unique<UTIL::PreviewLoader>(*scheduler_, *downloader_, config.preview.fetchMissing);
+        sortAmiibo();
+    }
 
     AmiiboMenu(const AmiiboMenu &) = delete;
     AmiiboMenu &operator=(const AmiiboMenu &) = delete;
@@ -75,20 +252,227 @@ public:
 
     void toggleAllAmiibo()
     {
-        clearScreen();
-
         int newSelected = 0;
-        for (auto &item : amiibodata_["amiibo"])
+        for (auto &entry : amiibos_)
         {
-            const bool selected = getJsonValue(item, "selected", false);
-            if (!selected)
-                ++newSelected;
-            item["selected"] = !selected;
+            entry.selected = !entry.selected;
+            newSelected += entry.selected ? 1 : 0;
         }
         selectedCount_ = newSelected;
         updateScreen();
     }
 
+    // Shows only what the last database update added or changed, or everything again.
+    // Selections of hidden figures are kept for when they come back.
+    void toggleNewOnly()
+    {
+        if (!newOnly_)
+        {
+            if (freshCount_ == 0)
+                return;
+            const auto split = std::stable_partition(amiibos_.begin(), amiibos_.end(), [](const Entry &entry) { return entry.fresh; });
+            hiddenAmiibos_.assign(std::make_move_iterator(split), std::make_move_iterator(amiibos_.end()));
+            amiibos_.erase(split, amiibos_.end());
+        }
+        else
+        {
+            amiibos_.insert(amiibos_.end(), std::make_move_iterator(hiddenAmiibos_.begin()), std::make_move_iterator(hiddenAmiibos_.end()));
+            hiddenAmiibos_.clear();
+        }
+        newOnly_ = !newOnly_;
+        selectedCount_ = static_cast<int>(std::count_if(amiibos_.begin(), amiibos_.end(), [](const Entry &entry) { return entry.selected; }));
+        cursorIndex_ = scrollOffset_ = 0;
+        sortAmiibo();
+    }
+
+    // Puts the cursor on a catalog record, leaving the new-only view if that hides it
+    void jumpToRecord(size_t catalogIndex)
+    {
+        const auto find = [&]
+        { return std::find_if(amiibos_.begin(), amiibos_.end(), [&](const Entry &entry) { return entry.catalogIndex == catalogIndex; }); };
+        auto it = find();
+        if (it == amiibos_.end() && newOnly_)
+        {
+            toggleNewOnly();
+            it = find();
+        }
+        if (it == amiibos_.end())
+            return;
+        cursorIndex_ = static_cast<int>(it - amiibos_.begin());
+        adjustScrollOffset();
+    }
+
+    // Row 0 toggles the new-only view, the rest are series
+    [[nodiscard]] std::string coverageRowText(int row) const
+    {
+        char line[UI::Terminal::COLS + 1];
+        if (row == 0)
+        {
+            std::snprintf(line, sizeof(line), "  New since last update: %d figures%s", freshCount_,
+                          newOnly_ ? " (listed only these, A: list all)" : freshCount_ > 0 ? " (A: list only these)" : "");
+            return line;
+        }
+
+        const size_t series = static_cast<size_t>(row - 1);
+        const uint32_t have = coverage_.installedIn(series), all = coverage_.totalIn(series);
+        constexpr int BAR = 20;
+        const int filled = all ? static_cast<int>(static_cast<uint64_t>(have) * BAR / all) : 0;
+        const std::string &label = seriesLabels_[series];
+        std::snprintf(line, sizeof(line), "  %-48.*s %4u / %-4u [%.*s%.*s]%s", static_cast<int>(std::min<size_t>(label.size(), 48)),
+                      label.data(), have, all, filled, "####################", BAR - filled, "--------------------",
+                      have == all ? "" : "  missing");
+        return line;
+    }
+
+    void showCoverage()
+    {
+        auto *terminal = UI::activeTerminal();
+        if (!terminal)
+            return;
+        clearScreen();
+
+        const int rows = 1 + static_cast<int>(coverage_.seriesCount());
+        int offset = 0;
+        bool dirty = true;
+        const auto moveTo = [&](int row)
+        {
+            coverageCursor_ = std::clamp(row, 0, rows - 1);
+            offset = std::clamp(offset, coverageCursor_ - VISIBLE_ITEMS + 1, coverageCursor_);
+            dirty = true;
+        };
+        // Next series (in direction step) that still has figures missing
+        const auto nextIncomplete = [&](int step)
+        {
+            for (int row = coverageCursor_ + step; row >= 1 && row < rows; row += step)
+            {
+                if (coverage_.installedIn(row - 1) < coverage_.totalIn(row - 1))
+                {
+                    moveTo(row);
+                    return;
+                }
+            }
+        };
+        moveTo(coverageCursor_);
+
+        while (appletMainLoop())
+        {
+            if (dirty)
+            {
+                char line[UI::Terminal::COLS + 1];
+                terminal->setLine(0, "=== Collection ===", UI::STYLE_HEADER);
+                terminal->setLine(1, {});
+                std::snprintf(line, sizeof(line), "Installed: %zu/%zu figures in %zu series", coverage_.installedCount(),
+                              coverage_.records(), coverage_.seriesCount());
+                terminal->setLine(2, line);
+                terminal->setLine(3, "A : Show in list | Left/Right : Previous/Next incomplete series | B : Back");
+                terminal->setLine(4, {});
+                for (int r = 0; r < VISIBLE_ITEMS; ++r)
+                {
+                    const int row = offset + r;
+                    terminal->setLine(LIST_TOP + r, row < rows ? coverageRowText(row) : std::string(),
+                                      row == coverageCursor_ ? UI::STYLE_CURSOR : UI::STYLE_NORMAL);
+                }
+                dirty = false;
+            }
+            UI::present();
+            svcSleepThread(FRAME_NS);
+
+            padUpdate(&pad_);
+            const u64 kDown = padGetButtonsDown(&pad_);
+            if (!kDown)
+                continue;
+            UI::markInput();
+            if (kDown & HidNpadButton_B)
+                break;
+            if (kDown & HidNpadButton_Up)
+                moveTo(coverageCursor_ - 1);
+            if (kDown & HidNpadButton_Down)
+                moveTo(coverageCursor_ + 1);
+            if (kDown & HidNpadButton_L)
+                moveTo(coverageCursor_ - VISIBLE_ITEMS);
+            if (kDown & HidNpadButton_R)
+                moveTo(coverageCursor_ + VISIBLE_ITEMS);
+            if (kDown & HidNpadButton_Left)
+                nextIncomplete(-1);
+            if (kDown & HidNpadButton_Right)
+                nextIncomplete(+1);
+            if (kDown & HidNpadButton_A)
+            {
+                if (coverageCursor_ == 0)
+                {
+                    if (freshCount_ > 0 || newOnly_)
+                        toggleNewOnly();
+                    break;
+                }
+                // The first missing figure, or the first one of a complete series
+                const size_t series = static_cast<size_t>(coverageCursor_ - 1);
+                size_t record = coverage_.firstMissing(series);
+                if (record == coverage_.records())
+                    record = coverage_.firstMember(series);
+                jumpToRecord(record);
+                break;
+            }
+        }
+        clearScreen();
+        updateScreen();
+    }
+
+    // Per-host download counters, at debug level
+    void logDownloadStats()
+    {
+        for (const auto &host : downloader_->hostStats())
+            UTIL::logger().log(UTIL::LogLevel::Debug, "%s: %llu ok, %llu failed, %llu bytes, peak %zu at once, %zu queued\n",
+                               host.host, static_cast<unsigned long long>(host.completed), static_cast<unsigned long long>(host.failed),
+                               static_cast<unsigned long long>(host.bytes), host.peakActive, host.queued);
+    }
+
+    // Preview cache effectiveness while browsing, e.g. to size PREVIEW_CACHE_CAPACITY
+    void logPreviewStats()
+    {
+        if (!preview_)
+            return;
+        const UTIL::PreviewStats stats = preview_->stats();
+        UTIL::logger().log(UTIL::LogLevel::Debug, "previews: %.1f%% hit rate (%llu hits, %llu misses), %llu decoded, %llu fetched, %llu evicted\n",
+                           stats.hitRate() * 100.0, static_cast<unsigned long long>(stats.hits), static_cast<unsigned long long>(stats.misses),
+                           static_cast<unsigned long long>(stats.decoded), static_cast<unsigned long long>(stats.fetched),
+                           static_cast<unsigned long long>(stats.evicted));
+    }
+
+    // Everything traced since the last dump, when tracing is on
+    void dumpTrace()
+    {
+        if (!UTIL::tracer().enabled())
+            return;
+        size_t events = 0;
+        uint64_t dropped = 0;
+        const std::string path(UTIL::TRACE_PATH);
+        if (!UTIL::tracer().dumpChromeTrace(path, &events, &dropped))
+            UTIL::printError("Warning: Could not write %s\n", path);
+        else
+            std::printf("Trace: %zu events written to %s (%llu dropped)\n", events, path.c_str(), static_cast<unsigned long long>(dropped));
+    }
+
+    // Heap use per phase since startup, in builds with ALLOC_PROFILE=1; also logged at debug level
+    void showAllocStats()
+    {
+        if constexpr (!UTIL::ALLOC_PROFILING)
+            return;
+        const auto show = [](std::string_view name, const UTIL::AllocStats &stats)
+        {
+            char line[128];
+            std::snprintf(line, sizeof(line), "Heap %-8.*s %9llu allocs %9llu KiB, peak %7lld KiB, live %7lld KiB\n",
+                          static_cast<int>(name.size()), name.data(), static_cast<unsigned long long>(stats.allocations),
+                          static_cast<unsigned long long>(stats.bytes / 1024), static_cast<long long>(stats.peak / 1024),
+                          static_cast<long long>(stats.live / 1024));
+            std::fputs(line, stdout);
+            UTIL::logger().log(UTIL::LogLevel::Debug, "%s", std::string_view(line));
+        };
+        for (int i = 0; i < UTIL::ALLOC_PHASE_COUNT; ++i)
+            if (const auto stats = UTIL::allocStats(static_cast<UTIL::AllocPhase>(i)); stats.allocations > 0)
+                show(UTIL::ALLOC_PHASE_NAMES[i], stats);
+        show("total", UTIL::allocTotals());
+    }
+
     void updateAmiiboDatabase()
     {
         clearScreen();
@@ -98,7 +482,31 @@ public:
         const std::string dbPath(UTIL::AMIIBO_DB_PATH);
         std::filesystem::remove(dbPath, ec);
 
-        if (!UTIL::checkAmiiboDatabase())
+        // Queued in the database class, so preview fetches for the same host take turns
+        // with it instead of going first
+        UTIL::ProgressChannel progress;
+        std::atomic<int> result{DOWNLOAD_PENDING};
+        {
+            const UTIL::ProgressScope scope(progress, 0);
+            downloader_->fetch(std::string(UTIL::AMIIBO_API_URL), dbPath, [&result](int code)
+                               { result.store(code, std::memory_order_release); },
+                               UTIL::DownloadClass::Database);
+        }
+        const auto showEvent = [](const UTIL::ProgressEvent &event)
+        {
+            if (const std::string line = UTIL::describe(event); !line.empty())
+                std::fputs(line.c_str(), UTIL::isError(event.code) ? stderr : stdout);
+        };
+        while (result.load(std::memory_order_acquire) == DOWNLOAD_PENDING)
+        {
+            progress.drain(showEvent);
+            UI::present();
+            svcSleepThread(FRAME_NS);
+        }
+        progress.drain(showEvent);
+        logDownloadStats();
+
+        if (result.load(std::memory_order_acquire) != 0)
         {
             UTIL::printMessage("Download failed!\n");
             shouldExit_ = true;
@@ -107,47 +515,95 @@ public:
 
         UTIL::printMessage("Database updated!\n");
 
-        if (std::ifstream file(dbPath); file)
-            file >> amiibodata_;
-        else
+        const UTIL::AllocPhaseScope phase(UTIL::AllocPhase::Load);
+        std::string text;
+        if (!UTIL::readTextFile(dbPath, text))
         {
             UTIL::printError("Failed to open database file.\n");
             return;
         }
+        std::vector<UTIL::AmiiboRecord> records;
+        if (!UTIL::loadCatalog(text, records))
+        {
+            UTIL::printError("Invalid database format - missing 'amiibo' key\n");
+            return;
+        }
+        setCatalog(std::move(records));
+        UTIL::printMessage("%d new or changed figures, see B : Collection\n", freshCount_);
 
         cursorIndex_ = scrollOffset_ = selectedCount_ = sortIndex_ = 0;
+        if (preview_)
+            preview_->clear();
 
         for (int i = 5; i > 0; --i)
         {
             std::printf("Back in %d seconds...\n", i);
-            consoleUpdate(nullptr);
+            UI::present();
             svcSleepThread(1000000000ULL);
         }
         updateScreen();
     }
 
+    // Cycles OFF -> ON (RGBA) -> ON (8-bit palette) -> OFF
     void toggleImageGeneration()
     {
-        withImage_ = !withImage_;
+        if (!withImage_)
+            withImage_ = true;
+        else if (!imageOptions_.paletted)
+            imageOptions_.paletted = true;
+        else
+            withImage_ = imageOptions_.paletted = false;
+        updateScreen();
+    }
+
+    void nextResizeQuality()
+    {
+        const int next = (static_cast<int>(imageOptions_.quality) + 1) % UTIL::RESIZE_QUALITY_COUNT;
+        imageOptions_.quality = static_cast<UTIL::ResizeQuality>(next);
         updateScreen();
     }
-    void clearScreen() { consoleClear(); }
+
+    // Leave the menu for a full-screen text view
+    void clearScreen()
+    {
+        if (auto *terminal = UI::activeTerminal())
+            terminal->hideImage();
+        shownPreview_.reset();
+        UI::clear();
+    }
+
+    // Every row is rewritten each time; the terminal only redraws rows that changed
     void updateScreen()
     {
-        clearScreen();
+        const UTIL::AllocPhaseScope phase(UTIL::AllocPhase::Render);
+        requestPreviews();
+        refreshPreview();
         showMainScreen();
-        consoleUpdate(nullptr);
+        UI::present();
     }
 
     void showMainScreen()
     {
-        std::puts("=== AmiiboGenerator ===                               - : Update DB  |  + : Exit\n");
-        std::printf("Selected: %d/%zu   Images: %s   Sort: %.*s %s\n\n",
-                    selectedCount_, amiibodata_["amiibo"].size(),
-                    withImage_ ? "ON " : "OFF",
-                    static_cast<int>(SORT_FIELDS[sortIndex_].size()), SORT_FIELDS[sortIndex_].data(),
-                    SORT_DIRECTIONS[sortIndex_] == 'A' ? "ASC" : "DESC");
-        std::puts("ZL : Select All | ZR : Toggle Images | Y : Sort | X : Generate | LSTICK : Delete\n");
+        auto *terminal = UI::activeTerminal();
+        if (!terminal)
+            return;
+
+        char line[UI::Terminal::COLS + 1];
+        std::snprintf(line, sizeof(line), "%-*s%s", UI::Terminal::COLS - 30, "=== AmiiboGenerator ===",
+                      "- : Update DB  |  + : Exit");
+        terminal->setLine(0, line, UI::STYLE_HEADER);
+        terminal->setLine(1, {});
+
+        const auto quality = UTIL::RESIZE_QUALITY_NAMES[static_cast<int>(imageOptions_.quality)];
+        std::snprintf(line, sizeof(line), "Selected: %d/%zu   Images: %s   Quality: %-6.*s   Sort: %.*s %s   New: %d%s",
+                      selectedCount_, amiibos_.size(),
+                      !withImage_ ? "OFF" : imageOptions_.paletted ? "PAL" : "ON ",
+                      static_cast<int>(quality.size()), quality.data(),
+                      static_cast<int>(SORT_FIELDS[sortIndex_].size()), SORT_FIELDS[sortIndex_].data(),
+                      SORT_DIRECTIONS[sortIndex_] == 'A' ? "ASC" : "DESC", freshCount_, newOnly_ ? " (shown only)" : "");
+        terminal->setLine(2, line);
+        terminal->setLine(3, "ZL : Select All | ZR : Toggle Images | RSTICK : Image Quality | Y : Sort | RSTICK <> : Letter | B : Collection | X : Generate | LSTICK : Delete");
+        terminal->setLine(4, {});
         showVisibleItems();
     }
 
@@ -159,25 +615,43 @@ public:
 
     void showVisibleItems()
     {
-        const int total = static_cast<int>(amiibodata_["amiibo"].size());
-        const int end = std::min(scrollOffset_ + VISIBLE_ITEMS, total);
-        for (int i = scrollOffset_; i < end; ++i)
-            showItem(i, amiibodata_["amiibo"][i]);
+        const int labelRow = (PREVIEW_HEIGHT / UI::FONT::GLYPH_HEIGHT) / 2;
+        for (int row = 0; row < VISIBLE_ITEMS; ++row)
+        {
+            const int idx = scrollOffset_ + row;
+            std::string text = idx < total() ? itemText(idx, amiibos_[idx]) : std::string();
+            if (preview_ && row == labelRow && !previewLabel_.empty())
+            {
+                text.resize(PREVIEW_COL + (PREVIEW_WIDTH / UI::FONT::GLYPH_WIDTH - static_cast<int>(previewLabel_.size())) / 2, ' ');
+                text += previewLabel_;
+            }
+            showItem(LIST_TOP + row, text, idx == cursorIndex_);
+        }
     }
 
-    void showItem(int idx, const json &data)
+    // "[x]*12) Series - Name" (* = new since the last update), cut short of the preview panel
+    [[nodiscard]] std::string itemText(int idx, const Entry &entry) const
     {
-        const char sel = getJsonValue(data, "selected", false) ? 'x' : ' ';
-        const char cur = (idx == cursorIndex_) ? '>' : ' ';
-        const auto series = getJsonValue(data, "amiiboSeries", std::string("Unknown"));
-        const auto name = getJsonValue(data, "name", std::string("Unknown"));
-        std::printf("%c [%c] %d) %s - %s\n", cur, sel, idx + 1, series.c_str(), name.c_str());
+        const std::string &label = entry.record.label;
+        char line[256];
+        std::snprintf(line, sizeof(line), " [%c]%c%d) %.*s", entry.selected ? 'x' : ' ', entry.fresh ? '*' : ' ', idx + 1,
+                      static_cast<int>(label.size()), label.data());
+        std::string text(line);
+        if (preview_ && static_cast<int>(text.size()) > PREVIEW_COL - 2)
+            text.resize(PREVIEW_COL - 2);
+        return text;
+    }
+
+    void showItem(int row, std::string_view text, bool highlighted)
+    {
+        if (auto *terminal = UI::activeTerminal())
+            terminal->setLine(row, text, highlighted ? UI::STYLE_CURSOR : UI::STYLE_NORMAL,
+                              preview_ ? PREVIEW_COL - 2 : UI::Terminal::COLS);
     }
 
     void moveCursor(int delta)
     {
-        const int total = static_cast<int>(amiibodata_["amiibo"].size());
-        const int newIdx = std::clamp(cursorIndex_ + delta, 0, total - 1);
+        const int newIdx = std::clamp(cursorIndex_ + delta, 0, total() - 1);
         if (newIdx != cursorIndex_)
         {
             cursorIndex_ = newIdx;
@@ -186,17 +660,68 @@ public:
         }
     }
 
+    // Rank range of the entries whose sort key starts with the same letter as entry's
+    [[nodiscard]] std::pair<uint32_t, uint32_t> letterGroup(const Entry &entry) const
+    {
+        const auto member = SORT_MEMBERS[sortIndex_];
+        const UTIL::FrontCodedStrings &keys = member == &UTIL::AmiiboRecord::seriesRank ? keys_.series : keys_.names;
+        const uint32_t rank = entry.record.*member;
+        const std::string key = keys.at(rank);
+        uint32_t cp = 0;
+        const size_t letter = key.empty() ? 0 : UTIL::detail::decodeUtf8(reinterpret_cast<const uint8_t *>(key.data()), key.size(), cp);
+        if (letter == 0)
+            return {rank, rank + 1};
+        const auto [first, last] = keys.prefixRange(std::string_view(key).substr(0, letter));
+        return {static_cast<uint32_t>(first), static_cast<uint32_t>(last)};
+    }
+
     void jumpCursor(int delta) { moveCursor(delta * 10); }
 
+    // Right stick left/right: start of the previous / next group of figures whose sort key
+    // (series or name) starts with the same letter. The list is sorted by rank, so a group
+    // is one run.
+    void jumpLetter(int delta)
+    {
+        if (!isValidIndex(cursorIndex_))
+            return;
+        const auto member = SORT_MEMBERS[sortIndex_];
+        const auto inGroup = [&](int index, const std::pair<uint32_t, uint32_t> &group)
+        {
+            const uint32_t rank = amiibos_[index].record.*member;
+            return rank >= group.first && rank < group.second;
+        };
+        const auto groupStart = [&](int index)
+        {
+            const auto group = letterGroup(amiibos_[index]);
+            while (index > 0 && inGroup(index - 1, group))
+                --index;
+            return index;
+        };
+
+        int target = cursorIndex_;
+        if (delta > 0)
+        {
+            const auto group = letterGroup(amiibos_[target]);
+            while (target + 1 < total() && inGroup(target, group))
+                ++target;
+        }
+        else
+        {
+            target = groupStart(target);
+            if (target == cursorIndex_ && target > 0)
+                target = groupStart(target - 1);
+        }
+        moveCursor(target - cursorIndex_);
+    }
+
     void toggleCurrentItem()
     {
         if (!isValidIndex(cursorIndex_))
             return;
 
-        auto &item = amiibodata_["amiibo"][cursorIndex_];
-        const bool wasSelected = getJsonValue(item, "selected", false);
-        item["selected"] = !wasSelected;
-        selectedCount_ += wasSelected ? -1 : 1;
+        auto &entry = amiibos_[cursorIndex_];
+        entry.selected = !entry.selected;
+        selectedCount_ += entry.selected ? 1 : -1;
         updateScreen();
     }
 
@@ -204,6 +729,8 @@ public:
     {
         padUpdate(&pad_);
         const u64 kDown = padGetButtonsDown(&pad_);
+        if (kDown)
+            UI::markInput();
 
         if (kDown & HidNpadButton_Plus)
             shouldExit_ = true;
@@ -217,6 +744,10 @@ public:
             jumpCursor(-1);
         if (kDown & HidNpadButton_Right)
             jumpCursor(+1);
+        if (kDown & HidNpadButton_StickRLeft)
+            jumpLetter(-1);
+        if (kDown & HidNpadButton_StickRRight)
+            jumpLetter(+1);
         if (kDown & HidNpadButton_L)
             moveCursor(-VISIBLE_ITEMS);
         if (kDown & HidNpadButton_R)
@@ -231,16 +762,21 @@ public:
             generateAmiibo();
         if (kDown & HidNpadButton_Y)
             nextSortOption();
+        if (kDown & HidNpadButton_B)
+            showCoverage();
         if (kDown & HidNpadButton_StickL)
             deleteSelectedAmiibo();
+        if (kDown & HidNpadButton_StickR)
+            nextResizeQuality();
 
         const u64 kHeld = padGetButtons(&pad_);
 
         if (kHeld & HidNpadButton_Up)
         {
             holdUpTicks_++;
-            if (holdUpTicks_ >= 5)
+            if (holdUpTicks_ >= HOLD_DELAY_FRAMES && holdUpTicks_ % HOLD_REPEAT_FRAMES == 0)
             {
+                UI::markInput();
                 moveCursor(-1);
             }
         }
@@ -252,8 +788,9 @@ public:
         if (kHeld & HidNpadButton_Down)
         {
             holdDownTicks_++;
-            if (holdDownTicks_ >= 5)
+            if (holdDownTicks_ >= HOLD_DELAY_FRAMES && holdDownTicks_ % HOLD_REPEAT_FRAMES == 0)
             {
+                UI::markInput();
                 moveCursor(+1);
             }
         }
@@ -263,6 +800,62 @@ public:
         }
     }
 
+    // Drag or fling the list; a tap moves the cursor to the touched row
+    void touchHandler()
+    {
+        constexpr float dt = static_cast<float>(FRAME_NS) / 1e9f;
+        const int count = total();
+        scroller_.setRange(count, VISIBLE_ITEMS);
+        const bool wasMoving = scroller_.moving();
+
+        HidTouchScreenState state{};
+        const bool touching = hidGetTouchScreenStates(&state, 1) > 0 && state.count > 0;
+        const auto x = static_cast<int>(state.touches[0].x), y = static_cast<int>(state.touches[0].y);
+
+        if (touching && !touchHeld_)
+        {
+            touchHeld_ = true;
+            // The list runs the full width when there is no preview panel
+            if ((!preview_ || x < PREVIEW_X) && y >= PREVIEW_Y)
+            {
+                scroller_.press(static_cast<float>(y));
+                touchRow_ = scrollOffset_ + y / UI::FONT::GLYPH_HEIGHT - LIST_TOP;
+                UI::markInput();
+            }
+        }
+        else if (touching && scroller_.dragging())
+        {
+            scroller_.drag(static_cast<float>(y), dt);
+            UI::markInput();
+        }
+        else if (!touching && touchHeld_)
+        {
+            touchHeld_ = false;
+            if (scroller_.release() && isValidIndex(touchRow_))
+            {
+                UI::markInput();
+                moveCursor(touchRow_ - cursorIndex_);
+            }
+        }
+        scroller_.step(dt);
+
+        // Scrolling done elsewhere (D-pad, sorting, DB update) wins once the list is at rest
+        const int first = scroller_.firstRow();
+        if (!wasMoving && !scroller_.moving())
+        {
+            if (first != scrollOffset_)
+                scroller_.jumpTo(scrollOffset_);
+            return;
+        }
+        if (first == scrollOffset_ || count == 0)
+            return;
+
+        // Only the visible window is rebuilt, so a fling costs the same for any list length
+        scrollOffset_ = first;
+        cursorIndex_ = std::clamp(cursorIndex_, scrollOffset_, std::min(count, scrollOffset_ + VISIBLE_ITEMS) - 1);
+        updateScreen();
+    }
+
     void generateAmiibo()
     {
         clearScreen();
@@ -274,24 +867,146 @@ public:
             return;
         }
 
-        int count = 0;
-        for (const auto &item : amiibodata_["amiibo"])
+        // Workers get their own copies and never touch amiibos_
+        std::vector<Amiibo> jobs;
+        std::vector<std::string> labels;
+        std::vector<uint32_t> catalogIndices;
+        for (const auto &entry : amiibos_)
         {
-            if (!getJsonValue(item, "selected", false))
+            if (!entry.selected)
                 continue;
-            ++count;
-            const auto series = getJsonValue(item, "amiiboSeries", std::string("Unknown"));
-            const auto name = getJsonValue(item, "name", std::string("Unknown"));
-            std::printf("%d/%d - Generating: %s - %s\n", count, selectedCount_, series.c_str(), name.c_str());
-            consoleUpdate(nullptr);
+            jobs.emplace_back(entry.record);
+            labels.push_back(entry.record.label);
+            catalogIndices.push_back(entry.catalogIndex);
+        }
 
-            Amiibo amiibo(item);
-            if (!amiibo.generate(withImage_))
-                std::puts("Failed to generate amiibo.");
+        // Each figure runs as a short pipeline: a batch task writes its files and queues the
+        // image download, the download loop calls back when the file is on disk, and a second
+        // batch task resizes it. No thread ever blocks on the network, so every figure can
+        // be in flight at once. Syncs run on batch tasks too, never on the download loop or
+        // the UI thread.
+        UTIL::ProgressChannel progress;
+        UTIL::OutputBatch output(durability_);
+        UTIL::Downloader &downloader = *downloader_;
+        std::atomic<size_t> finished{0};
+        const bool withImage = withImage_;
+        const UTIL::ImageOptions options = imageOptions_;
+
+        // Outcomes are kept per figure, not taken from the progress ring, which drops
+        // events when the UI falls behind; only the console lines depend on it
+        std::vector<std::atomic<uint8_t>> results(jobs.size());
+        const auto finish = [&](uint32_t item, FigureResult result)
+        {
+            const bool written = result == FigureResult::Generated || result == FigureResult::NoImage; // image errors were reported per stage
+            UTIL::report(UTIL::ProgressStage::Item, written ? UTIL::ProgressCode::Done : UTIL::ProgressCode::Failed);
+            results[item].store(static_cast<uint8_t>(result), std::memory_order_relaxed);
+            finished.fetch_add(1, std::memory_order_release);
+        };
+        const auto resize = [&](uint32_t item, std::string path, bool downloaded)
+        {
+            scheduler_->submit(UTIL::TaskPriority::Batch, [&, item, downloaded, path = std::move(path)]
+                               {
+                                   const UTIL::ProgressScope scope(progress, item);
+                                   const bool imaged = downloaded && UTIL::loadAndResizeImageInRatio(path + "amiibo.png", options);
+                                   output.figureDone(path); // the figure itself was written either way
+                                   finish(item, imaged ? FigureResult::Generated : FigureResult::NoImage); });
+        };
+        for (size_t i = 0; i < jobs.size(); ++i)
+        {
+            scheduler_->submit(UTIL::TaskPriority::Batch, [&, i]
+                               {
+                                   const auto item = static_cast<uint32_t>(i);
+                                   const UTIL::ProgressScope scope(progress, item);
+                                   UTIL::report(UTIL::ProgressStage::Item, UTIL::ProgressCode::Started);
+                                   bool exists = false;
+                                   const std::string path = jobs[i].writeFigure(&exists);
+                                   const std::string url = jobs[i].imageUrl();
+                                   if (path.empty())
+                                   {
+                                       finish(item, exists ? FigureResult::Exists : FigureResult::Failed);
+                                       return;
+                                   }
+                                   if (!withImage || url.empty())
+                                   {
+                                       output.figureDone(path);
+                                       finish(item, FigureResult::Generated);
+                                       return;
+                                   }
+                                   downloader.fetch(url, path + "amiibo.png", [&, item, path](int result)
+                                                    { resize(item, path, result == 0); },
+                                                    UTIL::DownloadClass::Image); });
         }
 
-        std::puts("Done!\nPress B to go back.");
-        consoleUpdate(nullptr);
+        // Drained once per frame, so workers never wait on the console. Figures run in
+        // parallel, so their result lines are tagged with the figure number.
+        int generated = 0, noImage = 0, failed = 0, syncFailures = 0;
+        const auto syncItem = static_cast<uint32_t>(jobs.size()); // reports of the closing sync
+        const auto showEvent = [&](const UTIL::ProgressEvent &event)
+        {
+            if (event.item == syncItem)
+            {
+                syncFailures += UTIL::isError(event.code) ? 1 : 0;
+                if (const std::string line = UTIL::describe(event); !line.empty())
+                    std::fputs(line.c_str(), UTIL::isError(event.code) ? stderr : stdout);
+                return;
+            }
+            if (event.stage == UTIL::ProgressStage::Item && event.code == UTIL::ProgressCode::Started)
+            {
+                std::printf("%u/%zu - Generating: %s\n", event.item + 1, jobs.size(), labels[event.item].c_str());
+                return;
+            }
+            if (const std::string line = UTIL::describe(event); !line.empty())
+                std::fprintf(UTIL::isError(event.code) ? stderr : stdout, "  #%u: %s", event.item + 1, line.c_str());
+        };
+        while (finished.load(std::memory_order_acquire) < jobs.size())
+        {
+            progress.drain(showEvent);
+            UI::present();
+            svcSleepThread(FRAME_NS);
+        }
+        progress.drain(showEvent);
+        for (size_t i = 0; i < jobs.size(); ++i)
+        {
+            const auto result = static_cast<FigureResult>(results[i].load(std::memory_order_relaxed));
+            if (result == FigureResult::Generated || result == FigureResult::NoImage || result == FigureResult::Exists)
+                coverage_.setInstalled(catalogIndices[i], true);
+            generated += result == FigureResult::Generated ? 1 : 0;
+            noImage += result == FigureResult::NoImage ? 1 : 0;
+            failed += result == FigureResult::Exists || result == FigureResult::Failed ? 1 : 0; // existing figures included, as before
+        }
+
+        // The closing sync can take seconds on a slow card; the screen keeps presenting meanwhile
+        if (output.policy() == UTIL::Durability::Batch && generated + noImage > 0)
+            std::printf("Syncing %d figures...\n", generated + noImage);
+        std::atomic<bool> synced{false};
+        scheduler_->submit(UTIL::TaskPriority::Batch, [&]
+                           {
+                               const UTIL::ProgressScope scope(progress, syncItem);
+                               output.finish();
+                               UTIL::report(UTIL::ProgressStage::Sync, UTIL::ProgressCode::Done);
+                               synced.store(true, std::memory_order_release); });
+        while (!synced.load(std::memory_order_acquire))
+        {
+            progress.drain(showEvent);
+            UI::present();
+            svcSleepThread(FRAME_NS);
+        }
+        progress.drain(showEvent);
+        if (const auto dropped = progress.dropped())
+            std::printf("(%llu progress messages dropped)\n", static_cast<unsigned long long>(dropped));
+
+        if (preview_)
+            preview_->clear();
+
+        logDownloadStats();
+        logPreviewStats();
+        std::printf("Done! %d generated, %d without image, %d failed, %llu syncs (%s)%s.\n", generated, noImage, failed,
+                    static_cast<unsigned long long>(output.syncs()), UTIL::DURABILITY_NAMES[static_cast<int>(output.policy())].data(),
+                    syncFailures > 0 ? ", some did not reach the card" : "");
+        dumpTrace();
+        showAllocStats();
+        std::printf("Press B to go back.\n");
+        UI::present();
         waitForButton(HidNpadButton_B);
         updateScreen();
     }
@@ -320,7 +1035,7 @@ public:
 
         // Check if amiibo folder exists and is not empty
         std::error_code ec;
-        constexpr std::string_view basePath = "sdmc:/emuiibo/amiibo/";
+        constexpr std::string_view basePath = UTIL::AMIIBO_FIGURES_PATH;
         if (!std::filesystem::exists(std::string(basePath), ec) ||
             std::filesystem::is_empty(std::string(basePath), ec))
         {
@@ -331,23 +1046,24 @@ public:
         }
 
         UTIL::printMessage("Deleting %d amiibos. Please wait...\n\n", selectedCount_);
-        consoleUpdate(nullptr);
+        UI::present();
 
         int deleted = 0, skipped = 0, processed = 0;
 
-        for (auto &item : amiibodata_["amiibo"])
+        for (auto &entry : amiibos_)
         {
-            if (!getJsonValue(item, "selected", false))
+            if (!entry.selected)
                 continue;
             ++processed;
 
-            const auto name = getJsonValue(item, "name", std::string("Unknown"));
-            std::printf("[%d/%d] %s... ", processed, selectedCount_, name.c_str());
-            consoleUpdate(nullptr);
+            const std::string name = UTIL::foldText(entry.record.name.empty() ? "Unknown" : entry.record.name, UTIL::TextForm::Display);
+            std::printf("[%d/%d] %.*s... ", processed, selectedCount_, static_cast<int>(name.size()), name.data());
+            UI::present();
 
-            Amiibo amiibo(item);
+            Amiibo amiibo(entry.record);
             if (amiibo.erase())
             {
+                coverage_.setInstalled(entry.catalogIndex, false);
                 std::puts("OK");
                 ++deleted;
             }
@@ -356,42 +1072,46 @@ public:
                 std::puts("SKIP");
                 ++skipped;
             }
-            item["selected"] = false;
-            consoleUpdate(nullptr);
+            entry.selected = false;
+            UI::present();
         }
 
         selectedCount_ = 0;
+        if (preview_)
+            preview_->clear();
 
-        // Clean up empty directories
-        if (std::filesystem::exists(std::string(basePath), ec))
+        // Clean up empty series directories; the walk lists them in parallel
+        const auto listing = UTIL::walkTree(*scheduler_, basePath, [](std::string_view, const UTIL::WalkEntry &, int depth)
+                                            { return depth <= 1; });
+        for (const auto &directory : listing)
         {
-            for (const auto &entry : std::filesystem::directory_iterator(std::string(basePath), ec))
-            {
-                if (entry.is_directory(ec) && std::filesystem::is_empty(entry.path(), ec))
-                    std::filesystem::remove(entry.path(), ec);
-            }
+            if (directory.depth == 1 && directory.entries.empty())
+                std::filesystem::remove(UTIL::detail::joinWalkPath(basePath, directory.path), ec);
         }
 
         std::printf("\nCompleted: %d deleted, %d skipped, %d failed.\n",
                     deleted, skipped, processed - deleted - skipped);
         std::puts("Press B to continue.");
-        consoleUpdate(nullptr);
+        UI::present();
         waitForButton(HidNpadButton_B);
         updateScreen();
     }
 
     void sortAmiibo()
     {
-        const std::string sortKey(SORT_FIELDS[sortIndex_]);
+        const auto member = SORT_MEMBERS[sortIndex_];
         const bool ascending = (SORT_DIRECTIONS[sortIndex_] == 'A');
 
-        std::sort(amiibodata_["amiibo"].begin(), amiibodata_["amiibo"].end(),
-                  [&sortKey, ascending](const json &a, const json &b)
-                  {
-                      const auto aVal = a.contains(sortKey) ? a[sortKey] : json();
-                      const auto bVal = b.contains(sortKey) ? b[sortKey] : json();
-                      return ascending ? (aVal < bVal) : (aVal > bVal);
-                  });
+        {
+            const UTIL::AllocPhaseScope phase(UTIL::AllocPhase::Sort);
+            std::sort(amiibos_.begin(), amiibos_.end(),
+                      [member, ascending](const Entry &a, const Entry &b)
+                      {
+                          const uint32_t aVal = a.record.*member;
+                          const uint32_t bVal = b.record.*member;
+                          return ascending ? (aVal < bVal) : (aVal > bVal);
+                      });
+        }
         updateScreen();
     }
 
@@ -399,13 +1119,19 @@ public:
     {
         padConfigureInput(1, HidNpadStyleSet_NpadStandard);
         padInitializeDefault(&pad_);
+        hidInitializeTouchScreen();
         updateScreen();
 
         while (appletMainLoop() && !shouldExit_)
         {
             inputHandler();
-            svcSleepThread(50000000ULL);
+            touchHandler();
+            if (preview_ && preview_->takeUpdated())
+                updateScreen();
+            UI::present();
+            svcSleepThread(FRAME_NS);
         }
+        logPreviewStats();
         return 0;
     }
 
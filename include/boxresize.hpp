@@ -0,0 +1,158 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define AMIIBO_BOXRESIZE_NEON 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define AMIIBO_BOXRESIZE_SSE2 1
+#endif
+
+namespace UTIL
+{
+    namespace detail
+    {
+        // acc[ch][x] += row pixels; RGBA color channels are weighted by alpha
+        inline void accumulateRow(const uint8_t *row, int width, int channels, std::vector<uint32_t> *acc) noexcept
+        {
+            int x = 0;
+            if (channels == 4)
+            {
+                uint32_t *r = acc[0].data(), *g = acc[1].data(), *b = acc[2].data(), *a = acc[3].data();
+#if defined(AMIIBO_BOXRESIZE_NEON)
+                for (; x + 16 <= width; x += 16)
+                {
+                    const uint8x16x4_t px = vld4q_u8(row + x * 4);
+                    uint32_t *dst[3] = {r + x, g + x, b + x};
+                    for (int ch = 0; ch < 3; ++ch)
+                    {
+                        const uint16x8_t lo = vmull_u8(vget_low_u8(px.val[ch]), vget_low_u8(px.val[3]));
+                        const uint16x8_t hi = vmull_high_u8(px.val[ch], px.val[3]);
+                        vst1q_u32(dst[ch] + 0, vaddw_u16(vld1q_u32(dst[ch] + 0), vget_low_u16(lo)));
+                        vst1q_u32(dst[ch] + 4, vaddw_high_u16(vld1q_u32(dst[ch] + 4), lo));
+                        vst1q_u32(dst[ch] + 8, vaddw_u16(vld1q_u32(dst[ch] + 8), vget_low_u16(hi)));
+                        vst1q_u32(dst[ch] + 12, vaddw_high_u16(vld1q_u32(dst[ch] + 12), hi));
+                    }
+                    const uint16x8_t lo = vmovl_u8(vget_low_u8(px.val[3]));
+                    const uint16x8_t hi = vmovl_high_u8(px.val[3]);
+                    vst1q_u32(a + x + 0, vaddw_u16(vld1q_u32(a + x + 0), vget_low_u16(lo)));
+                    vst1q_u32(a + x + 4, vaddw_high_u16(vld1q_u32(a + x + 4), lo));
+                    vst1q_u32(a + x + 8, vaddw_u16(vld1q_u32(a + x + 8), vget_low_u16(hi)));
+                    vst1q_u32(a + x + 12, vaddw_high_u16(vld1q_u32(a + x + 12), hi));
+                }
+#elif defined(AMIIBO_BOXRESIZE_SSE2)
+                const __m128i zero = _mm_setzero_si128();
+                // Multiplies r, g, b by alpha and alpha by 1
+                const __m128i alphaLane = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+                const __m128i one = _mm_set_epi16(1, 0, 0, 0, 1, 0, 0, 0);
+                const auto weigh = [&](__m128i px16)
+                {
+                    const __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(px16, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+                    return _mm_mullo_epi16(px16, _mm_or_si128(_mm_andnot_si128(alphaLane, alpha), one));
+                };
+                for (; x + 4 <= width; x += 4)
+                {
+                    const __m128i px = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + x * 4));
+                    const __m128i lo = weigh(_mm_unpacklo_epi8(px, zero)), hi = weigh(_mm_unpackhi_epi8(px, zero));
+                    // Four RGBA pixels of 32-bit sums, transposed into r, g, b and a lanes
+                    const __m128i p0 = _mm_unpacklo_epi16(lo, zero), p1 = _mm_unpackhi_epi16(lo, zero);
+                    const __m128i p2 = _mm_unpacklo_epi16(hi, zero), p3 = _mm_unpackhi_epi16(hi, zero);
+                    const __m128i rg01 = _mm_unpacklo_epi32(p0, p1), rg23 = _mm_unpacklo_epi32(p2, p3);
+                    const __m128i ba01 = _mm_unpackhi_epi32(p0, p1), ba23 = _mm_unpackhi_epi32(p2, p3);
+                    const __m128i sums[4] = {_mm_unpacklo_epi64(rg01, rg23), _mm_unpackhi_epi64(rg01, rg23),
+                                             _mm_unpacklo_epi64(ba01, ba23), _mm_unpackhi_epi64(ba01, ba23)};
+                    uint32_t *dst[4] = {r + x, g + x, b + x, a + x};
+                    for (int ch = 0; ch < 4; ++ch)
+                    {
+                        auto *at = reinterpret_cast<__m128i *>(dst[ch]);
+                        _mm_storeu_si128(at, _mm_add_epi32(_mm_loadu_si128(at), sums[ch]));
+                    }
+                }
+#endif
+                for (; x < width; ++x)
+                {
+                    const uint8_t *p = row + x * 4;
+                    r[x] += static_cast<uint32_t>(p[0]) * p[3];
+                    g[x] += static_cast<uint32_t>(p[1]) * p[3];
+                    b[x] += static_cast<uint32_t>(p[2]) * p[3];
+                    a[x] += p[3];
+                }
+                return;
+            }
+
+            for (; x < width; ++x)
+                for (int ch = 0; ch < channels; ++ch)
+                    acc[ch][static_cast<size_t>(x)] += row[x * channels + ch];
+        }
+    } // namespace detail
+
+    // Integer area-average resize. Every output pixel is the mean of the source pixels it
+    // covers, which is exact for downscaling and degrades to point sampling when upscaling.
+    [[nodiscard]] inline bool resizeBoxUint8(const uint8_t *src, int srcWidth, int srcHeight, int srcStride,
+                                             uint8_t *dst, int dstWidth, int dstHeight, int channels)
+    {
+        if (!src || !dst || srcWidth <= 0 || srcHeight <= 0 || dstWidth <= 0 || dstHeight <= 0 ||
+            channels < 1 || channels > 4)
+            return false;
+        if (srcStride == 0)
+            srcStride = srcWidth * channels;
+
+        const auto span = [](int out, int srcSize, int dstSize, int &begin, int &end)
+        {
+            begin = static_cast<int>(static_cast<int64_t>(out) * srcSize / dstSize);
+            end = static_cast<int>(static_cast<int64_t>(out + 1) * srcSize / dstSize);
+            end = std::min(std::max(end, begin + 1), srcSize);
+        };
+
+        std::vector<int> xBegin(static_cast<size_t>(dstWidth)), xEnd(static_cast<size_t>(dstWidth));
+        for (int ox = 0; ox < dstWidth; ++ox)
+            span(ox, srcWidth, dstWidth, xBegin[static_cast<size_t>(ox)], xEnd[static_cast<size_t>(ox)]);
+
+        std::vector<uint32_t> acc[4];
+        for (int ch = 0; ch < channels; ++ch)
+            acc[ch].resize(static_cast<size_t>(srcWidth));
+
+        const bool weighted = channels == 4;
+        for (int oy = 0; oy < dstHeight; ++oy)
+        {
+            int y0, y1;
+            span(oy, srcHeight, dstHeight, y0, y1);
+
+            for (int ch = 0; ch < channels; ++ch)
+                std::fill(acc[ch].begin(), acc[ch].end(), 0u);
+            for (int y = y0; y < y1; ++y)
+                detail::accumulateRow(src + static_cast<size_t>(y) * static_cast<size_t>(srcStride), srcWidth, channels, acc);
+
+            uint8_t *out = dst + static_cast<size_t>(oy) * static_cast<size_t>(dstWidth) * static_cast<size_t>(channels);
+            for (int ox = 0; ox < dstWidth; ++ox)
+            {
+                const int x0 = xBegin[static_cast<size_t>(ox)], x1 = xEnd[static_cast<size_t>(ox)];
+                const uint32_t count = static_cast<uint32_t>((x1 - x0) * (y1 - y0));
+
+                uint64_t sum[4] = {0, 0, 0, 0};
+                for (int ch = 0; ch < channels; ++ch)
+                    for (int x = x0; x < x1; ++x)
+                        sum[ch] += acc[ch][static_cast<size_t>(x)];
+
+                uint8_t *px = out + ox * channels;
+                if (weighted)
+                {
+                    const uint64_t alpha = sum[3];
+                    for (int ch = 0; ch < 3; ++ch)
+                        px[ch] = alpha ? static_cast<uint8_t>((sum[ch] + alpha / 2) / alpha) : 0;
+                    px[3] = static_cast<uint8_t>((alpha + count / 2) / count);
+                }
+                else
+                {
+                    for (int ch = 0; ch < channels; ++ch)
+                        px[ch] = static_cast<uint8_t>((sum[ch] + count / 2) / count);
+                }
+            }
+        }
+        return true;
+    }
+} // namespace UTIL
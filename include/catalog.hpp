@@ -0,0 +1,133 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "libs/json.hpp"
+#include "frontcode.hpp"
+#include "jsonindex.hpp"
+#include "record.hpp"
+#include "textnorm.hpp"
+
+namespace UTIL
+{
+    // One AmiiboAPI entry. Fields missing from the database, or not strings there, are empty.
+    struct AmiiboRecord
+    {
+        std::string amiiboSeries;
+        std::string character;
+        std::string gameSeries;
+        std::string head;
+        std::string image;
+        std::string name;
+        std::string tail;
+        std::string type;
+        std::string releaseAu, releaseEu, releaseJp, releaseNa;
+
+        // Filled in by normalizeRecord(), not read from the database; the directory forms of
+        // series and name are folded when a path is built, which is rare next to listing
+        std::string label;                     // "Series - Name" as the terminal can show it
+        uint32_t seriesRank = 0, nameRank = 0; // order of the folded series/name, see rankCatalog()
+
+        // head + tail, empty if either is missing
+        [[nodiscard]] std::string id() const { return head.empty() || tail.empty() ? std::string() : head + tail; }
+    };
+
+    inline constexpr RecordField<AmiiboRecord> AMIIBO_FIELDS[] = {
+        {"amiiboSeries", &AmiiboRecord::amiiboSeries},
+        {"character", &AmiiboRecord::character},
+        {"gameSeries", &AmiiboRecord::gameSeries},
+        {"head", &AmiiboRecord::head},
+        {"image", &AmiiboRecord::image},
+        {"name", &AmiiboRecord::name},
+        {"tail", &AmiiboRecord::tail},
+        {"type", &AmiiboRecord::type},
+        {"release"},
+        {"release.au", &AmiiboRecord::releaseAu},
+        {"release.eu", &AmiiboRecord::releaseEu},
+        {"release.jp", &AmiiboRecord::releaseJp},
+        {"release.na", &AmiiboRecord::releaseNa},
+    };
+
+    inline constexpr auto AMIIBO_FIELD_TABLE = makeFieldTable(AMIIBO_FIELDS);
+    static_assert(AMIIBO_FIELD_TABLE.valid(), "no perfect hash seed for the AmiiboAPI keys");
+
+    // Derives the display and path forms from the bound fields
+    inline void normalizeRecord(AmiiboRecord &record)
+    {
+        std::string series, name;
+        foldText(record.amiiboSeries.empty() ? "Unknown" : record.amiiboSeries, TextForm::Display, series);
+        foldText(record.name.empty() ? "Unknown" : record.name, TextForm::Display, name);
+        record.label = series + " - " + name;
+    }
+
+    // Distinct folded series and names, sorted and front-coded; records refer to them by rank,
+    // and the menu's letter jumps look ranges up in them without decoding the rest
+    struct CatalogKeys
+    {
+        FrontCodedStrings series;
+        FrontCodedStrings names;
+    };
+
+    namespace detail
+    {
+        // Sorted distinct values of keys, and each key's position among them
+        [[nodiscard]] inline FrontCodedStrings rankKeys(const std::vector<std::string> &keys, std::vector<uint32_t> &ranks)
+        {
+            std::vector<std::string_view> sorted(keys.begin(), keys.end());
+            std::sort(sorted.begin(), sorted.end());
+            sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+            ranks.resize(keys.size());
+            for (size_t i = 0; i < keys.size(); ++i)
+                ranks[i] = static_cast<uint32_t>(std::lower_bound(sorted.begin(), sorted.end(), keys[i]) - sorted.begin());
+            return FrontCodedStrings(sorted);
+        }
+    } // namespace detail
+
+    // Folds every series and name for sorting and matching ("Pokémon" with "pokemon"), sets
+    // the records' ranks and returns the keys. Sorting by rank is sorting by key.
+    [[nodiscard]] inline CatalogKeys rankCatalog(std::vector<AmiiboRecord> &records)
+    {
+        std::vector<std::string> series(records.size()), names(records.size());
+        for (size_t i = 0; i < records.size(); ++i)
+        {
+            foldText(records[i].amiiboSeries, TextForm::Search, series[i]);
+            foldText(records[i].name, TextForm::Search, names[i]);
+        }
+
+        CatalogKeys keys;
+        std::vector<uint32_t> ranks;
+        keys.series = detail::rankKeys(series, ranks);
+        for (size_t i = 0; i < records.size(); ++i)
+            records[i].seriesRank = ranks[i];
+        keys.names = detail::rankKeys(names, ranks);
+        for (size_t i = 0; i < records.size(); ++i)
+            records[i].nameRank = ranks[i];
+        return keys;
+    }
+
+    // Database text to records. False if the text is malformed or has no "amiibo" array.
+    [[nodiscard]] inline bool loadCatalog(std::string_view text, std::vector<AmiiboRecord> &records)
+    {
+#if defined(AMIIBO_JSON_NLOHMANN)
+        records.clear();
+        const nlohmann::json root = parseJson(text);
+        const auto it = root.is_object() ? root.find("amiibo") : root.end();
+        if (it == root.end() || !it->is_array())
+            return false;
+        records.reserve(it->size());
+        for (const auto &item : *it)
+            if (item.is_object())
+                bindRecord(item, AMIIBO_FIELD_TABLE, records.emplace_back());
+#else
+        if (!bindRecordArray(text, "amiibo", AMIIBO_FIELD_TABLE, records))
+            return false;
+#endif
+        for (auto &record : records)
+            normalizeRecord(record);
+        return true;
+    }
+} // namespace UTIL
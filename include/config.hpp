@@ -0,0 +1,201 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+#include "downloader.hpp"
+#include "durable.hpp"
+#include "util.hpp"
+#include "libs/json.hpp"
+
+namespace UTIL
+{
+    inline constexpr std::string_view CONFIG_DIR = "sdmc:/config/AmiiboGenerator/";
+    inline constexpr std::string_view CONFIG_PATH = "sdmc:/config/AmiiboGenerator/config.json";
+    inline constexpr std::string_view LOG_PATH = "sdmc:/config/AmiiboGenerator/log.txt";
+    inline constexpr std::string_view LOG_LEVEL_NAMES[] = {"debug", "info", "warning", "error", "off"};
+
+    struct PreviewOptions
+    {
+        bool enabled = true;      // show the cursor figure next to the list
+        bool fetchMissing = true; // download images of figures that were not generated yet
+    };
+
+    struct LogOptions
+    {
+        LogLevel level = LogLevel::Info; // messages below this are dropped before formatting
+        bool file = false;               // also append to LOG_PATH
+    };
+
+    struct OutputOptions
+    {
+        Durability durability = Durability::Batch; // when generated figures are synced to the card
+    };
+
+    struct TraceOptions
+    {
+        bool enabled = false; // record a Chrome trace of each batch to TRACE_PATH
+    };
+
+    // User settings, every field falls back to its default when missing or malformed
+    struct Config
+    {
+        ImageOptions image{};
+        PreviewOptions preview{};
+        LogOptions log{};
+        OutputOptions output{};
+        DownloadLimits download{};
+        TlsOptions tls{};
+        TraceOptions trace{};
+    };
+
+    namespace detail
+    {
+        template <typename T>
+        [[nodiscard]] T configValue(const nlohmann::json &obj, std::string_view key, const T &defVal)
+        {
+            const std::string keyStr(key);
+            if (obj.is_object() && obj.contains(keyStr))
+            {
+                try
+                {
+                    return obj[keyStr].get<T>();
+                }
+                catch (...)
+                {
+                }
+            }
+            return defVal;
+        }
+
+        [[nodiscard]] inline ResizeQuality parseResizeQuality(std::string_view name, ResizeQuality defVal) noexcept
+        {
+            for (int i = 0; i < RESIZE_QUALITY_COUNT; ++i)
+                if (RESIZE_QUALITY_NAMES[i] == name)
+                    return static_cast<ResizeQuality>(i);
+            return defVal;
+        }
+
+        [[nodiscard]] inline LogLevel parseLogLevel(std::string_view name, LogLevel defVal) noexcept
+        {
+            for (size_t i = 0; i < std::size(LOG_LEVEL_NAMES); ++i)
+                if (LOG_LEVEL_NAMES[i] == name)
+                    return static_cast<LogLevel>(i);
+            return defVal;
+        }
+
+        [[nodiscard]] inline Durability parseDurability(std::string_view name, Durability defVal) noexcept
+        {
+            for (size_t i = 0; i < std::size(DURABILITY_NAMES); ++i)
+                if (DURABILITY_NAMES[i] == name)
+                    return static_cast<Durability>(i);
+            return defVal;
+        }
+    } // namespace detail
+
+    [[nodiscard]] inline nlohmann::json configToJson(const Config &config)
+    {
+        const auto &img = config.image;
+        return {
+            {"image",
+             {{"resizeQuality", std::string(RESIZE_QUALITY_NAMES[static_cast<int>(img.quality)])},
+              {"paletted", img.paletted},
+              {"cropTransparent", img.cropTransparent},
+              {"cropPadding", img.cropPadding},
+              {"sizes", img.heights}}},
+            {"preview",
+             {{"enabled", config.preview.enabled},
+              {"fetchMissing", config.preview.fetchMissing}}},
+            {"log",
+             {{"level", std::string(LOG_LEVEL_NAMES[static_cast<int>(config.log.level)])},
+              {"file", config.log.file}}},
+            {"output",
+             {{"durability", std::string(DURABILITY_NAMES[static_cast<int>(config.output.durability)])}}},
+            {"download",
+             {{"maxActive", config.download.maxActive},
+              {"perHost", config.download.perHost}}},
+            {"tls",
+             {{"verify", config.tls.verify},
+              {"caBundle", config.tls.caBundle}}},
+            {"trace",
+             {{"enabled", config.trace.enabled}}}};
+    }
+
+    [[nodiscard]] inline Config configFromJson(const nlohmann::json &root)
+    {
+        Config config;
+        const auto image = detail::configValue(root, "image", nlohmann::json::object());
+        auto &img = config.image;
+        img.quality = detail::parseResizeQuality(
+            detail::configValue(image, "resizeQuality", std::string(RESIZE_QUALITY_NAMES[static_cast<int>(img.quality)])),
+            img.quality);
+        img.paletted = detail::configValue(image, "paletted", img.paletted);
+        img.cropTransparent = detail::configValue(image, "cropTransparent", img.cropTransparent);
+        img.cropPadding = detail::configValue(image, "cropPadding", img.cropPadding);
+        img.heights = detail::configValue(image, "sizes", img.heights);
+        img.heights.erase(std::remove_if(img.heights.begin(), img.heights.end(), [](int h)
+                                         { return h <= 0 || h > MAX_IMAGE_HEIGHT; }),
+                          img.heights.end());
+        if (img.heights.empty())
+            img.heights.push_back(TARGET_IMAGE_HEIGHT);
+
+        const auto preview = detail::configValue(root, "preview", nlohmann::json::object());
+        config.preview.enabled = detail::configValue(preview, "enabled", config.preview.enabled);
+        config.preview.fetchMissing = detail::configValue(preview, "fetchMissing", config.preview.fetchMissing);
+
+        const auto log = detail::configValue(root, "log", nlohmann::json::object());
+        config.log.level = detail::parseLogLevel(
+            detail::configValue(log, "level", std::string(LOG_LEVEL_NAMES[static_cast<int>(config.log.level)])),
+            config.log.level);
+        config.log.file = detail::configValue(log, "file", config.log.file);
+
+        const auto output = detail::configValue(root, "output", nlohmann::json::object());
+        config.output.durability = detail::parseDurability(
+            detail::configValue(output, "durability", std::string(DURABILITY_NAMES[static_cast<int>(config.output.durability)])),
+            config.output.durability);
+
+        const auto download = detail::configValue(root, "download", nlohmann::json::object());
+        // Read signed so a negative value means the minimum instead of wrapping to the maximum
+        config.download.maxActive = static_cast<size_t>(std::clamp<int64_t>(
+            detail::configValue<int64_t>(download, "maxActive", static_cast<int64_t>(config.download.maxActive)), 1, 64));
+        config.download.perHost = static_cast<size_t>(std::clamp<int64_t>(
+            detail::configValue<int64_t>(download, "perHost", static_cast<int64_t>(config.download.perHost)), 1, 64));
+
+        const auto tls = detail::configValue(root, "tls", nlohmann::json::object());
+        config.tls.verify = detail::configValue(tls, "verify", config.tls.verify);
+        config.tls.caBundle = detail::configValue(tls, "caBundle", config.tls.caBundle);
+
+        const auto trace = detail::configValue(root, "trace", nlohmann::json::object());
+        config.trace.enabled = detail::configValue(trace, "enabled", config.trace.enabled);
+        return config;
+    }
+
+    // Load the config file, writing one with the defaults if none exists yet
+    [[nodiscard]] inline Config loadConfig()
+    {
+        const std::string path(CONFIG_PATH);
+        std::error_code ec;
+        if (std::filesystem::exists(path, ec))
+        {
+            if (std::ifstream file(path); file)
+            {
+                const auto root = nlohmann::json::parse(file, nullptr, false);
+                if (!root.is_discarded())
+                    return configFromJson(root);
+            }
+            printError("Warning: Invalid config file, using defaults\n");
+            return {};
+        }
+
+        const Config defaults;
+        std::filesystem::create_directories(std::string(CONFIG_DIR), ec);
+        if (std::ofstream file(path); file)
+            file << configToJson(defaults).dump(2);
+        return defaults;
+    }
+} // namespace UTIL
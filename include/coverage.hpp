@@ -0,0 +1,194 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "history.hpp"
+#include "scheduler.hpp"
+#include "treewalk.hpp"
+
+namespace UTIL
+{
+    // Fixed-size bit set, one bit per catalog record
+    class Bitmap
+    {
+        std::vector<uint64_t> words_;
+        size_t size_ = 0;
+
+    public:
+        Bitmap() = default;
+        explicit Bitmap(size_t size) : words_((size + 63) / 64, 0), size_(size) {}
+
+        [[nodiscard]] size_t size() const noexcept { return size_; }
+        [[nodiscard]] size_t wordCount() const noexcept { return words_.size(); }
+        [[nodiscard]] uint64_t word(size_t w) const noexcept { return w < words_.size() ? words_[w] : 0; }
+        [[nodiscard]] bool test(size_t i) const noexcept { return words_[i / 64] >> (i % 64) & 1; }
+
+        // False if the bit already had that value
+        bool assign(size_t i, bool value) noexcept
+        {
+            const uint64_t bit = uint64_t{1} << (i % 64);
+            uint64_t &word = words_[i / 64];
+            if (((word & bit) != 0) == value)
+                return false;
+            word ^= bit;
+            return true;
+        }
+
+        [[nodiscard]] size_t count() const noexcept
+        {
+            size_t n = 0;
+            for (const uint64_t word : words_)
+                n += static_cast<size_t>(__builtin_popcountll(word));
+            return n;
+        }
+
+        // Bits set both here and in other's words from offset on, without building the intersection
+        [[nodiscard]] size_t countAnd(const Bitmap &other, size_t offset = 0) const noexcept
+        {
+            size_t n = 0;
+            for (size_t w = 0; w < words_.size(); ++w)
+                n += static_cast<size_t>(__builtin_popcountll(words_[w] & other.word(offset + w)));
+            return n;
+        }
+
+        // First index set here and clear in other's words from offset on, size() if there is none
+        [[nodiscard]] size_t firstAndNot(const Bitmap &other, size_t offset = 0) const noexcept
+        {
+            for (size_t w = 0; w < words_.size(); ++w)
+            {
+                const uint64_t word = words_[w] & ~other.word(offset + w);
+                if (word)
+                    return w * 64 + static_cast<size_t>(__builtin_ctzll(word));
+            }
+            return size_;
+        }
+    };
+
+    // Installed / total figures per series. The series bitmaps are fixed by the catalog;
+    // only the installed bitmap changes, and every change adjusts one counter, so reading
+    // the counts never touches the SD card.
+    class CollectionCoverage
+    {
+        // A series' records as a bitmap over only the catalog words they fall in, starting
+        // at word `offset`. With the catalog ordered by series the spans barely overlap,
+        // so all of them together take about one bit per record.
+        struct Members
+        {
+            Bitmap bits;
+            size_t offset = 0;
+        };
+
+        std::vector<Members> members_;   // per series
+        std::vector<uint32_t> seriesOf_; // per record
+        std::vector<uint32_t> installedIn_, totalIn_;
+        Bitmap installed_;
+
+    public:
+        CollectionCoverage() = default;
+
+        // seriesOf[i] is the series of record i, below seriesCount
+        CollectionCoverage(std::vector<uint32_t> seriesOf, size_t seriesCount)
+            : members_(seriesCount), seriesOf_(std::move(seriesOf)), installedIn_(seriesCount, 0),
+              totalIn_(seriesCount, 0), installed_(seriesOf_.size())
+        {
+            std::vector<size_t> first(seriesCount, SIZE_MAX), last(seriesCount, 0); // records
+            for (size_t i = 0; i < seriesOf_.size(); ++i)
+            {
+                const uint32_t series = seriesOf_[i];
+                ++totalIn_[series];
+                first[series] = std::min(first[series], i);
+                last[series] = i + 1;
+            }
+            for (size_t s = 0; s < seriesCount; ++s)
+            {
+                if (totalIn_[s] == 0)
+                    continue;
+                members_[s].offset = first[s] / 64;
+                members_[s].bits = Bitmap(last[s] - members_[s].offset * 64);
+            }
+            for (size_t i = 0; i < seriesOf_.size(); ++i)
+            {
+                Members &members = members_[seriesOf_[i]];
+                members.bits.assign(i - members.offset * 64, true);
+            }
+        }
+
+        [[nodiscard]] size_t records() const noexcept { return seriesOf_.size(); }
+        [[nodiscard]] size_t seriesCount() const noexcept { return members_.size(); }
+        [[nodiscard]] uint32_t installedIn(size_t series) const noexcept { return installedIn_[series]; }
+        [[nodiscard]] uint32_t totalIn(size_t series) const noexcept { return totalIn_[series]; }
+        [[nodiscard]] size_t installedCount() const noexcept { return installed_.count(); }
+        [[nodiscard]] bool installed(size_t record) const noexcept { return installed_.test(record); }
+
+        // Words held by the series bitmaps, installed excluded
+        [[nodiscard]] size_t memberWords() const noexcept
+        {
+            size_t words = 0;
+            for (const Members &members : members_)
+                words += members.bits.wordCount();
+            return words;
+        }
+
+        void setInstalled(size_t record, bool value) noexcept
+        {
+            if (record >= seriesOf_.size() || !installed_.assign(record, value))
+                return;
+            uint32_t &count = installedIn_[seriesOf_[record]];
+            count = value ? count + 1 : count - 1;
+        }
+
+        // Counts from scratch: one AND + popcount pass over each series' span
+        void recount() noexcept
+        {
+            for (size_t s = 0; s < members_.size(); ++s)
+                installedIn_[s] = static_cast<uint32_t>(members_[s].bits.countAnd(installed_, members_[s].offset));
+        }
+
+        // First record of the series that is not installed, records() if it is complete
+        [[nodiscard]] size_t firstMissing(size_t series) const noexcept
+        {
+            const Members &members = members_[series];
+            const size_t bit = members.bits.firstAndNot(installed_, members.offset);
+            return bit == members.bits.size() ? records() : members.offset * 64 + bit;
+        }
+
+        // First record of the series, records() if it has none
+        [[nodiscard]] size_t firstMember(size_t series) const noexcept
+        {
+            const Members &members = members_[series];
+            const size_t bit = members.bits.firstAndNot(Bitmap());
+            return bit == members.bits.size() ? records() : members.offset * 64 + bit;
+        }
+    };
+
+    // Packed ids of the figures under basePath ("<series>/<name>_<id>/"), ascending. One
+    // directory listing per series, spread over the scheduler, instead of a lookup per
+    // catalog entry; figure directories themselves are not opened.
+    [[nodiscard]] inline std::vector<uint64_t> scanInstalledIds(Scheduler &scheduler, std::string_view basePath)
+    {
+        std::vector<uint64_t> ids;
+        const auto listing = walkTree(scheduler, basePath, [](std::string_view, const WalkEntry &, int depth)
+                                      { return depth <= 1; });
+        for (const auto &directory : listing)
+        {
+            if (directory.depth != 1)
+                continue;
+            for (const auto &figure : directory.entries)
+            {
+                const std::string_view name = figure.name;
+                if (figure.type != WalkType::Directory || name.size() < 17 || name[name.size() - 17] != '_')
+                    continue;
+                if (const auto id = packAmiiboId(name.substr(name.size() - 16, 8), name.substr(name.size() - 8)))
+                    ids.push_back(*id);
+            }
+        }
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+        return ids;
+    }
+} // namespace UTIL
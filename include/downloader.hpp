@@ -0,0 +1,440 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <curl/curl.h>
+
+#include "util.hpp"
+#include "progress.hpp"
+#include "trace.hpp"
+
+namespace UTIL
+{
+    inline constexpr size_t DOWNLOAD_MAX_ACTIVE = 16;   // open files and easy handles at once
+    inline constexpr size_t DOWNLOAD_HOST_LIMIT = 4;    // transfers per host at once
+    inline constexpr long DOWNLOAD_MAX_CONNECTIONS = 8; // sockets curl may keep open
+    inline constexpr int DOWNLOAD_POLL_MS = 1000;
+    inline constexpr int DOWNLOAD_CANCELLED = CURLE_ABORTED_BY_CALLBACK; // result of transfers cut short by ~Downloader
+
+    // What a transfer is for. Each host serves its classes in turn, so a long image batch
+    // cannot hold back a database refresh or the cursor's preview.
+    enum class DownloadClass : uint8_t
+    {
+        Database,
+        Image,
+        Preview,
+    };
+
+    inline constexpr int DOWNLOAD_CLASS_COUNT = 3;
+
+    struct DownloadLimits
+    {
+        size_t maxActive = DOWNLOAD_MAX_ACTIVE;
+        size_t perHost = DOWNLOAD_HOST_LIMIT;
+    };
+
+    // Counters for one host ("name:port")
+    struct DownloadHostStats
+    {
+        std::string host;
+        size_t queued = 0, active = 0, peakActive = 0;
+        uint64_t started = 0, completed = 0, failed = 0, bytes = 0;
+        std::array<uint64_t, DOWNLOAD_CLASS_COUNT> startedByClass{};
+    };
+
+    namespace detail
+    {
+        // Lower-cased host and port of a URL, the key transfers are pooled by
+        [[nodiscard]] inline std::string urlHost(std::string_view url)
+        {
+            std::string_view rest = url, port;
+            if (const size_t scheme = rest.find("://"); scheme != std::string_view::npos)
+            {
+                port = rest.substr(0, scheme) == "https" ? ":443" : ":80";
+                rest.remove_prefix(scheme + 3);
+            }
+            rest = rest.substr(0, rest.find_first_of("/?#"));
+            if (const size_t at = rest.rfind('@'); at != std::string_view::npos)
+                rest.remove_prefix(at + 1);
+
+            std::string host;
+            for (const char c : rest)
+                host += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            // An IPv6 literal keeps its colons inside the brackets
+            const size_t colon = host.find(':', host.empty() || host[0] != '[' ? 0 : host.find(']'));
+            if (colon == std::string::npos)
+                host += port;
+            return host;
+        }
+    } // namespace detail
+
+    // Non-blocking downloads. One I/O thread drives every transfer through a curl multi
+    // handle and writes the data to disk or memory as it arrives; callers queue a transfer
+    // with a completion callback and move on. Any number of transfers can be queued; at
+    // most limits.maxActive run at a time and at most limits.perHost against one host.
+    // Free slots go to hosts in turn, and within a host to its classes in turn.
+    class Downloader
+    {
+    public:
+        // Receives downloadFile()'s result code, on the I/O thread; keep it short and hand
+        // heavier follow-up work to the scheduler
+        using Callback = std::function<void(int result)>;
+        // 0 and the body on success, non-zero and nothing otherwise; nothing is reported
+        using MemoryCallback = std::function<void(int result, std::vector<unsigned char> data)>;
+
+    private:
+        struct Host;
+
+        struct Transfer
+        {
+            std::string url, path; // no path: the body is kept in memory
+            Callback done;
+            MemoryCallback memoryDone;
+            ProgressContext progress;
+            std::ofstream file;
+            std::vector<unsigned char> body;
+            CurlHandle curl;
+            Host *host = nullptr;
+            uint64_t queuedTrace = 0, activeTrace = 0; // async trace spans, 0 when not traced
+        };
+
+        struct Host
+        {
+            DownloadHostStats stats;
+            size_t limit = DOWNLOAD_HOST_LIMIT;
+            int nextClass = 0;
+            std::array<std::deque<std::unique_ptr<Transfer>>, DOWNLOAD_CLASS_COUNT> queues;
+        };
+
+        CURLM *multi_;
+        DownloadLimits limits_;
+        std::mutex mutex_; // hosts and their queues and counters
+        std::unordered_map<std::string, std::unique_ptr<Host>> hostIndex_;
+        std::vector<Host *> hosts_; // in the order first seen, for round-robin
+        size_t nextHost_ = 0;
+        std::unordered_map<CURL *, std::unique_ptr<Transfer>> active_; // I/O thread only
+        std::atomic<bool> stop_{false};
+        bool closed_ = false; // under mutex_; set once the I/O thread cancelled the queues
+        std::thread thread_;
+
+        // Next transfer by host, then class, round-robin; caller holds the lock
+        [[nodiscard]] std::unique_ptr<Transfer> takeNext()
+        {
+            for (size_t h = 0; h < hosts_.size(); ++h)
+            {
+                Host &host = *hosts_[(nextHost_ + h) % hosts_.size()];
+                if (host.stats.active >= host.limit || host.stats.queued == 0)
+                    continue;
+                for (int c = 0; c < DOWNLOAD_CLASS_COUNT; ++c)
+                {
+                    const int klass = (host.nextClass + c) % DOWNLOAD_CLASS_COUNT;
+                    auto &queue = host.queues[klass];
+                    if (queue.empty())
+                        continue;
+                    std::unique_ptr<Transfer> next = std::move(queue.front());
+                    queue.pop_front();
+                    host.nextClass = (klass + 1) % DOWNLOAD_CLASS_COUNT;
+                    nextHost_ = (nextHost_ + h + 1) % hosts_.size();
+                    --host.stats.queued;
+                    host.stats.peakActive = std::max(host.stats.peakActive, ++host.stats.active);
+                    ++host.stats.started;
+                    ++host.stats.startedByClass[klass];
+                    return next;
+                }
+            }
+            return nullptr;
+        }
+
+        static void notify(Transfer &transfer, int result)
+        {
+            if (transfer.memoryDone)
+                transfer.memoryDone(result, result == 0 ? std::move(transfer.body) : std::vector<unsigned char>());
+            else if (transfer.done)
+                transfer.done(result);
+        }
+
+        void complete(Transfer &transfer, int result, uint64_t bytes)
+        {
+            traceAsyncEnd(transfer.activeTrace, "download", "net");
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                auto &stats = transfer.host->stats;
+                --stats.active;
+                ++(result == 0 ? stats.completed : stats.failed);
+                stats.bytes += result == 0 ? bytes : 0;
+            }
+            notify(transfer, result);
+        }
+
+        // A transfer that never started, on stop
+        static void cancelQueued(Transfer &transfer)
+        {
+            traceAsyncEnd(transfer.queuedTrace, "queued", "net");
+            const ProgressScope scope(transfer.progress);
+            notify(transfer, DOWNLOAD_CANCELLED);
+        }
+
+        void start(std::unique_ptr<Transfer> transfer)
+        {
+            traceAsyncEnd(transfer->queuedTrace, "queued", "net");
+            transfer->activeTrace = traceAsyncBegin("download", "net");
+            const ProgressScope scope(transfer->progress);
+            const bool toFile = !transfer->path.empty();
+            if (!transfer->curl)
+            {
+                if (toFile)
+                    report(ProgressStage::Download, ProgressCode::NetworkError, CURLE_FAILED_INIT);
+                complete(*transfer, -1, 0);
+                return;
+            }
+            if (toFile)
+            {
+                transfer->file.open(transfer->path, std::ios::binary);
+                if (!transfer->file)
+                {
+                    report(ProgressStage::Download, ProgressCode::IoError, errno);
+                    complete(*transfer, -1, 0);
+                    return;
+                }
+            }
+
+            CURL *curl = transfer->curl.get();
+            configureCurl(curl, transfer->url);
+            curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, toFile ? writeCallback : memoryWriteCallback);
+            curl_easy_setopt(curl, CURLOPT_WRITEDATA, toFile ? static_cast<void *>(&transfer->file) : static_cast<void *>(&transfer->body));
+            curl_multi_add_handle(multi_, curl);
+            active_.emplace(curl, std::move(transfer));
+        }
+
+        void finish(CURL *curl, CURLcode res)
+        {
+            const auto it = active_.find(curl);
+            if (it == active_.end())
+                return;
+            curl_multi_remove_handle(multi_, curl);
+            const std::unique_ptr<Transfer> transfer = std::move(it->second);
+            active_.erase(it);
+
+            curl_off_t size = 0;
+            curl_easy_getinfo(curl, CURLINFO_SIZE_DOWNLOAD_T, &size);
+            const ProgressScope scope(transfer->progress);
+            if (!transfer->path.empty())
+            {
+                transfer->file.close();
+                complete(*transfer, finishDownload(curl, res, transfer->path), static_cast<uint64_t>(size));
+                return;
+            }
+
+            // Memory transfers are previews, which fail quietly like downloadToMemory
+            long http_code = 0;
+            curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
+            const int result = res != CURLE_OK ? static_cast<int>(res) : http_code == 200 && !transfer->body.empty() ? 0 : -1;
+            complete(*transfer, result, static_cast<uint64_t>(size));
+        }
+
+        void run()
+        {
+            tracer().nameThread("download I/O");
+            const AllocPhaseScope phase(AllocPhase::Network);
+            while (!stop_.load(std::memory_order_acquire))
+            {
+                while (active_.size() < limits_.maxActive)
+                {
+                    std::unique_ptr<Transfer> next;
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        next = takeNext();
+                    }
+                    if (!next)
+                        break;
+                    start(std::move(next));
+                }
+
+                int running = 0;
+                curl_multi_perform(multi_, &running);
+                int left = 0;
+                bool freed = false;
+                while (CURLMsg *msg = curl_multi_info_read(multi_, &left))
+                {
+                    if (msg->msg != CURLMSG_DONE)
+                        continue;
+                    finish(msg->easy_handle, msg->data.result);
+                    freed = true;
+                }
+
+                // Sleeps until a socket is ready, a fetch() wakes us, or the timeout passes;
+                // not while a freed slot could start a queued transfer
+                curl_multi_poll(multi_, nullptr, 0, freed ? 0 : DOWNLOAD_POLL_MS, nullptr);
+            }
+
+            // Abort whatever is still running, without keeping partial files, and drop the
+            // queues. Every transfer still calls back, with DOWNLOAD_CANCELLED, so owners
+            // counting completions (a generation batch) are not left waiting.
+            for (auto &[curl, transfer] : active_)
+            {
+                curl_multi_remove_handle(multi_, curl);
+                if (!transfer->path.empty())
+                {
+                    transfer->file.close();
+                    std::error_code ec;
+                    std::filesystem::remove(transfer->path, ec);
+                }
+                const ProgressScope scope(transfer->progress);
+                complete(*transfer, DOWNLOAD_CANCELLED, 0);
+            }
+            active_.clear();
+
+            std::vector<std::unique_ptr<Transfer>> queued;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                closed_ = true;
+                for (Host *host : hosts_)
+                {
+                    for (auto &queue : host->queues)
+                    {
+                        host->stats.queued -= queue.size();
+                        host->stats.failed += queue.size();
+                        for (auto &transfer : queue)
+                            queued.push_back(std::move(transfer));
+                        queue.clear();
+                    }
+                }
+            }
+            for (auto &transfer : queued)
+                cancelQueued(*transfer);
+        }
+
+        void enqueue(std::unique_ptr<Transfer> transfer, DownloadClass klass)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                if (closed_)
+                {
+                    // Queued from a callback while stopping; nothing will run it
+                    lock.unlock();
+                    cancelQueued(*transfer);
+                    return;
+                }
+                std::string name = detail::urlHost(transfer->url);
+                auto &host = hostIndex_[name];
+                if (!host)
+                {
+                    host = std::make_unique<Host>();
+                    host->stats.host = std::move(name);
+                    host->limit = std::max<size_t>(limits_.perHost, 1);
+                    hosts_.push_back(host.get());
+                }
+                transfer->host = host.get();
+                transfer->queuedTrace = traceAsyncBegin("queued", "net", static_cast<int64_t>(klass));
+                ++host->stats.queued;
+                host->queues[static_cast<int>(klass)].push_back(std::move(transfer));
+            }
+            curl_multi_wakeup(multi_);
+        }
+
+    public:
+        explicit Downloader(DownloadLimits limits = {}) : multi_(curl_multi_init()), limits_(limits)
+        {
+            if (!multi_)
+                return;
+            limits_.maxActive = std::max<size_t>(limits_.maxActive, 1);
+            curl_multi_setopt(multi_, CURLMOPT_MAX_TOTAL_CONNECTIONS, DOWNLOAD_MAX_CONNECTIONS);
+            thread_ = std::thread([this]
+                                  { run(); });
+        }
+
+        // Transfers that have not completed yet call back with DOWNLOAD_CANCELLED, on the I/O
+        // thread before this returns
+        ~Downloader()
+        {
+            stop_.store(true, std::memory_order_release);
+            if (multi_)
+                curl_multi_wakeup(multi_);
+            if (thread_.joinable())
+                thread_.join();
+            if (multi_)
+                curl_multi_cleanup(multi_);
+        }
+
+        Downloader(const Downloader &) = delete;
+        Downloader &operator=(const Downloader &) = delete;
+
+        // Overrides limits.perHost for one host ("name:port"), e.g. a server that rate-limits
+        void setHostLimit(std::string_view host, size_t limit)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto &entry = hostIndex_[std::string(host)];
+            if (!entry)
+            {
+                entry = std::make_unique<Host>();
+                entry->stats.host = std::string(host);
+                hosts_.push_back(entry.get());
+            }
+            entry->limit = std::max<size_t>(limit, 1);
+        }
+
+        // Any thread. Reports from the transfer go to the caller's current progress scope.
+        void fetch(std::string url, std::string path, Callback done, DownloadClass klass = DownloadClass::Image)
+        {
+            if (url.empty() || path.empty() || !multi_)
+            {
+                // Bad arguments or no multi handle: let the blocking path report it
+                const int result = downloadFile(url, path);
+                if (done)
+                    done(result);
+                return;
+            }
+
+            auto transfer = std::make_unique<Transfer>();
+            transfer->url = std::move(url);
+            transfer->path = std::move(path);
+            transfer->done = std::move(done);
+            transfer->progress = currentProgress();
+            enqueue(std::move(transfer), klass);
+        }
+
+        // Any thread. The body is handed to done instead of a file; nothing is reported.
+        void fetchToMemory(std::string url, MemoryCallback done, DownloadClass klass = DownloadClass::Preview)
+        {
+            if (url.empty() || !multi_)
+            {
+                std::vector<unsigned char> data;
+                const int result = downloadToMemory(url, data) ? 0 : -1;
+                if (done)
+                    done(result, std::move(data));
+                return;
+            }
+
+            auto transfer = std::make_unique<Transfer>();
+            transfer->url = std::move(url);
+            transfer->memoryDone = std::move(done);
+            enqueue(std::move(transfer), klass);
+        }
+
+        // Snapshot of the per-host counters, hosts in the order first used
+        [[nodiscard]] std::vector<DownloadHostStats> hostStats()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            std::vector<DownloadHostStats> stats;
+            stats.reserve(hosts_.size());
+            for (const Host *host : hosts_)
+                stats.push_back(host->stats);
+            return stats;
+        }
+    };
+} // namespace UTIL
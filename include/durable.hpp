@@ -0,0 +1,197 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#ifdef __SWITCH__
+#include <switch.h>
+#endif
+
+#include "progress.hpp"
+#include "trace.hpp"
+#include "treewalk.hpp"
+
+namespace UTIL
+{
+    // When generated figures are forced out to the card
+    enum class Durability : uint8_t
+    {
+        None,   // no syncs while generating, one card-wide flush before the batch reports done
+        Figure, // every figure is synced as soon as it is complete
+        Batch,  // one sync pass over everything the batch wrote, before it reports done
+    };
+
+    inline constexpr std::string_view DURABILITY_NAMES[] = {"none", "figure", "batch"};
+
+    // The whole file in one write call instead of a stream's buffer-sized flushes.
+    // False with errno set on failure.
+    [[nodiscard]] inline bool writeWholeFile(const std::string &path, std::string_view data)
+    {
+        const int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+        if (fd < 0)
+            return false;
+        size_t done = 0;
+        while (done < data.size())
+        {
+            const ssize_t n = write(fd, data.data() + done, data.size() - done);
+            if (n < 0 && errno == EINTR)
+                continue;
+            if (n <= 0)
+            {
+                const int error = n < 0 ? errno : EIO;
+                close(fd);
+                errno = error;
+                return false;
+            }
+            done += static_cast<size_t>(n);
+        }
+        return close(fd) == 0;
+    }
+
+    namespace detail
+    {
+        [[nodiscard]] inline std::string parentPath(std::string_view path)
+        {
+            while (!path.empty() && path.back() == '/')
+                path.remove_suffix(1);
+            const size_t slash = path.rfind('/');
+            return slash == std::string_view::npos ? std::string() : std::string(path.substr(0, slash + 1));
+        }
+    } // namespace detail
+
+    // Applies a Durability policy to the figure directories one generation run writes.
+    // figureDone() and finish() may be called from any thread; they block on the card, so
+    // not from the download loop or the UI. Failed syncs are reported as ProgressStage::Sync.
+    //
+    // Directory entries: the Switch's sdmc devoptab cannot open directories, so there the
+    // card is committed as a whole (fsdevCommitDevice) wherever other systems fsync the
+    // directories that gained entries.
+    class OutputBatch
+    {
+        Durability policy_;
+        std::mutex mutex_;
+        std::vector<std::string> pending_; // figure directories awaiting the batch sync
+        std::atomic<uint64_t> syncs_{0};
+
+        void syncPath(const std::string &path, int flags)
+        {
+            const int fd = open(path.c_str(), flags);
+            const bool ok = fd >= 0 && fsync(fd) == 0;
+            const int error = errno;
+            if (fd >= 0)
+                close(fd);
+            syncs_.fetch_add(ok ? 1 : 0, std::memory_order_relaxed);
+            if (!ok)
+                report(ProgressStage::Sync, ProgressCode::IoError, error);
+        }
+
+        // Every file in the directory
+        void syncFiles(const std::string &directory)
+        {
+            const TraceScope trace("sync", "sd");
+            std::vector<WalkEntry> entries;
+            if (!detail::listDirectory(directory, false, entries))
+            {
+                report(ProgressStage::Sync, ProgressCode::IoError, errno);
+                return;
+            }
+            for (const auto &entry : entries)
+                if (entry.type == WalkType::File)
+                    syncPath(detail::joinWalkPath(directory, entry.name), O_RDWR);
+        }
+
+        // The figure directories, plus the series and base directories that gained them
+        void syncEntries(const std::vector<std::string> &figures)
+        {
+            if (figures.empty())
+                return;
+#ifdef __SWITCH__
+            commitCard();
+#else
+            std::vector<std::string> directories;
+            for (const auto &figure : figures)
+            {
+                std::string series = detail::parentPath(figure);
+                directories.push_back(figure);
+                directories.push_back(detail::parentPath(series));
+                directories.push_back(std::move(series));
+            }
+            std::sort(directories.begin(), directories.end());
+            directories.erase(std::unique(directories.begin(), directories.end()), directories.end());
+            for (const auto &directory : directories)
+                if (!directory.empty())
+                    syncPath(directory, O_RDONLY);
+#endif
+        }
+
+        // Everything written so far, on every file, reaches the card
+        void commitCard()
+        {
+            const TraceScope trace("commit", "sd");
+#ifdef __SWITCH__
+            if (R_FAILED(fsdevCommitDevice("sdmc")))
+            {
+                report(ProgressStage::Sync, ProgressCode::IoError, EIO);
+                return;
+            }
+#else
+            ::sync();
+#endif
+            syncs_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+    public:
+        explicit OutputBatch(Durability policy) : policy_(policy) {}
+        OutputBatch(const OutputBatch &) = delete;
+        OutputBatch &operator=(const OutputBatch &) = delete;
+
+        [[nodiscard]] Durability policy() const noexcept { return policy_; }
+
+        // Once all files of the figure are written and closed
+        void figureDone(const std::string &directory)
+        {
+            if (policy_ == Durability::Figure)
+            {
+                syncFiles(directory);
+                syncEntries({directory});
+            }
+            else
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                pending_.push_back(directory);
+            }
+        }
+
+        // After the last figure: the batch policy syncs everything here, none flushes the
+        // card once so the finished tree is consistent
+        void finish()
+        {
+            std::vector<std::string> figures;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                figures.swap(pending_);
+            }
+            if (policy_ == Durability::None)
+            {
+                if (!figures.empty())
+                    commitCard();
+                return;
+            }
+            for (const auto &figure : figures)
+                syncFiles(figure);
+            syncEntries(figures);
+        }
+
+        // fsync calls and card commits that succeeded
+        [[nodiscard]] uint64_t syncs() const noexcept { return syncs_.load(std::memory_order_relaxed); }
+    };
+} // namespace UTIL
@@ -0,0 +1,1537 @@
+#pragma once
+
+// Generated by tools/fontgen.py from DejaVuSansMono.ttf, do not edit.
+
+#include <cstdint>
+
+namespace UI::FONT
+{
+    inline constexpr int GLYPH_WIDTH = 8;
+    inline constexpr int GLYPH_HEIGHT = 15;
+    inline constexpr int FIRST_CHAR = 32;
+    inline constexpr int CHAR_COUNT = 95;
+
+    // 4-bit coverage, two pixels per byte, high nibble first
+    inline constexpr uint8_t GLYPHS[CHAR_COUNT * GLYPH_WIDTH * GLYPH_HEIGHT / 2] = {
+        // ' '
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // '!'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x04, 0x40, 0x00,
+        0x00, 0x09, 0xA0, 0x00,
+        0x00, 0x09, 0xA0, 0x00,
+        0x00, 0x09, 0xA0, 0x00,
+        0x00, 0x09, 0xA0, 0x00,
+        0x00, 0x09, 0x90, 0x00,
+        0x00, 0x07, 0x80, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x06, 0x60, 0x00,
+        0x00, 0x09, 0x90, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // '"'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x52, 0x25, 0x00,
+        0x00, 0xB5, 0x5B, 0x00,
+        0x00, 0xB5, 0x5B, 0x00,
+        0x00, 0xB5, 0x5B, 0x00,
+        0x00, 0x10, 0x01, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // '#'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x03, 0x20, 0x40,
+        0x00, 0x0C, 0x33, 0xC0,
+        0x00, 0x1E, 0x07, 0x80,
+        0x1A, 0xBE, 0xAD, 0xC9,
+        0x15, 0xA9, 0x5F, 0x54,
+        0x00, 0xC4, 0x3C, 0x00,
+        0x89, 0xFA, 0xCD, 0x91,
+        0x59, 0xC6, 0xD8, 0x61,
+        0x08, 0x70, 0xE1, 0x00,
+        0x0B, 0x33, 0xB0, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // '$'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x02, 0x60, 0x00,
+        0x00, 0x16, 0xA3, 0x00,
+        0x03, 0xDA, 0xCB, 0x80,
+        0x09, 0x82, 0x70, 0x00,
+        0x09, 0xA3, 0x70, 0x00,
+        0x02, 0xBF, 0xD7, 0x10,
+        0x00, 0x04, 0xAB, 0xC0,
+        0x00, 0x02, 0x71, 0xF2,
+        0x06, 0x32, 0x76, 0xE0,
+        0x05, 0xBE, 0xEB, 0x30,
+        0x00, 0x02, 0x70, 0x00,
+        0x00, 0x02, 0x60, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // '%'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x10, 0x00, 0x00,
+        0x2C, 0xDA, 0x00, 0x00,
+        0x95, 0x0A, 0x40, 0x00,
+        0x95, 0x0A, 0x40, 0x01,
+        0x2B, 0xD9, 0x28, 0xA3,
+        0x00, 0x5A, 0x94, 0x00,
+        0x2A, 0x61, 0xAD, 0xC2,
+        0x00, 0x04, 0x90, 0x59,
+        0x00, 0x04, 0xA0, 0x69,
+        0x00, 0x00, 0x9D, 0xB1,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // '&'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x39, 0x84, 0x00,
+        0x03, 0xE7, 0x66, 0x00,
+        0x06, 0xB0, 0x00, 0x00,
+        0x02, 0xE2, 0x00, 0x00,
+        0x03, 0xEB, 0x00, 0x00,
+        0x1E, 0x3C, 0x70, 0x48,
+        0x7A, 0x02, 0xE4, 0x69,
+        0x7A, 0x00, 0x5D, 0xB5,
+        0x3E, 0x40, 0x0C, 0xE0,
+        0x06, 0xED, 0xE9, 0xC6,
+        0x00, 0x02, 0x10, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // '''
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x04, 0x40, 0x00,
+        0x00, 0x08, 0x80, 0x00,
+        0x00, 0x08, 0x80, 0x00,
+        0x00, 0x08, 0x80, 0x00,
+        0x00, 0x01, 0x10, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // '('
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x76, 0x00,
+        0x00, 0x02, 0xE1, 0x00,
+        0x00, 0x08, 0x90, 0x00,
+        0x00, 0x0D, 0x50, 0x00,
+        0x00, 0x1F, 0x20, 0x00,
+        0x00, 0x3F, 0x10, 0x00,
+        0x00, 0x3F, 0x10, 0x00,
+        0x00, 0x1F, 0x20, 0x00,
+        0x00, 0x0C, 0x60, 0x00,
+        0x00, 0x07, 0xA0, 0x00,
+        0x00, 0x01, 0xE2, 0x00,
+        0x00, 0x00, 0x55, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // ')'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x67, 0x00, 0x00,
+        0x00, 0x1E, 0x20, 0x00,
+        0x00, 0x09, 0x80, 0x00,
+        0x00, 0x05, 0xD0, 0x00,
+        0x00, 0x02, 0xF1, 0x00,
+        0x00, 0x01, 0xF3, 0x00,
+        0x00, 0x01, 0xF3, 0x00,
+        0x00, 0x02, 0xF1, 0x00,
+        0x00, 0x06, 0xC0, 0x00,
+        0x00, 0x0A, 0x70, 0x00,
+        0x00, 0x2E, 0x10, 0x00,
+        0x00, 0x55, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // '*'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x03, 0x30, 0x00,
+        0x04, 0x15, 0x51, 0x40,
+        0x04, 0xB9, 0x9B, 0x40,
+        0x00, 0x3D, 0xD3, 0x00,
+        0x07, 0x96, 0x69, 0x70,
+        0x01, 0x05, 0x50, 0x10,
+        0x00, 0x01, 0x10, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // '+'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x03, 0x30, 0x00,
+        0x00, 0x08, 0x80, 0x00,
+        0x00, 0x08, 0x80, 0x00,
+        0x39, 0x9C, 0xC9, 0x93,
+        0x27, 0x7B, 0xB7, 0x72,
+        0x00, 0x08, 0x80, 0x00,
+        0x00, 0x08, 0x80, 0x00,
+        0x00, 0x02, 0x20, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // ','
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x0A, 0xC0, 0x00,
+        0x00, 0x0C, 0xB0, 0x00,
+        0x00, 0x1F, 0x40, 0x00,
+        0x00, 0x39, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // '-'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x11, 0x11, 0x00,
+        0x00, 0x9E, 0xE9, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // '.'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x0B, 0xB0, 0x00,
+        0x00, 0x0B, 0xB0, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // '/'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x03, 0x50,
+        0x00, 0x00, 0x0B, 0x70,
+        0x00, 0x00, 0x3E, 0x10,
+        0x00, 0x00, 0xA8, 0x00,
+        0x00, 0x02, 0xE2, 0x00,
+        0x00, 0x09, 0x90, 0x00,
+        0x00, 0x1E, 0x20, 0x00,
+        0x00, 0x8A, 0x00, 0x00,
+        0x01, 0xE3, 0x00, 0x00,
+        0x07, 0xB0, 0x00, 0x00,
+        0x0E, 0x40, 0x00, 0x00,
+        0x13, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // '0'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x38, 0x83, 0x00,
+        0x03, 0xE8, 0x8E, 0x30,
+        0x0A, 0x90, 0x09, 0xA0,
+        0x0E, 0x50, 0x05, 0xE0,
+        0x0F, 0x45, 0x54, 0xF0,
+        0x1F, 0x4B, 0xB4, 0xF1,
+        0x0F, 0x40, 0x04, 0xF0,
+        0x0C, 0x70, 0x07, 0xC0,
+        0x07, 0xD1, 0x1D, 0x70,
+        0x00, 0xAE, 0xEA, 0x00,
+        0x00, 0x01, 0x10, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // '1'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x25, 0x70, 0x00,
+        0x05, 0xFD, 0xF1, 0x00,
+        0x01, 0x03, 0xF1, 0x00,
+        0x00, 0x03, 0xF1, 0x00,
+        0x00, 0x03, 0xF1, 0x00,
+        0x00, 0x03, 0xF1, 0x00,
+        0x00, 0x03, 0xF1, 0x00,
+        0x00, 0x03, 0xF1, 0x00,
+        0x00, 0x25, 0xF3, 0x20,
+        0x03, 0xEE, 0xEE, 0xE0,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // '2'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x02, 0x79, 0x82, 0x00,
+        0x0C, 0xA7, 0xAE, 0x30,
+        0x01, 0x00, 0x0B, 0xA0,
+        0x00, 0x00, 0x09, 0xA0,
+        0x00, 0x00, 0x1E, 0x50,
+        0x00, 0x00, 0xB9, 0x00,
+        0x00, 0x0A, 0xB0, 0x00,
+        0x00, 0x9B, 0x10, 0x00,
+        0x08, 0xD3, 0x22, 0x10,
+        0x0D, 0xEE, 0xEE, 0xB0,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // '3'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x03, 0x79, 0x83, 0x00,
+        0x09, 0x97, 0x9F, 0x40,
+        0x00, 0x00, 0x0A, 0xA0,
+        0x00, 0x00, 0x0B, 0x90,
+        0x00, 0x39, 0xBB, 0x20,
+        0x00, 0x37, 0x9D, 0x30,
+        0x00, 0x00, 0x08, 0xB0,
+        0x00, 0x00, 0x06, 0xD0,
+        0x05, 0x10, 0x2C, 0xA0,
+        0x0C, 0xFE, 0xFB, 0x10,
+        0x00, 0x12, 0x10, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // '4'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x47, 0x00,
+        0x00, 0x02, 0xEF, 0x00,
+        0x00, 0x0A, 0x8F, 0x00,
+        0x00, 0x5A, 0x4F, 0x00,
+        0x01, 0xD2, 0x4F, 0x00,
+        0x09, 0x70, 0x4F, 0x00,
+        0x2E, 0x55, 0x7F, 0x51,
+        0x3B, 0xBB, 0xCF, 0xB3,
+        0x00, 0x00, 0x4F, 0x00,
+        0x00, 0x00, 0x4E, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // '5'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x04, 0x77, 0x77, 0x10,
+        0x09, 0xD9, 0x99, 0x20,
+        0x09, 0x90, 0x00, 0x00,
+        0x09, 0x94, 0x20, 0x00,
+        0x09, 0xEC, 0xFB, 0x10,
+        0x01, 0x00, 0x2D, 0x80,
+        0x00, 0x00, 0x07, 0xC0,
+        0x00, 0x00, 0x07, 0xC0,
+        0x05, 0x00, 0x3D, 0x80,
+        0x0D, 0xFE, 0xF9, 0x00,
+        0x00, 0x12, 0x10, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // '6'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x17, 0x97, 0x20,
+        0x01, 0xDB, 0x79, 0x50,
+        0x09, 0xA0, 0x00, 0x00,
+        0x0D, 0x42, 0x31, 0x00,
+        0x0F, 0x9D, 0xCE, 0x30,
+        0x1F, 0xB0, 0x08, 0xC0,
+        0x0F, 0x60, 0x04, 0xF0,
+        0x0D, 0x60, 0x04, 0xF0,
+        0x08, 0xC1, 0x09, 0xB0,
+        0x01, 0xBE, 0xED, 0x20,
+        0x00, 0x01, 0x20, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // '7'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x07, 0x77, 0x77, 0x60,
+        0x09, 0x99, 0x9D, 0xB0,
+        0x00, 0x00, 0x0D, 0x60,
+        0x00, 0x00, 0x4E, 0x10,
+        0x00, 0x00, 0x99, 0x00,
+        0x00, 0x01, 0xE4, 0x00,
+        0x00, 0x06, 0xD0, 0x00,
+        0x00, 0x0C, 0x70, 0x00,
+        0x00, 0x3F, 0x20, 0x00,
+        0x00, 0x8A, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // '8'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x49, 0x94, 0x00,
+        0x06, 0xE7, 0x7E, 0x60,
+        0x0C, 0x70, 0x07, 0xC0,
+        0x0B, 0x80, 0x08, 0xB0,
+        0x02, 0xC9, 0x9C, 0x20,
+        0x04, 0xD9, 0x9D, 0x40,
+        0x0D, 0x60, 0x06, 0xD0,
+        0x1F, 0x40, 0x04, 0xF1,
+        0x0D, 0x90, 0x09, 0xD0,
+        0x03, 0xDE, 0xED, 0x30,
+        0x00, 0x02, 0x20, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // '9'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x59, 0x83, 0x00,
+        0x07, 0xE7, 0x8E, 0x30,
+        0x0E, 0x50, 0x09, 0xA0,
+        0x1F, 0x30, 0x06, 0xD0,
+        0x0F, 0x40, 0x08, 0xF0,
+        0x09, 0xC4, 0x5D, 0xF0,
+        0x01, 0x8C, 0xA6, 0xE0,
+        0x00, 0x00, 0x07, 0xB0,
+        0x02, 0x10, 0x3E, 0x50,
+        0x05, 0xFE, 0xE7, 0x00,
+        0x00, 0x12, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // ':'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x09, 0x90, 0x00,
+        0x00, 0x0C, 0xC0, 0x00,
+        0x00, 0x02, 0x20, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x0B, 0xB0, 0x00,
+        0x00, 0x0B, 0xB0, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // ';'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x09, 0x90, 0x00,
+        0x00, 0x0C, 0xC0, 0x00,
+        0x00, 0x02, 0x20, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x0A, 0xC0, 0x00,
+        0x00, 0x0C, 0xB0, 0x00,
+        0x00, 0x1F, 0x40, 0x00,
+        0x00, 0x39, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // '<'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x01,
+        0x00, 0x00, 0x28, 0xD5,
+        0x00, 0x5B, 0xE9, 0x30,
+        0x3E, 0xB5, 0x10, 0x00,
+        0x2C, 0xD8, 0x20, 0x00,
+        0x00, 0x38, 0xEB, 0x61,
+        0x00, 0x00, 0x05, 0xB5,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // '='
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x4D, 0xDD, 0xDD, 0xD4,
+        0x13, 0x33, 0x33, 0x31,
+        0x25, 0x55, 0x55, 0x52,
+        0x4B, 0xBB, 0xBB, 0xB4,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // '>'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x10, 0x00, 0x00, 0x00,
+        0x5D, 0x82, 0x00, 0x00,
+        0x03, 0x9E, 0xB5, 0x00,
+        0x00, 0x01, 0x5B, 0xE3,
+        0x00, 0x02, 0x8D, 0xC2,
+        0x16, 0xBE, 0x83, 0x00,
+        0x5B, 0x50, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // '?'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x48, 0x94, 0x00,
+        0x05, 0xC7, 0x8F, 0x50,
+        0x01, 0x00, 0x0A, 0xA0,
+        0x00, 0x00, 0x1D, 0x60,
+        0x00, 0x01, 0xCA, 0x00,
+        0x00, 0x09, 0xB0, 0x00,
+        0x00, 0x0B, 0x60, 0x00,
+        0x00, 0x05, 0x30, 0x00,
+        0x00, 0x08, 0x40, 0x00,
+        0x00, 0x0B, 0x70, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // '@'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x4A, 0xCA, 0x30,
+        0x06, 0xC4, 0x14, 0xD2,
+        0x2D, 0x10, 0x12, 0x77,
+        0x78, 0x07, 0xDC, 0xC8,
+        0xA5, 0x2D, 0x10, 0x98,
+        0xB4, 0x4B, 0x00, 0x58,
+        0xA4, 0x2D, 0x10, 0x98,
+        0x78, 0x08, 0xDB, 0xD8,
+        0x2D, 0x20, 0x23, 0x11,
+        0x06, 0xD4, 0x00, 0x10,
+        0x00, 0x4B, 0xDD, 0x70,
+        0x00, 0x00, 0x00, 0x00,
+        // 'A'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x05, 0x50, 0x00,
+        0x00, 0x1F, 0xF1, 0x00,
+        0x00, 0x5C, 0xC5, 0x00,
+        0x00, 0xA7, 0x7A, 0x00,
+        0x00, 0xE3, 0x3E, 0x00,
+        0x04, 0xE0, 0x0E, 0x40,
+        0x09, 0xD8, 0x8D, 0x90,
+        0x0D, 0xA8, 0x8A, 0xD0,
+        0x3F, 0x10, 0x01, 0xF3,
+        0x7B, 0x00, 0x00, 0xB7,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'B'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x05, 0x77, 0x63, 0x00,
+        0x0D, 0xC9, 0xAE, 0x70,
+        0x0D, 0x70, 0x06, 0xD0,
+        0x0D, 0x70, 0x06, 0xD0,
+        0x0D, 0xB8, 0x9D, 0x50,
+        0x0D, 0xB8, 0x8D, 0x70,
+        0x0D, 0x70, 0x02, 0xF2,
+        0x0D, 0x70, 0x00, 0xF4,
+        0x0D, 0x71, 0x28, 0xE1,
+        0x0C, 0xEE, 0xEB, 0x40,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'C'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x06, 0x98, 0x40,
+        0x01, 0xCC, 0x78, 0xC0,
+        0x07, 0xD1, 0x00, 0x00,
+        0x0C, 0x80, 0x00, 0x00,
+        0x0E, 0x50, 0x00, 0x00,
+        0x0F, 0x50, 0x00, 0x00,
+        0x0E, 0x60, 0x00, 0x00,
+        0x0A, 0xA0, 0x00, 0x00,
+        0x04, 0xF4, 0x00, 0x50,
+        0x00, 0x5E, 0xEE, 0xB0,
+        0x00, 0x00, 0x21, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'D'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x07, 0x76, 0x30, 0x00,
+        0x0F, 0xBA, 0xEB, 0x10,
+        0x0F, 0x40, 0x1C, 0x80,
+        0x0F, 0x40, 0x07, 0xD0,
+        0x0F, 0x40, 0x04, 0xF1,
+        0x0F, 0x40, 0x04, 0xF1,
+        0x0F, 0x40, 0x05, 0xF0,
+        0x0F, 0x40, 0x09, 0xC0,
+        0x0F, 0x52, 0x6F, 0x40,
+        0x0E, 0xEE, 0xB4, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'E'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x04, 0x77, 0x77, 0x60,
+        0x0A, 0xD9, 0x99, 0x90,
+        0x0A, 0x90, 0x00, 0x00,
+        0x0A, 0x90, 0x00, 0x00,
+        0x0A, 0xD8, 0x88, 0x60,
+        0x0A, 0xC8, 0x88, 0x60,
+        0x0A, 0x90, 0x00, 0x00,
+        0x0A, 0x90, 0x00, 0x00,
+        0x0A, 0xA2, 0x22, 0x20,
+        0x09, 0xEE, 0xEE, 0xE1,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'F'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x03, 0x77, 0x77, 0x71,
+        0x06, 0xE9, 0x99, 0x91,
+        0x06, 0xD0, 0x00, 0x00,
+        0x06, 0xD0, 0x00, 0x00,
+        0x06, 0xE9, 0x99, 0x70,
+        0x06, 0xE8, 0x88, 0x50,
+        0x06, 0xD0, 0x00, 0x00,
+        0x06, 0xD0, 0x00, 0x00,
+        0x06, 0xD0, 0x00, 0x00,
+        0x06, 0xC0, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'G'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x17, 0x97, 0x20,
+        0x02, 0xEA, 0x79, 0xB0,
+        0x0B, 0xA0, 0x00, 0x10,
+        0x1F, 0x40, 0x00, 0x00,
+        0x3F, 0x20, 0x00, 0x00,
+        0x3F, 0x10, 0x7D, 0xD1,
+        0x2F, 0x30, 0x15, 0xF1,
+        0x0E, 0x60, 0x02, 0xF1,
+        0x07, 0xD2, 0x03, 0xF1,
+        0x00, 0x8E, 0xDE, 0x90,
+        0x00, 0x00, 0x21, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'H'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x07, 0x20, 0x02, 0x70,
+        0x0F, 0x40, 0x04, 0xF0,
+        0x0F, 0x40, 0x04, 0xF0,
+        0x0F, 0x40, 0x04, 0xF0,
+        0x0F, 0xA8, 0x8A, 0xF0,
+        0x0F, 0x98, 0x89, 0xF0,
+        0x0F, 0x40, 0x04, 0xF0,
+        0x0F, 0x40, 0x04, 0xF0,
+        0x0F, 0x40, 0x04, 0xF0,
+        0x0E, 0x40, 0x04, 0xE0,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'I'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x04, 0x77, 0x77, 0x40,
+        0x06, 0x9D, 0xD9, 0x60,
+        0x00, 0x0A, 0x90, 0x00,
+        0x00, 0x0A, 0x90, 0x00,
+        0x00, 0x0A, 0x90, 0x00,
+        0x00, 0x0A, 0x90, 0x00,
+        0x00, 0x0A, 0x90, 0x00,
+        0x00, 0x0A, 0x90, 0x00,
+        0x01, 0x2A, 0xA2, 0x10,
+        0x09, 0xEE, 0xEE, 0x80,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'J'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x37, 0x77, 0x10,
+        0x00, 0x59, 0xAF, 0x20,
+        0x00, 0x00, 0x2F, 0x20,
+        0x00, 0x00, 0x2F, 0x20,
+        0x00, 0x00, 0x2F, 0x20,
+        0x00, 0x00, 0x2F, 0x20,
+        0x00, 0x00, 0x2F, 0x20,
+        0x00, 0x00, 0x3F, 0x20,
+        0x26, 0x00, 0x7E, 0x00,
+        0x2D, 0xEE, 0xE5, 0x00,
+        0x00, 0x12, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'K'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x07, 0x20, 0x00, 0x63,
+        0x0F, 0x40, 0x0A, 0xC1,
+        0x0F, 0x40, 0x9C, 0x10,
+        0x0F, 0x48, 0xD1, 0x00,
+        0x0F, 0xBF, 0x40, 0x00,
+        0x0F, 0xDA, 0xC0, 0x00,
+        0x0F, 0x41, 0xD7, 0x00,
+        0x0F, 0x40, 0x5F, 0x30,
+        0x0F, 0x40, 0x0A, 0xC0,
+        0x0E, 0x40, 0x01, 0xD7,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'L'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x03, 0x50, 0x00, 0x00,
+        0x08, 0xB0, 0x00, 0x00,
+        0x08, 0xB0, 0x00, 0x00,
+        0x08, 0xB0, 0x00, 0x00,
+        0x08, 0xB0, 0x00, 0x00,
+        0x08, 0xB0, 0x00, 0x00,
+        0x08, 0xB0, 0x00, 0x00,
+        0x08, 0xB0, 0x00, 0x00,
+        0x08, 0xC2, 0x22, 0x21,
+        0x07, 0xEE, 0xEE, 0xE4,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'M'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x27, 0x30, 0x03, 0x72,
+        0x5F, 0xA0, 0x0A, 0xF5,
+        0x5D, 0xD1, 0x1D, 0xD5,
+        0x5C, 0x85, 0x68, 0xD5,
+        0x5C, 0x3A, 0xB3, 0xD5,
+        0x5C, 0x0D, 0xD0, 0xD5,
+        0x5C, 0x06, 0x50, 0xD5,
+        0x5C, 0x00, 0x00, 0xD5,
+        0x5C, 0x00, 0x00, 0xD5,
+        0x5C, 0x00, 0x00, 0xC5,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'N'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x07, 0x50, 0x01, 0x70,
+        0x0F, 0xE1, 0x03, 0xF0,
+        0x0F, 0xD6, 0x03, 0xF0,
+        0x0F, 0x7C, 0x03, 0xF0,
+        0x0F, 0x3D, 0x33, 0xF0,
+        0x0F, 0x37, 0x93, 0xF0,
+        0x0F, 0x31, 0xE4, 0xF0,
+        0x0F, 0x30, 0x9A, 0xF0,
+        0x0F, 0x30, 0x3F, 0xF0,
+        0x0E, 0x30, 0x0B, 0xE0,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'O'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x38, 0x83, 0x00,
+        0x04, 0xE8, 0x8E, 0x40,
+        0x0C, 0x80, 0x08, 0xC0,
+        0x0F, 0x40, 0x04, 0xF0,
+        0x2F, 0x30, 0x03, 0xF2,
+        0x2F, 0x30, 0x03, 0xF2,
+        0x1F, 0x40, 0x04, 0xF1,
+        0x0E, 0x60, 0x06, 0xE0,
+        0x09, 0xC1, 0x1C, 0x90,
+        0x01, 0xBE, 0xEB, 0x10,
+        0x00, 0x01, 0x10, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'P'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x04, 0x77, 0x64, 0x00,
+        0x0A, 0xD9, 0xAE, 0xA0,
+        0x0A, 0x90, 0x04, 0xF3,
+        0x0A, 0x90, 0x01, 0xF4,
+        0x0A, 0x90, 0x06, 0xF2,
+        0x0A, 0xED, 0xEE, 0x60,
+        0x0A, 0xB3, 0x30, 0x00,
+        0x0A, 0x90, 0x00, 0x00,
+        0x0A, 0x90, 0x00, 0x00,
+        0x09, 0x90, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'Q'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x38, 0x83, 0x00,
+        0x04, 0xE8, 0x8E, 0x40,
+        0x0C, 0x80, 0x08, 0xC0,
+        0x0F, 0x40, 0x04, 0xF0,
+        0x2F, 0x30, 0x03, 0xF2,
+        0x2F, 0x30, 0x03, 0xF2,
+        0x1F, 0x40, 0x04, 0xF1,
+        0x0E, 0x60, 0x06, 0xE0,
+        0x09, 0xC1, 0x1C, 0x90,
+        0x01, 0xBE, 0xEC, 0x10,
+        0x00, 0x01, 0x6E, 0x30,
+        0x00, 0x00, 0x06, 0x30,
+        0x00, 0x00, 0x00, 0x00,
+        // 'R'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x06, 0x77, 0x51, 0x00,
+        0x0F, 0xB9, 0xCE, 0x40,
+        0x0F, 0x40, 0x0A, 0xB0,
+        0x0F, 0x40, 0x08, 0xC0,
+        0x0F, 0x51, 0x3D, 0x80,
+        0x0F, 0xFF, 0xF8, 0x00,
+        0x0F, 0x40, 0x5E, 0x20,
+        0x0F, 0x40, 0x0A, 0xA0,
+        0x0F, 0x40, 0x03, 0xF2,
+        0x0E, 0x40, 0x00, 0xA9,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'S'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x48, 0x96, 0x10,
+        0x07, 0xE8, 0x7A, 0x70,
+        0x0E, 0x50, 0x00, 0x00,
+        0x0F, 0x50, 0x00, 0x00,
+        0x09, 0xE9, 0x61, 0x00,
+        0x00, 0x5A, 0xEE, 0x50,
+        0x00, 0x00, 0x08, 0xD0,
+        0x00, 0x00, 0x03, 0xF0,
+        0x07, 0x20, 0x09, 0xC0,
+        0x0A, 0xFE, 0xED, 0x30,
+        0x00, 0x02, 0x10, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'T'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x47, 0x77, 0x77, 0x74,
+        0x59, 0x9D, 0xD9, 0x95,
+        0x00, 0x09, 0xA0, 0x00,
+        0x00, 0x09, 0xA0, 0x00,
+        0x00, 0x09, 0xA0, 0x00,
+        0x00, 0x09, 0xA0, 0x00,
+        0x00, 0x09, 0xA0, 0x00,
+        0x00, 0x09, 0xA0, 0x00,
+        0x00, 0x09, 0xA0, 0x00,
+        0x00, 0x09, 0x90, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'U'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x06, 0x20, 0x02, 0x60,
+        0x0E, 0x50, 0x05, 0xE0,
+        0x0E, 0x50, 0x05, 0xE0,
+        0x0E, 0x50, 0x05, 0xE0,
+        0x0E, 0x50, 0x05, 0xE0,
+        0x0E, 0x50, 0x05, 0xE0,
+        0x0E, 0x50, 0x05, 0xE0,
+        0x0E, 0x50, 0x05, 0xE0,
+        0x0B, 0xA0, 0x0A, 0xB0,
+        0x02, 0xCE, 0xEC, 0x20,
+        0x00, 0x02, 0x20, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'V'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x36, 0x00, 0x00, 0x63,
+        0x4F, 0x10, 0x01, 0xF4,
+        0x0E, 0x50, 0x05, 0xE0,
+        0x0A, 0x90, 0x09, 0xA0,
+        0x06, 0xD0, 0x0D, 0x60,
+        0x01, 0xF2, 0x2F, 0x10,
+        0x00, 0xC5, 0x6C, 0x00,
+        0x00, 0x79, 0xA7, 0x00,
+        0x00, 0x3D, 0xD3, 0x00,
+        0x00, 0x0D, 0xD0, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'W'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x63, 0x00, 0x00, 0x36,
+        0xB7, 0x00, 0x00, 0x7B,
+        0x99, 0x00, 0x00, 0x99,
+        0x7B, 0x0A, 0xA0, 0xB7,
+        0x4C, 0x0E, 0xD0, 0xC4,
+        0x2E, 0x3B, 0xB2, 0xE2,
+        0x0F, 0x78, 0x87, 0xF0,
+        0x0D, 0xC4, 0x4B, 0xD0,
+        0x0A, 0xF1, 0x1F, 0xA0,
+        0x08, 0xC0, 0x0C, 0x80,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'X'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x17, 0x10, 0x00, 0x63,
+        0x0B, 0x90, 0x05, 0xE1,
+        0x03, 0xE3, 0x1E, 0x50,
+        0x00, 0x8B, 0x8A, 0x00,
+        0x00, 0x1D, 0xE2, 0x00,
+        0x00, 0x1D, 0xE2, 0x00,
+        0x00, 0x9B, 0x9A, 0x00,
+        0x03, 0xE2, 0x1E, 0x40,
+        0x0C, 0x80, 0x07, 0xD0,
+        0x6C, 0x00, 0x00, 0xC6,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'Y'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x35, 0x00, 0x00, 0x53,
+        0x2F, 0x30, 0x04, 0xF2,
+        0x08, 0xC0, 0x0C, 0x80,
+        0x01, 0xD5, 0x5D, 0x10,
+        0x00, 0x6D, 0xD5, 0x00,
+        0x00, 0x0C, 0xC0, 0x00,
+        0x00, 0x0A, 0x90, 0x00,
+        0x00, 0x0A, 0x90, 0x00,
+        0x00, 0x0A, 0x90, 0x00,
+        0x00, 0x09, 0x90, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'Z'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x05, 0x77, 0x77, 0x72,
+        0x07, 0x99, 0x9B, 0xF4,
+        0x00, 0x00, 0x0A, 0xA0,
+        0x00, 0x00, 0x5E, 0x10,
+        0x00, 0x01, 0xE5, 0x00,
+        0x00, 0x09, 0xA0, 0x00,
+        0x00, 0x4E, 0x10, 0x00,
+        0x01, 0xD5, 0x00, 0x00,
+        0x09, 0xB2, 0x22, 0x21,
+        0x0D, 0xEE, 0xEE, 0xE7,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // '['
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x0C, 0xC9, 0x00,
+        0x00, 0x0E, 0x41, 0x00,
+        0x00, 0x0E, 0x30, 0x00,
+        0x00, 0x0E, 0x30, 0x00,
+        0x00, 0x0E, 0x30, 0x00,
+        0x00, 0x0E, 0x30, 0x00,
+        0x00, 0x0E, 0x30, 0x00,
+        0x00, 0x0E, 0x30, 0x00,
+        0x00, 0x0E, 0x30, 0x00,
+        0x00, 0x0E, 0x30, 0x00,
+        0x00, 0x0E, 0x63, 0x00,
+        0x00, 0x0A, 0xA7, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'backslash'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x17, 0x00, 0x00, 0x00,
+        0x0C, 0x60, 0x00, 0x00,
+        0x05, 0xD0, 0x00, 0x00,
+        0x00, 0xD5, 0x00, 0x00,
+        0x00, 0x6C, 0x00, 0x00,
+        0x00, 0x0E, 0x40, 0x00,
+        0x00, 0x07, 0xB0, 0x00,
+        0x00, 0x01, 0xE3, 0x00,
+        0x00, 0x00, 0x8A, 0x00,
+        0x00, 0x00, 0x1E, 0x20,
+        0x00, 0x00, 0x09, 0x90,
+        0x00, 0x00, 0x01, 0x20,
+        0x00, 0x00, 0x00, 0x00,
+        // ']'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x9C, 0xC0, 0x00,
+        0x00, 0x14, 0xE0, 0x00,
+        0x00, 0x03, 0xE0, 0x00,
+        0x00, 0x03, 0xE0, 0x00,
+        0x00, 0x03, 0xE0, 0x00,
+        0x00, 0x03, 0xE0, 0x00,
+        0x00, 0x03, 0xE0, 0x00,
+        0x00, 0x03, 0xE0, 0x00,
+        0x00, 0x03, 0xE0, 0x00,
+        0x00, 0x03, 0xE0, 0x00,
+        0x00, 0x36, 0xE0, 0x00,
+        0x00, 0x7A, 0xA0, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // '^'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x05, 0x50, 0x00,
+        0x00, 0x5E, 0xE5, 0x00,
+        0x03, 0xE3, 0x3E, 0x30,
+        0x1D, 0x40, 0x04, 0xD1,
+        0x01, 0x00, 0x00, 0x10,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // '_'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x78, 0x88, 0x88, 0x87,
+        // '`'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x51, 0x00, 0x00,
+        0x00, 0x6B, 0x00, 0x00,
+        0x00, 0x08, 0x80, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'a'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x14, 0x30, 0x00,
+        0x07, 0xEB, 0xCD, 0x20,
+        0x02, 0x00, 0x09, 0xA0,
+        0x00, 0x47, 0x8A, 0xC0,
+        0x09, 0xD7, 0x7A, 0xC0,
+        0x0F, 0x30, 0x07, 0xC0,
+        0x0E, 0x50, 0x2D, 0xC0,
+        0x06, 0xED, 0xD8, 0xB0,
+        0x00, 0x12, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'b'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x08, 0x60, 0x00, 0x00,
+        0x0A, 0x70, 0x00, 0x00,
+        0x0A, 0x71, 0x41, 0x00,
+        0x0A, 0xBD, 0xCE, 0x30,
+        0x0A, 0xD1, 0x08, 0xC0,
+        0x0A, 0x90, 0x03, 0xF1,
+        0x0A, 0x70, 0x02, 0xF2,
+        0x0A, 0x90, 0x03, 0xF1,
+        0x0A, 0xE1, 0x09, 0xB0,
+        0x09, 0xAD, 0xDD, 0x20,
+        0x00, 0x00, 0x20, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'c'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x01, 0x43, 0x00,
+        0x00, 0x7E, 0xCC, 0xB0,
+        0x04, 0xE3, 0x00, 0x20,
+        0x08, 0xA0, 0x00, 0x00,
+        0x0A, 0x90, 0x00, 0x00,
+        0x08, 0xB0, 0x00, 0x00,
+        0x03, 0xF4, 0x00, 0x40,
+        0x00, 0x5E, 0xDE, 0xA0,
+        0x00, 0x00, 0x21, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'd'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x06, 0x80,
+        0x00, 0x00, 0x07, 0xA0,
+        0x00, 0x14, 0x27, 0xA0,
+        0x03, 0xEC, 0xDB, 0xA0,
+        0x0C, 0x80, 0x1D, 0xA0,
+        0x1F, 0x30, 0x08, 0xA0,
+        0x1F, 0x20, 0x07, 0xA0,
+        0x0F, 0x30, 0x09, 0xA0,
+        0x0B, 0x90, 0x1E, 0xA0,
+        0x02, 0xDD, 0xDA, 0xA0,
+        0x00, 0x02, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'e'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x03, 0x31, 0x00,
+        0x01, 0xCD, 0xCE, 0x30,
+        0x0A, 0xA0, 0x06, 0xC0,
+        0x0F, 0x63, 0x34, 0xF1,
+        0x1F, 0xBA, 0xAA, 0xA1,
+        0x0F, 0x30, 0x00, 0x00,
+        0x09, 0xA1, 0x01, 0x40,
+        0x01, 0xAE, 0xDE, 0xA0,
+        0x00, 0x01, 0x21, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'f'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x02, 0xAC, 0xA0,
+        0x00, 0x0A, 0xA2, 0x20,
+        0x01, 0x1C, 0x61, 0x10,
+        0x08, 0xCE, 0xDC, 0xA0,
+        0x00, 0x0C, 0x60, 0x00,
+        0x00, 0x0C, 0x60, 0x00,
+        0x00, 0x0C, 0x60, 0x00,
+        0x00, 0x0C, 0x60, 0x00,
+        0x00, 0x0C, 0x60, 0x00,
+        0x00, 0x0B, 0x50, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'g'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x14, 0x20, 0x10,
+        0x03, 0xEC, 0xDB, 0xA0,
+        0x0C, 0x80, 0x0D, 0xA0,
+        0x1F, 0x30, 0x08, 0xA0,
+        0x1F, 0x20, 0x07, 0xA0,
+        0x0F, 0x40, 0x09, 0xA0,
+        0x0A, 0xA1, 0x2E, 0xA0,
+        0x01, 0xBF, 0xC9, 0xA0,
+        0x00, 0x00, 0x09, 0x90,
+        0x03, 0x73, 0x5E, 0x30,
+        0x02, 0x9B, 0xA4, 0x00,
+        // 'h'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x08, 0x60, 0x00, 0x00,
+        0x0A, 0x80, 0x00, 0x00,
+        0x0A, 0x81, 0x41, 0x00,
+        0x0A, 0xBC, 0xCF, 0x30,
+        0x0A, 0xD1, 0x0A, 0x90,
+        0x0A, 0x80, 0x07, 0xB0,
+        0x0A, 0x80, 0x06, 0xB0,
+        0x0A, 0x80, 0x06, 0xB0,
+        0x0A, 0x80, 0x06, 0xB0,
+        0x09, 0x70, 0x06, 0xA0,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'i'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x06, 0x80, 0x00,
+        0x00, 0x04, 0x70, 0x00,
+        0x00, 0x11, 0x10, 0x00,
+        0x03, 0xCD, 0xA0, 0x00,
+        0x00, 0x07, 0xA0, 0x00,
+        0x00, 0x07, 0xA0, 0x00,
+        0x00, 0x07, 0xA0, 0x00,
+        0x00, 0x07, 0xA0, 0x00,
+        0x00, 0x07, 0xA0, 0x00,
+        0x0A, 0xDE, 0xED, 0xD0,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'j'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x01, 0xC1, 0x00,
+        0x00, 0x01, 0x91, 0x00,
+        0x00, 0x11, 0x10, 0x00,
+        0x01, 0xCC, 0xF1, 0x00,
+        0x00, 0x02, 0xF1, 0x00,
+        0x00, 0x02, 0xF1, 0x00,
+        0x00, 0x02, 0xF1, 0x00,
+        0x00, 0x02, 0xF1, 0x00,
+        0x00, 0x02, 0xF1, 0x00,
+        0x00, 0x02, 0xF1, 0x00,
+        0x00, 0x02, 0xF0, 0x00,
+        0x03, 0x5A, 0xB0, 0x00,
+        0x07, 0x98, 0x10, 0x00,
+        // 'k'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x05, 0xA0, 0x00, 0x00,
+        0x06, 0xC0, 0x00, 0x00,
+        0x06, 0xC0, 0x00, 0x10,
+        0x06, 0xC0, 0x1B, 0x90,
+        0x06, 0xC1, 0xB9, 0x00,
+        0x06, 0xDC, 0xB0, 0x00,
+        0x06, 0xF9, 0xE3, 0x00,
+        0x06, 0xC0, 0x7D, 0x10,
+        0x06, 0xC0, 0x0B, 0x90,
+        0x06, 0xB0, 0x02, 0xD5,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'l'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x0B, 0xDD, 0x20, 0x00,
+        0x00, 0x0F, 0x20, 0x00,
+        0x00, 0x0F, 0x20, 0x00,
+        0x00, 0x0F, 0x20, 0x00,
+        0x00, 0x0F, 0x20, 0x00,
+        0x00, 0x0F, 0x20, 0x00,
+        0x00, 0x0F, 0x20, 0x00,
+        0x00, 0x0F, 0x20, 0x00,
+        0x00, 0x0D, 0x70, 0x00,
+        0x00, 0x04, 0xDE, 0x90,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'm'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x01, 0x23, 0x03, 0x10,
+        0x3E, 0xBE, 0xBC, 0xD0,
+        0x3E, 0x09, 0xA0, 0xD3,
+        0x3D, 0x08, 0x80, 0xC4,
+        0x3D, 0x08, 0x80, 0xC4,
+        0x3D, 0x08, 0x80, 0xC4,
+        0x3D, 0x08, 0x80, 0xC4,
+        0x3C, 0x07, 0x80, 0xB4,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'n'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x01, 0x01, 0x41, 0x00,
+        0x0A, 0xBC, 0xCF, 0x30,
+        0x0A, 0xD1, 0x0A, 0x90,
+        0x0A, 0x80, 0x07, 0xB0,
+        0x0A, 0x80, 0x06, 0xB0,
+        0x0A, 0x80, 0x06, 0xB0,
+        0x0A, 0x80, 0x06, 0xB0,
+        0x09, 0x70, 0x06, 0xA0,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'o'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x03, 0x30, 0x00,
+        0x02, 0xDC, 0xCD, 0x20,
+        0x0A, 0xA0, 0x0A, 0xA0,
+        0x0E, 0x40, 0x04, 0xE0,
+        0x0F, 0x30, 0x03, 0xF0,
+        0x0E, 0x50, 0x05, 0xE0,
+        0x0A, 0xB0, 0x0B, 0xA0,
+        0x01, 0xCE, 0xEC, 0x10,
+        0x00, 0x01, 0x10, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'p'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x01, 0x01, 0x41, 0x00,
+        0x0A, 0xBD, 0xCE, 0x30,
+        0x0A, 0xD1, 0x08, 0xB0,
+        0x0A, 0x80, 0x03, 0xF0,
+        0x0A, 0x70, 0x02, 0xF1,
+        0x0A, 0x90, 0x03, 0xF0,
+        0x0A, 0xD1, 0x09, 0xB0,
+        0x0A, 0xBD, 0xDD, 0x20,
+        0x0A, 0x71, 0x20, 0x00,
+        0x0A, 0x70, 0x00, 0x00,
+        0x06, 0x50, 0x00, 0x00,
+        // 'q'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x03, 0x10, 0x10,
+        0x02, 0xDC, 0xDB, 0xB0,
+        0x0A, 0xA0, 0x0C, 0xB0,
+        0x0E, 0x40, 0x07, 0xB0,
+        0x0F, 0x30, 0x06, 0xB0,
+        0x0E, 0x40, 0x07, 0xB0,
+        0x0A, 0xA0, 0x1D, 0xB0,
+        0x02, 0xDD, 0xDA, 0xB0,
+        0x00, 0x02, 0x16, 0xB0,
+        0x00, 0x00, 0x06, 0xB0,
+        0x00, 0x00, 0x04, 0x80,
+        // 'r'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x11, 0x03, 0x30,
+        0x00, 0x9A, 0xCD, 0xE5,
+        0x00, 0x9E, 0x30, 0x01,
+        0x00, 0x9A, 0x00, 0x00,
+        0x00, 0x98, 0x00, 0x00,
+        0x00, 0x98, 0x00, 0x00,
+        0x00, 0x98, 0x00, 0x00,
+        0x00, 0x88, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 's'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x03, 0x41, 0x00,
+        0x02, 0xDC, 0xBE, 0x30,
+        0x07, 0xB0, 0x00, 0x10,
+        0x06, 0xD5, 0x10, 0x00,
+        0x00, 0x7C, 0xFC, 0x20,
+        0x00, 0x00, 0x1C, 0x80,
+        0x03, 0x10, 0x0B, 0x80,
+        0x06, 0xED, 0xEB, 0x10,
+        0x00, 0x02, 0x10, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 't'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x01, 0x00, 0x00,
+        0x00, 0x3F, 0x00, 0x00,
+        0x01, 0x3F, 0x11, 0x10,
+        0x1C, 0xDF, 0xCC, 0x70,
+        0x00, 0x3F, 0x00, 0x00,
+        0x00, 0x3F, 0x00, 0x00,
+        0x00, 0x3F, 0x00, 0x00,
+        0x00, 0x3F, 0x00, 0x00,
+        0x00, 0x1F, 0x30, 0x00,
+        0x00, 0x07, 0xED, 0x80,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'u'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x01, 0x00, 0x00, 0x10,
+        0x0A, 0x80, 0x06, 0xB0,
+        0x0A, 0x80, 0x06, 0xB0,
+        0x0A, 0x80, 0x06, 0xB0,
+        0x0A, 0x80, 0x06, 0xB0,
+        0x0A, 0x80, 0x07, 0xB0,
+        0x08, 0xB0, 0x1C, 0xB0,
+        0x02, 0xDE, 0xD9, 0xA0,
+        0x00, 0x02, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'v'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x01, 0x00, 0x00, 0x10,
+        0x1F, 0x20, 0x02, 0xF1,
+        0x0A, 0x80, 0x08, 0xA0,
+        0x05, 0xD0, 0x0D, 0x50,
+        0x00, 0xE3, 0x3E, 0x00,
+        0x00, 0x98, 0x89, 0x00,
+        0x00, 0x4D, 0xD4, 0x00,
+        0x00, 0x0D, 0xD0, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'w'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x10, 0x00, 0x00, 0x01,
+        0xB6, 0x00, 0x00, 0x6B,
+        0x89, 0x00, 0x00, 0x98,
+        0x4C, 0x0A, 0xA0, 0xC4,
+        0x1F, 0x1C, 0xC1, 0xF1,
+        0x0C, 0x79, 0x97, 0xC0,
+        0x09, 0xE5, 0x5E, 0x90,
+        0x05, 0xE1, 0x1E, 0x50,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'x'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x01, 0x00, 0x00, 0x10,
+        0x0B, 0x80, 0x09, 0xB0,
+        0x01, 0xD4, 0x5D, 0x10,
+        0x00, 0x4E, 0xE4, 0x00,
+        0x00, 0x0D, 0xD0, 0x00,
+        0x00, 0x8B, 0xB8, 0x00,
+        0x05, 0xE1, 0x1E, 0x50,
+        0x1D, 0x40, 0x04, 0xD1,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // 'y'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x01, 0x00, 0x00, 0x10,
+        0x1E, 0x30, 0x01, 0xF2,
+        0x09, 0x90, 0x07, 0xB0,
+        0x03, 0xE1, 0x0C, 0x60,
+        0x00, 0xC5, 0x3E, 0x10,
+        0x00, 0x6B, 0x89, 0x00,
+        0x00, 0x1E, 0xE3, 0x00,
+        0x00, 0x0A, 0xC0, 0x00,
+        0x00, 0x0B, 0x70, 0x00,
+        0x03, 0x8E, 0x10, 0x00,
+        0x07, 0x93, 0x00, 0x00,
+        // 'z'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x01, 0x22, 0x22, 0x10,
+        0x05, 0xCC, 0xCE, 0xA0,
+        0x00, 0x00, 0x2E, 0x40,
+        0x00, 0x01, 0xD6, 0x00,
+        0x00, 0x0A, 0x90, 0x00,
+        0x00, 0x7C, 0x10, 0x00,
+        0x04, 0xE2, 0x00, 0x00,
+        0x08, 0xEE, 0xEE, 0x90,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        // '{'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x01, 0x9C, 0x60,
+        0x00, 0x07, 0xC2, 0x00,
+        0x00, 0x08, 0xA0, 0x00,
+        0x00, 0x08, 0x90, 0x00,
+        0x00, 0x09, 0x90, 0x00,
+        0x02, 0x6E, 0x50, 0x00,
+        0x04, 0xAD, 0x30, 0x00,
+        0x00, 0x0A, 0x90, 0x00,
+        0x00, 0x08, 0x90, 0x00,
+        0x00, 0x08, 0x90, 0x00,
+        0x00, 0x07, 0xB0, 0x00,
+        0x00, 0x02, 0xDE, 0x60,
+        0x00, 0x00, 0x01, 0x00,
+        // '|'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x07, 0x70, 0x00,
+        0x00, 0x08, 0x80, 0x00,
+        0x00, 0x08, 0x80, 0x00,
+        0x00, 0x08, 0x80, 0x00,
+        0x00, 0x08, 0x80, 0x00,
+        0x00, 0x08, 0x80, 0x00,
+        0x00, 0x08, 0x80, 0x00,
+        0x00, 0x08, 0x80, 0x00,
+        0x00, 0x08, 0x80, 0x00,
+        0x00, 0x08, 0x80, 0x00,
+        0x00, 0x08, 0x80, 0x00,
+        0x00, 0x08, 0x80, 0x00,
+        0x00, 0x08, 0x80, 0x00,
+        // '}'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x06, 0xC9, 0x10, 0x00,
+        0x00, 0x2C, 0x60, 0x00,
+        0x00, 0x0A, 0x80, 0x00,
+        0x00, 0x09, 0x80, 0x00,
+        0x00, 0x09, 0x90, 0x00,
+        0x00, 0x05, 0xE6, 0x20,
+        0x00, 0x03, 0xD9, 0x40,
+        0x00, 0x09, 0x90, 0x00,
+        0x00, 0x09, 0x80, 0x00,
+        0x00, 0x09, 0x80, 0x00,
+        0x00, 0x0B, 0x70, 0x00,
+        0x06, 0xED, 0x20, 0x00,
+        0x00, 0x10, 0x00, 0x00,
+        // '~'
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x2B, 0xEC, 0x63, 0x64,
+        0x45, 0x24, 0xAD, 0xA1,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00,
+    };
+} // namespace UI::FONT
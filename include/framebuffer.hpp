@@ -0,0 +1,129 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#ifdef __SWITCH__
+#include <switch.h>
+#endif
+
+namespace UI
+{
+    inline constexpr int SCREEN_WIDTH = 1280;
+    inline constexpr int SCREEN_HEIGHT = 720;
+    inline constexpr int FRAMEBUFFER_COUNT = 2;
+
+    // RGBA8888 as laid out in memory (R in the lowest byte)
+    [[nodiscard]] constexpr uint32_t rgba(uint8_t r, uint8_t g, uint8_t b, uint8_t a = 255) noexcept
+    {
+        return static_cast<uint32_t>(r) | (static_cast<uint32_t>(g) << 8) |
+               (static_cast<uint32_t>(b) << 16) | (static_cast<uint32_t>(a) << 24);
+    }
+
+    // Back buffer handed out for one frame; slot identifies which buffer it is
+    struct Frame
+    {
+        uint32_t *pixels = nullptr;
+        int stride = 0; // in pixels
+        int slot = 0;
+
+        [[nodiscard]] explicit operator bool() const noexcept { return pixels != nullptr; }
+    };
+
+    namespace detail
+    {
+        // Buffers are recognized by address, so callers can keep per-buffer state
+        class SlotMap
+        {
+            std::array<const void *, FRAMEBUFFER_COUNT> seen_{};
+
+        public:
+            [[nodiscard]] int slotFor(const void *buffer) noexcept
+            {
+                for (int i = 0; i < FRAMEBUFFER_COUNT; ++i)
+                {
+                    if (seen_[i] == buffer)
+                        return i;
+                    if (!seen_[i])
+                    {
+                        seen_[i] = buffer;
+                        return i;
+                    }
+                }
+                return 0;
+            }
+        };
+    } // namespace detail
+
+#ifdef __SWITCH__
+    // libnx framebuffer in linear mode; libnx swizzles the linear buffer on present,
+    // so in practice every frame draws on top of the previous one.
+    class Framebuffer
+    {
+        ::Framebuffer fb_{};
+        bool ready_ = false;
+        detail::SlotMap slots_;
+
+    public:
+        Framebuffer()
+        {
+            ready_ = R_SUCCEEDED(framebufferCreate(&fb_, nwindowGetDefault(), SCREEN_WIDTH, SCREEN_HEIGHT,
+                                                   PIXEL_FORMAT_RGBA_8888, FRAMEBUFFER_COUNT));
+            if (ready_ && R_FAILED(framebufferMakeLinear(&fb_)))
+            {
+                framebufferClose(&fb_);
+                ready_ = false;
+            }
+        }
+        ~Framebuffer()
+        {
+            if (ready_)
+                framebufferClose(&fb_);
+        }
+
+        Framebuffer(const Framebuffer &) = delete;
+        Framebuffer &operator=(const Framebuffer &) = delete;
+
+        [[nodiscard]] Frame begin()
+        {
+            if (!ready_)
+                return {};
+            u32 stride = 0;
+            auto *pixels = static_cast<uint32_t *>(framebufferBegin(&fb_, &stride));
+            return {pixels, static_cast<int>(stride / sizeof(uint32_t)), slots_.slotFor(pixels)};
+        }
+
+        void end() { framebufferEnd(&fb_); }
+    };
+#else
+    // Host stand-in: plain memory buffers presented round-robin
+    class Framebuffer
+    {
+        std::array<std::vector<uint32_t>, FRAMEBUFFER_COUNT> buffers_;
+        int next_ = 0, front_ = -1;
+
+    public:
+        Framebuffer()
+        {
+            for (auto &buffer : buffers_)
+                buffer.assign(static_cast<std::size_t>(SCREEN_WIDTH) * SCREEN_HEIGHT, 0);
+        }
+
+        Framebuffer(const Framebuffer &) = delete;
+        Framebuffer &operator=(const Framebuffer &) = delete;
+
+        [[nodiscard]] Frame begin() { return {buffers_[next_].data(), SCREEN_WIDTH, next_}; }
+
+        void end()
+        {
+            front_ = next_;
+            next_ = (next_ + 1) % FRAMEBUFFER_COUNT;
+        }
+
+        // Last presented frame, for inspection in host builds
+        [[nodiscard]] const uint32_t *front() const noexcept { return front_ < 0 ? nullptr : buffers_[front_].data(); }
+    };
+#endif
+} // namespace UI
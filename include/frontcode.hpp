@@ -0,0 +1,206 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace UTIL
+{
+    namespace detail
+    {
+        template <typename Unsigned>
+        void putVarint(std::vector<uint8_t> &out, Unsigned value)
+        {
+            while (value >= 0x80)
+            {
+                out.push_back(static_cast<uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            out.push_back(static_cast<uint8_t>(value));
+        }
+
+        [[nodiscard]] inline uint32_t getVarint(const uint8_t *&p) noexcept
+        {
+            uint32_t value = 0;
+            for (int shift = 0;; shift += 7)
+            {
+                const uint8_t byte = *p++;
+                value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+                if (byte < 0x80)
+                    return value;
+            }
+        }
+    } // namespace detail
+
+    // Sorted strings, front-coded: each entry stores only the length of the prefix it shares
+    // with the one before it and the bytes after that. Every BLOCK-th entry is a restart
+    // stored in full, so a lookup binary-searches the restarts and decodes at most one
+    // block. "The Legend of Zelda" x 40 costs its prefix once per block instead of 40 times.
+    class FrontCodedStrings
+    {
+    public:
+        static constexpr size_t BLOCK = 16;
+
+    private:
+        std::vector<uint8_t> data_;      // per entry: varint shared, varint suffix length, suffix
+        std::vector<uint32_t> restarts_; // offset in data_ of each block's first entry
+        size_t size_ = 0;
+
+        // Full text of a restart entry, which is readable in place
+        [[nodiscard]] std::string_view restart(size_t block) const noexcept
+        {
+            const uint8_t *p = data_.data() + restarts_[block];
+            (void)detail::getVarint(p); // shared, always 0
+            const uint32_t length = detail::getVarint(p);
+            return {reinterpret_cast<const char *>(p), length};
+        }
+
+    public:
+        // Walks entries in order, keeping the current one decoded
+        class Cursor
+        {
+            const FrontCodedStrings *strings_ = nullptr;
+            const uint8_t *pos_ = nullptr;
+            size_t index_ = 0;
+            std::string current_;
+
+            void decode()
+            {
+                const uint32_t shared = detail::getVarint(pos_);
+                const uint32_t length = detail::getVarint(pos_);
+                current_.resize(shared);
+                current_.append(reinterpret_cast<const char *>(pos_), length);
+                pos_ += length;
+            }
+
+        public:
+            explicit Cursor(const FrontCodedStrings &strings, size_t index = 0) : strings_(&strings) { seek(index); }
+
+            void seek(size_t index)
+            {
+                index_ = index;
+                if (index >= strings_->size_)
+                    return;
+                pos_ = strings_->data_.data() + strings_->restarts_[index / BLOCK];
+                for (size_t i = index - index % BLOCK; i <= index; ++i)
+                    decode();
+            }
+
+            [[nodiscard]] bool valid() const noexcept { return index_ < strings_->size_; }
+            [[nodiscard]] size_t index() const noexcept { return index_; }
+            [[nodiscard]] std::string_view value() const noexcept { return current_; }
+
+            void next()
+            {
+                if (++index_ < strings_->size_)
+                    decode();
+            }
+        };
+
+        FrontCodedStrings() = default;
+
+        // values must be sorted (byte order, as std::string compares)
+        template <typename Range>
+        explicit FrontCodedStrings(const Range &values)
+        {
+            std::string_view previous;
+            for (const auto &item : values)
+            {
+                const std::string_view value(item);
+                size_t shared = 0;
+                if (size_ % BLOCK == 0)
+                    restarts_.push_back(static_cast<uint32_t>(data_.size()));
+                else
+                {
+                    const size_t limit = std::min(previous.size(), value.size());
+                    while (shared < limit && previous[shared] == value[shared])
+                        ++shared;
+                }
+                detail::putVarint(data_, static_cast<uint32_t>(shared));
+                detail::putVarint(data_, static_cast<uint32_t>(value.size() - shared));
+                data_.insert(data_.end(), value.begin() + static_cast<ptrdiff_t>(shared), value.end());
+                previous = value;
+                ++size_;
+            }
+            data_.shrink_to_fit();
+            restarts_.shrink_to_fit();
+        }
+
+        [[nodiscard]] size_t size() const noexcept { return size_; }
+        [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+        // Heap bytes held, for comparing against plain strings
+        [[nodiscard]] size_t bytes() const noexcept
+        {
+            return data_.capacity() + restarts_.capacity() * sizeof(uint32_t);
+        }
+
+        [[nodiscard]] std::string at(size_t index) const
+        {
+            return index < size_ ? std::string(Cursor(*this, index).value()) : std::string();
+        }
+
+        // Index of the first entry not less than key, size() if there is none
+        [[nodiscard]] size_t lowerBound(std::string_view key) const
+        {
+            // Last block whose restart is below key; the answer is in it or starts the next one
+            size_t lo = 0, hi = restarts_.size();
+            while (lo < hi)
+            {
+                const size_t mid = (lo + hi) / 2;
+                if (restart(mid) < key)
+                    lo = mid + 1;
+                else
+                    hi = mid;
+            }
+            if (lo == 0)
+                return 0;
+
+            Cursor cursor(*this, (lo - 1) * BLOCK);
+            for (size_t end = std::min(lo * BLOCK, size_); cursor.index() < end; cursor.next())
+                if (cursor.value() >= key)
+                    break;
+            return cursor.index();
+        }
+
+        // Index of key, size() if it is not stored
+        [[nodiscard]] size_t find(std::string_view key) const
+        {
+            const size_t index = lowerBound(key);
+            return index < size_ && Cursor(*this, index).value() == key ? index : size_;
+        }
+
+        // [first, last) indices of the entries starting with prefix, from two lower bounds;
+        // nothing is decoded past the two blocks they land in
+        [[nodiscard]] std::pair<size_t, size_t> prefixRange(std::string_view prefix) const
+        {
+            const size_t first = lowerBound(prefix);
+            // Smallest string above every string with the prefix: drop trailing 0xFF bytes and
+            // increment the last one left
+            std::string upper(prefix);
+            while (!upper.empty() && static_cast<uint8_t>(upper.back()) == 0xFF)
+                upper.pop_back();
+            if (upper.empty())
+                return {first, size_};
+            upper.back() = static_cast<char>(static_cast<uint8_t>(upper.back()) + 1);
+            return {first, lowerBound(upper)};
+        }
+
+        // Calls fn(index, value) for each entry starting with prefix, in order, without
+        // materializing the others
+        template <typename Fn>
+        void forEachPrefixed(std::string_view prefix, Fn &&fn) const
+        {
+            for (Cursor cursor(*this, lowerBound(prefix)); cursor.valid(); cursor.next())
+            {
+                if (cursor.value().substr(0, prefix.size()) != prefix)
+                    break;
+                fn(cursor.index(), cursor.value());
+            }
+        }
+    };
+} // namespace UTIL
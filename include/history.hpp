@@ -0,0 +1,291 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "catalog.hpp"
+#include "frontcode.hpp"
+#include "jsonindex.hpp"
+
+namespace UTIL
+{
+    inline constexpr std::string_view HISTORY_PATH = "sdmc:/config/AmiiboGenerator/history.bin";
+    inline constexpr size_t HISTORY_DEPTH = 8; // snapshots kept, oldest dropped first
+
+    // head + tail as one number, so ids sort and compare as integers
+    [[nodiscard]] inline std::optional<uint64_t> packAmiiboId(std::string_view head, std::string_view tail) noexcept
+    {
+        if (head.size() != 8 || tail.size() != 8)
+            return std::nullopt;
+        uint64_t id = 0;
+        for (const std::string_view part : {head, tail})
+        {
+            for (const char c : part)
+            {
+                const int digit = detail::hexDigit(c);
+                if (digit < 0)
+                    return std::nullopt;
+                id = id << 4 | static_cast<unsigned>(digit);
+            }
+        }
+        return id;
+    }
+
+    [[nodiscard]] inline std::optional<uint64_t> packAmiiboId(const AmiiboRecord &record) noexcept
+    {
+        return packAmiiboId(record.head, record.tail);
+    }
+
+    // FNV-1a over every bound field, keyed by name so moving a value between fields counts
+    [[nodiscard]] inline uint32_t recordHash(const AmiiboRecord &record) noexcept
+    {
+        uint64_t state = 14695981039346656037ULL;
+        const auto mix = [&state](std::string_view text)
+        {
+            for (const char c : text)
+            {
+                state ^= static_cast<uint8_t>(c);
+                state *= 1099511628211ULL;
+            }
+            state ^= 0xFF; // terminator, never a UTF-8 byte
+            state *= 1099511628211ULL;
+        };
+        for (const auto &field : AMIIBO_FIELDS)
+        {
+            if (!field.slot)
+                continue;
+            mix(field.key);
+            mix(record.*field.slot);
+        }
+        return static_cast<uint32_t>(state ^ state >> 32);
+    }
+
+    // The catalog at one point in time: packed ids in ascending order, each with the hash
+    // of its record. Records without a valid id are left out.
+    struct CatalogSnapshot
+    {
+        struct Entry
+        {
+            uint64_t id;
+            uint32_t hash;
+        };
+
+        int64_t takenAt = 0; // unix seconds
+        std::vector<Entry> entries;
+
+        [[nodiscard]] bool sameContents(const CatalogSnapshot &other) const noexcept
+        {
+            return std::equal(entries.begin(), entries.end(), other.entries.begin(), other.entries.end(),
+                              [](const Entry &a, const Entry &b) { return a.id == b.id && a.hash == b.hash; });
+        }
+    };
+
+    template <typename Range>
+    [[nodiscard]] CatalogSnapshot makeSnapshot(const Range &records, int64_t takenAt = static_cast<int64_t>(std::time(nullptr)))
+    {
+        CatalogSnapshot snapshot;
+        snapshot.takenAt = takenAt;
+        for (const AmiiboRecord &record : records)
+            if (const auto id = packAmiiboId(record))
+                snapshot.entries.push_back({*id, recordHash(record)});
+
+        // The database repeats a few ids; keep the lowest hash so the result is order-independent
+        std::sort(snapshot.entries.begin(), snapshot.entries.end(),
+                  [](const auto &a, const auto &b) { return a.id != b.id ? a.id < b.id : a.hash < b.hash; });
+        snapshot.entries.erase(std::unique(snapshot.entries.begin(), snapshot.entries.end(),
+                                           [](const auto &a, const auto &b) { return a.id == b.id; }),
+                               snapshot.entries.end());
+        return snapshot;
+    }
+
+    // Packed ids that differ between two snapshots, each list ascending
+    struct CatalogDiff
+    {
+        std::vector<uint64_t> added;
+        std::vector<uint64_t> removed;
+        std::vector<uint64_t> changed;
+    };
+
+    // One merge pass over both sorted id lists
+    [[nodiscard]] inline CatalogDiff diffSnapshots(const CatalogSnapshot &from, const CatalogSnapshot &to)
+    {
+        CatalogDiff diff;
+        auto a = from.entries.begin(), b = to.entries.begin();
+        const auto aEnd = from.entries.end(), bEnd = to.entries.end();
+        while (a != aEnd && b != bEnd)
+        {
+            if (a->id < b->id)
+                diff.removed.push_back((a++)->id);
+            else if (b->id < a->id)
+                diff.added.push_back((b++)->id);
+            else
+            {
+                if (a->hash != b->hash)
+                    diff.changed.push_back(b->id);
+                ++a;
+                ++b;
+            }
+        }
+        for (; a != aEnd; ++a)
+            diff.removed.push_back(a->id);
+        for (; b != bEnd; ++b)
+            diff.added.push_back(b->id);
+        return diff;
+    }
+
+    namespace detail
+    {
+        inline constexpr char HISTORY_MAGIC[4] = {'A', 'G', 'H', 'S'};
+        inline constexpr uint8_t HISTORY_VERSION = 1;
+
+        // Bounds-checked reads; once a read runs past the end every later one fails too
+        struct ByteReader
+        {
+            const uint8_t *pos;
+            const uint8_t *end;
+            bool ok = true;
+
+            [[nodiscard]] uint64_t varint() noexcept
+            {
+                uint64_t value = 0;
+                for (int shift = 0; ok && shift < 64; shift += 7)
+                {
+                    if (pos == end)
+                        break;
+                    const uint8_t byte = *pos++;
+                    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                    if (byte < 0x80)
+                        return value;
+                }
+                ok = false;
+                return 0;
+            }
+
+            [[nodiscard]] uint32_t u32() noexcept
+            {
+                if (!ok || end - pos < 4)
+                {
+                    ok = false;
+                    return 0;
+                }
+                const uint32_t value = pos[0] | pos[1] << 8 | pos[2] << 16 | static_cast<uint32_t>(pos[3]) << 24;
+                pos += 4;
+                return value;
+            }
+        };
+    } // namespace detail
+
+    // Layout: magic, version, snapshot count, then per snapshot its time, entry count, the
+    // ids as ascending deltas (varints, mostly one or two bytes) and the hashes as 32-bit LE.
+    [[nodiscard]] inline std::vector<uint8_t> encodeHistory(const std::vector<CatalogSnapshot> &history)
+    {
+        std::vector<uint8_t> out(std::begin(detail::HISTORY_MAGIC), std::end(detail::HISTORY_MAGIC));
+        out.push_back(detail::HISTORY_VERSION);
+        detail::putVarint(out, static_cast<uint64_t>(history.size()));
+        for (const auto &snapshot : history)
+        {
+            detail::putVarint(out, static_cast<uint64_t>(snapshot.takenAt));
+            detail::putVarint(out, static_cast<uint64_t>(snapshot.entries.size()));
+            uint64_t previous = 0;
+            for (const auto &entry : snapshot.entries)
+            {
+                detail::putVarint(out, entry.id - previous);
+                previous = entry.id;
+            }
+            for (const auto &entry : snapshot.entries)
+                for (int shift = 0; shift < 32; shift += 8)
+                    out.push_back(static_cast<uint8_t>(entry.hash >> shift));
+        }
+        return out;
+    }
+
+    // False (and history empty) if the data is truncated, from another version or out of order
+    [[nodiscard]] inline bool decodeHistory(const std::vector<uint8_t> &data, std::vector<CatalogSnapshot> &history)
+    {
+        history.clear();
+        constexpr size_t HEADER = sizeof(detail::HISTORY_MAGIC) + 1;
+        if (data.size() < HEADER || !std::equal(std::begin(detail::HISTORY_MAGIC), std::end(detail::HISTORY_MAGIC), data.begin()) ||
+            data[HEADER - 1] != detail::HISTORY_VERSION)
+            return false;
+
+        detail::ByteReader in{data.data() + HEADER, data.data() + data.size()};
+        const uint64_t count = in.varint();
+        for (uint64_t s = 0; in.ok && s < count; ++s)
+        {
+            auto &snapshot = history.emplace_back();
+            snapshot.takenAt = static_cast<int64_t>(in.varint());
+            const uint64_t size = in.varint();
+            // Every entry takes at least five bytes, which bounds the allocation below
+            if (size > static_cast<uint64_t>(in.end - in.pos) / 5)
+                in.ok = false;
+            if (!in.ok)
+                break;
+            snapshot.entries.resize(size);
+            uint64_t id = 0;
+            for (size_t i = 0; in.ok && i < size; ++i)
+            {
+                const uint64_t delta = in.varint();
+                if (i > 0 && delta == 0)
+                    in.ok = false;
+                id += delta;
+                snapshot.entries[i].id = id;
+            }
+            for (auto &entry : snapshot.entries)
+                entry.hash = in.u32();
+        }
+        if (!in.ok || history.size() != count || in.pos != in.end)
+        {
+            history.clear();
+            return false;
+        }
+        return true;
+    }
+
+    [[nodiscard]] inline bool loadHistory(std::string_view path, std::vector<CatalogSnapshot> &history)
+    {
+        history.clear();
+        std::ifstream file{std::string(path), std::ios::binary};
+        if (!file)
+            return false;
+        const std::vector<uint8_t> data{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+        return decodeHistory(data, history);
+    }
+
+    // Written to a temporary file first, so an interrupted save leaves the old history intact
+    [[nodiscard]] inline bool saveHistory(std::string_view path, const std::vector<CatalogSnapshot> &history)
+    {
+        const std::filesystem::path target{std::string(path)};
+        std::error_code ec;
+        std::filesystem::create_directories(target.parent_path(), ec);
+
+        const std::vector<uint8_t> data = encodeHistory(history);
+        const std::filesystem::path temp = target.string() + ".tmp";
+        {
+            std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+            if (!file.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size())))
+                return false;
+        }
+        std::filesystem::rename(temp, target, ec);
+        return !ec;
+    }
+
+    // Appends snapshot unless it matches the newest one, keeping at most HISTORY_DEPTH.
+    // True if it was appended.
+    inline bool pushSnapshot(std::vector<CatalogSnapshot> &history, CatalogSnapshot snapshot)
+    {
+        if (!history.empty() && history.back().sameContents(snapshot))
+            return false;
+        history.push_back(std::move(snapshot));
+        if (history.size() > HISTORY_DEPTH)
+            history.erase(history.begin(), history.end() - static_cast<ptrdiff_t>(HISTORY_DEPTH));
+        return true;
+    }
+} // namespace UTIL
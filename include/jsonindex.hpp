@@ -0,0 +1,734 @@
+#pragma once
+
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "libs/json.hpp"
+#include "textnorm.hpp"
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define AMIIBO_JSONINDEX_NEON 1
+#elif defined(__AVX2__)
+#include <immintrin.h>
+#define AMIIBO_JSONINDEX_AVX2 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define AMIIBO_JSONINDEX_SSE2 1
+#endif
+
+namespace UTIL
+{
+    // Two-pass JSON parser for the amiibo database. The first pass classifies 64 bytes at
+    // a time into bitmasks and records where every structural character, string quote and
+    // scalar starts; the second pass walks that index and builds the same nlohmann::json
+    // tree nlohmann::json::parse() would, without looking at the bytes in between.
+    namespace detail
+    {
+        inline constexpr size_t JSON_BLOCK = 64;
+
+        struct JsonBlockMasks
+        {
+            uint64_t quote = 0;
+            uint64_t backslash = 0;
+            uint64_t structural = 0; // { } [ ] : ,
+            uint64_t whitespace = 0;
+            uint64_t control = 0; // bytes below 0x20, not allowed inside strings
+        };
+
+#if defined(AMIIBO_JSONINDEX_NEON)
+        [[nodiscard]] inline uint64_t jsonBitmask(uint8x16_t m0, uint8x16_t m1, uint8x16_t m2, uint8x16_t m3) noexcept
+        {
+            // NEON has no movemask: weight each lane by its bit and add neighbours pairwise
+            const uint8x16_t bits = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+            uint8x16_t sum0 = vpaddq_u8(vandq_u8(m0, bits), vandq_u8(m1, bits));
+            const uint8x16_t sum1 = vpaddq_u8(vandq_u8(m2, bits), vandq_u8(m3, bits));
+            sum0 = vpaddq_u8(sum0, sum1);
+            sum0 = vpaddq_u8(sum0, sum0);
+            return vgetq_lane_u64(vreinterpretq_u64_u8(sum0), 0);
+        }
+
+        [[nodiscard]] inline JsonBlockMasks classifyJsonBlock(const uint8_t *block) noexcept
+        {
+            const uint8x16_t v[4] = {vld1q_u8(block), vld1q_u8(block + 16), vld1q_u8(block + 32), vld1q_u8(block + 48)};
+            const auto eq = [&v](uint8_t c)
+            {
+                const uint8x16_t b = vdupq_n_u8(c);
+                return jsonBitmask(vceqq_u8(v[0], b), vceqq_u8(v[1], b), vceqq_u8(v[2], b), vceqq_u8(v[3], b));
+            };
+            uint8x16_t structural[4], whitespace[4], control[4];
+            for (int i = 0; i < 4; ++i)
+            {
+                // Clearing bit 5 folds '{' '}' onto '[' ']'
+                const uint8x16_t bracket = vandq_u8(v[i], vdupq_n_u8(0xDF));
+                structural[i] = vorrq_u8(vorrq_u8(vceqq_u8(bracket, vdupq_n_u8('[')), vceqq_u8(bracket, vdupq_n_u8(']'))),
+                                         vorrq_u8(vceqq_u8(v[i], vdupq_n_u8(':')), vceqq_u8(v[i], vdupq_n_u8(','))));
+                whitespace[i] = vorrq_u8(vorrq_u8(vceqq_u8(v[i], vdupq_n_u8(' ')), vceqq_u8(v[i], vdupq_n_u8('\t'))),
+                                         vorrq_u8(vceqq_u8(v[i], vdupq_n_u8('\n')), vceqq_u8(v[i], vdupq_n_u8('\r'))));
+                control[i] = vcltq_u8(v[i], vdupq_n_u8(0x20));
+            }
+            JsonBlockMasks m;
+            m.quote = eq('"');
+            m.backslash = eq('\\');
+            m.structural = jsonBitmask(structural[0], structural[1], structural[2], structural[3]);
+            m.whitespace = jsonBitmask(whitespace[0], whitespace[1], whitespace[2], whitespace[3]);
+            m.control = jsonBitmask(control[0], control[1], control[2], control[3]);
+            return m;
+        }
+#elif defined(AMIIBO_JSONINDEX_AVX2)
+        [[nodiscard]] inline uint64_t jsonBitmask(__m256i lo, __m256i hi) noexcept
+        {
+            return static_cast<uint32_t>(_mm256_movemask_epi8(lo)) |
+                   static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(hi))) << 32;
+        }
+
+        [[nodiscard]] inline JsonBlockMasks classifyJsonBlock(const uint8_t *block) noexcept
+        {
+            const __m256i v[2] = {_mm256_loadu_si256(reinterpret_cast<const __m256i *>(block)),
+                                  _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + 32))};
+            const auto eq = [](__m256i x, char c)
+            { return _mm256_cmpeq_epi8(x, _mm256_set1_epi8(c)); };
+            __m256i quote[2], backslash[2], structural[2], whitespace[2], control[2];
+            for (int i = 0; i < 2; ++i)
+            {
+                // Clearing bit 5 folds '{' '}' onto '[' ']'
+                const __m256i bracket = _mm256_and_si256(v[i], _mm256_set1_epi8(static_cast<char>(0xDF)));
+                quote[i] = eq(v[i], '"');
+                backslash[i] = eq(v[i], '\\');
+                structural[i] = _mm256_or_si256(_mm256_or_si256(eq(bracket, '['), eq(bracket, ']')),
+                                                _mm256_or_si256(eq(v[i], ':'), eq(v[i], ',')));
+                whitespace[i] = _mm256_or_si256(_mm256_or_si256(eq(v[i], ' '), eq(v[i], '\t')),
+                                                _mm256_or_si256(eq(v[i], '\n'), eq(v[i], '\r')));
+                control[i] = eq(_mm256_max_epu8(v[i], _mm256_set1_epi8(0x1F)), 0x1F);
+            }
+            return {jsonBitmask(quote[0], quote[1]), jsonBitmask(backslash[0], backslash[1]),
+                    jsonBitmask(structural[0], structural[1]), jsonBitmask(whitespace[0], whitespace[1]),
+                    jsonBitmask(control[0], control[1])};
+        }
+#elif defined(AMIIBO_JSONINDEX_SSE2)
+        [[nodiscard]] inline JsonBlockMasks classifyJsonBlock(const uint8_t *block) noexcept
+        {
+            const auto eq = [](__m128i x, char c)
+            { return _mm_cmpeq_epi8(x, _mm_set1_epi8(c)); };
+            JsonBlockMasks m;
+            for (int i = 0; i < 4; ++i)
+            {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + i * 16));
+                // Clearing bit 5 folds '{' '}' onto '[' ']'
+                const __m128i bracket = _mm_and_si128(v, _mm_set1_epi8(static_cast<char>(0xDF)));
+                const __m128i structural = _mm_or_si128(_mm_or_si128(eq(bracket, '['), eq(bracket, ']')),
+                                                        _mm_or_si128(eq(v, ':'), eq(v, ',')));
+                const __m128i whitespace = _mm_or_si128(_mm_or_si128(eq(v, ' '), eq(v, '\t')),
+                                                        _mm_or_si128(eq(v, '\n'), eq(v, '\r')));
+                const __m128i control = eq(_mm_max_epu8(v, _mm_set1_epi8(0x1F)), 0x1F);
+                const int shift = i * 16;
+                m.quote |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(eq(v, '"')))) << shift;
+                m.backslash |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(eq(v, '\\')))) << shift;
+                m.structural |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(structural))) << shift;
+                m.whitespace |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(whitespace))) << shift;
+                m.control |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(control))) << shift;
+            }
+            return m;
+        }
+#else
+        [[nodiscard]] inline JsonBlockMasks classifyJsonBlock(const uint8_t *block) noexcept
+        {
+            JsonBlockMasks m;
+            for (size_t i = 0; i < JSON_BLOCK; ++i)
+            {
+                const uint8_t c = block[i];
+                const uint64_t bit = 1ULL << i;
+                if (c == '"')
+                    m.quote |= bit;
+                else if (c == '\\')
+                    m.backslash |= bit;
+                else if (c == '{' || c == '}' || c == '[' || c == ']' || c == ':' || c == ',')
+                    m.structural |= bit;
+                if (c == ' ' || c == '\t' || c == '\n' || c == '\r')
+                    m.whitespace |= bit;
+                if (c < 0x20)
+                    m.control |= bit;
+            }
+            return m;
+        }
+#endif
+
+        // Bit i of the result is the XOR of bits 0..i, which turns quote positions into
+        // "inside a string" ranges
+        [[nodiscard]] inline uint64_t prefixXor(uint64_t x) noexcept
+        {
+#if defined(AMIIBO_JSONINDEX_NEON) && (defined(__ARM_FEATURE_AES) || defined(__ARM_FEATURE_CRYPTO))
+            return vgetq_lane_u64(vreinterpretq_u64_p128(vmull_p64(x, ~0ULL)), 0);
+#else
+            x ^= x << 1;
+            x ^= x << 2;
+            x ^= x << 4;
+            x ^= x << 8;
+            x ^= x << 16;
+            x ^= x << 32;
+            return x;
+#endif
+        }
+
+        // Characters escaped by a backslash; runs of backslashes escape each other in pairs.
+        // carry says whether the first byte of the next block is escaped.
+        [[nodiscard]] inline uint64_t escapedChars(uint64_t backslash, uint64_t &carry) noexcept
+        {
+            constexpr uint64_t EVEN_BITS = 0x5555555555555555ULL;
+            backslash &= ~carry;
+            const uint64_t followsEscape = backslash << 1 | carry;
+            const uint64_t oddStarts = backslash & ~EVEN_BITS & ~followsEscape;
+            uint64_t evenStarts = 0;
+            carry = __builtin_add_overflow(oddStarts, backslash, &evenStarts) ? 1 : 0;
+            return (EVEN_BITS ^ evenStarts << 1) & followsEscape;
+        }
+
+        // First pass: positions of structural characters outside strings, of both quotes of
+        // every string, and of the first byte of every number/literal. False on an
+        // unterminated string or a control character inside one.
+        [[nodiscard]] inline bool buildJsonIndex(std::string_view text, std::vector<uint32_t> &index)
+        {
+            index.clear();
+            index.reserve(text.size() / 8 + 16);
+
+            uint64_t escapeCarry = 0;
+            uint64_t inStringCarry = 0; // all ones while a string spans blocks
+            uint64_t scalarCarry = 0;   // block ended inside a scalar
+            uint8_t tail[JSON_BLOCK];
+
+            for (size_t base = 0; base < text.size(); base += JSON_BLOCK)
+            {
+                const auto *block = reinterpret_cast<const uint8_t *>(text.data()) + base;
+                if (text.size() - base < JSON_BLOCK)
+                {
+                    // Pad the last block with spaces, which never start or end anything
+                    std::memset(tail, ' ', sizeof(tail));
+                    std::memcpy(tail, block, text.size() - base);
+                    block = tail;
+                }
+
+                const JsonBlockMasks m = classifyJsonBlock(block);
+                const uint64_t quote = m.quote & ~escapedChars(m.backslash, escapeCarry);
+                const uint64_t inString = prefixXor(quote) ^ inStringCarry; // opening quote up to the closing one
+                inStringCarry = static_cast<uint64_t>(static_cast<int64_t>(inString) >> 63);
+
+                if (m.control & inString)
+                    return false;
+
+                const uint64_t outside = ~(inString | quote);
+                const uint64_t scalar = outside & ~m.structural & ~m.whitespace;
+                const uint64_t scalarStarts = scalar & ~(scalar << 1 | scalarCarry);
+                scalarCarry = scalar >> 63;
+
+                uint64_t bits = (m.structural & outside) | quote | scalarStarts;
+                const size_t first = index.size();
+                index.resize(first + static_cast<size_t>(__builtin_popcountll(bits)));
+                uint32_t *out = index.data() + first;
+                while (bits)
+                {
+                    *out++ = static_cast<uint32_t>(base) + static_cast<uint32_t>(__builtin_ctzll(bits));
+                    bits &= bits - 1;
+                }
+            }
+            return inStringCarry == 0;
+        }
+
+        [[nodiscard]] inline int hexDigit(char c) noexcept
+        {
+            if (c >= '0' && c <= '9')
+                return c - '0';
+            if (c >= 'a' && c <= 'f')
+                return c - 'a' + 10;
+            if (c >= 'A' && c <= 'F')
+                return c - 'A' + 10;
+            return -1;
+        }
+
+        [[nodiscard]] inline bool readHex4(std::string_view s, size_t at, unsigned &out) noexcept
+        {
+            if (at + 4 > s.size())
+                return false;
+            out = 0;
+            for (size_t i = at; i < at + 4; ++i)
+            {
+                const int d = hexDigit(s[i]);
+                if (d < 0)
+                    return false;
+                out = out << 4 | static_cast<unsigned>(d);
+            }
+            return true;
+        }
+
+        [[nodiscard]] inline size_t encodeUtf8(unsigned cp, char *out) noexcept
+        {
+            if (cp < 0x80)
+            {
+                out[0] = static_cast<char>(cp);
+                return 1;
+            }
+            if (cp < 0x800)
+            {
+                out[0] = static_cast<char>(0xC0 | cp >> 6);
+                out[1] = static_cast<char>(0x80 | (cp & 0x3F));
+                return 2;
+            }
+            if (cp < 0x10000)
+            {
+                out[0] = static_cast<char>(0xE0 | cp >> 12);
+                out[1] = static_cast<char>(0x80 | (cp >> 6 & 0x3F));
+                out[2] = static_cast<char>(0x80 | (cp & 0x3F));
+                return 3;
+            }
+            out[0] = static_cast<char>(0xF0 | cp >> 18);
+            out[1] = static_cast<char>(0x80 | (cp >> 12 & 0x3F));
+            out[2] = static_cast<char>(0x80 | (cp >> 6 & 0x3F));
+            out[3] = static_cast<char>(0x80 | (cp & 0x3F));
+            return 4;
+        }
+
+        // Resolves the escapes of a string body, handing the result to append(const char *, size_t)
+        // piece by piece; the first pass already checked for control characters
+        template <typename Append>
+        [[nodiscard]] bool unescapeJsonString(std::string_view raw, Append &&append)
+        {
+            size_t i = 0;
+            for (size_t next = raw.find('\\'); next != std::string_view::npos; next = raw.find('\\', i))
+            {
+                append(raw.data() + i, next - i);
+                if (next + 1 >= raw.size())
+                    return false;
+                i = next + 2;
+                char c = raw[next + 1];
+                switch (c)
+                {
+                case '"':
+                case '\\':
+                case '/':
+                    break;
+                case 'b':
+                    c = '\b';
+                    break;
+                case 'f':
+                    c = '\f';
+                    break;
+                case 'n':
+                    c = '\n';
+                    break;
+                case 'r':
+                    c = '\r';
+                    break;
+                case 't':
+                    c = '\t';
+                    break;
+                case 'u':
+                {
+                    unsigned cp = 0;
+                    if (!readHex4(raw, i, cp))
+                        return false;
+                    i += 4;
+                    if (cp >= 0xDC00 && cp <= 0xDFFF)
+                        return false; // lone low surrogate
+                    if (cp >= 0xD800 && cp <= 0xDBFF)
+                    {
+                        unsigned low = 0;
+                        if (i + 2 > raw.size() || raw[i] != '\\' || raw[i + 1] != 'u' || !readHex4(raw, i + 2, low) ||
+                            low < 0xDC00 || low > 0xDFFF)
+                            return false;
+                        i += 6;
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    char utf8[4];
+                    append(utf8, encodeUtf8(cp, utf8));
+                    continue;
+                }
+                default:
+                    return false;
+                }
+                append(&c, 1);
+            }
+            append(raw.data() + i, raw.size() - i);
+            return true;
+        }
+
+        [[nodiscard]] inline bool decodeJsonString(std::string_view raw, std::string &out)
+        {
+            if (raw.find('\\') == std::string_view::npos)
+            {
+                out.assign(raw.data(), raw.size());
+                return true;
+            }
+            out.clear();
+            out.reserve(raw.size());
+            return unescapeJsonString(raw, [&out](const char *data, size_t size)
+                                      { out.append(data, size); });
+        }
+
+        // Checks the escapes without producing the string
+        [[nodiscard]] inline bool validJsonString(std::string_view raw)
+        {
+            return unescapeJsonString(raw, [](const char *, size_t) {});
+        }
+
+        // Number or literal. Integers become unsigned/signed/float exactly as nlohmann's
+        // lexer types them, so dump() and comparisons match.
+        [[nodiscard]] inline bool parseJsonScalar(std::string_view token, nlohmann::json &out)
+        {
+            if (token == "true" || token == "false")
+            {
+                out = token[0] == 't';
+                return true;
+            }
+            if (token == "null")
+            {
+                out = nullptr;
+                return true;
+            }
+
+            // -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+            size_t i = 0;
+            const auto digits = [&token, &i]
+            {
+                const size_t start = i;
+                while (i < token.size() && token[i] >= '0' && token[i] <= '9')
+                    ++i;
+                return i - start;
+            };
+            const bool negative = i < token.size() && token[i] == '-';
+            if (negative)
+                ++i;
+            const size_t intStart = i;
+            const size_t intDigits = digits();
+            if (intDigits == 0 || (intDigits > 1 && token[intStart] == '0'))
+                return false;
+            bool integer = true;
+            if (i < token.size() && token[i] == '.')
+            {
+                ++i;
+                if (digits() == 0)
+                    return false;
+                integer = false;
+            }
+            if (i < token.size() && (token[i] == 'e' || token[i] == 'E'))
+            {
+                ++i;
+                if (i < token.size() && (token[i] == '+' || token[i] == '-'))
+                    ++i;
+                if (digits() == 0)
+                    return false;
+                integer = false;
+            }
+            if (i != token.size())
+                return false;
+
+            char small[64];
+            std::string large;
+            const char *str = small;
+            if (token.size() < sizeof(small))
+            {
+                std::memcpy(small, token.data(), token.size());
+                small[token.size()] = '\0';
+            }
+            else
+            {
+                large.assign(token);
+                str = large.c_str();
+            }
+
+            if (integer)
+            {
+                errno = 0;
+                char *end = nullptr;
+                if (negative)
+                {
+                    const long long value = std::strtoll(str, &end, 10);
+                    if (errno == 0)
+                    {
+                        out = static_cast<nlohmann::json::number_integer_t>(value);
+                        return true;
+                    }
+                }
+                else
+                {
+                    const unsigned long long value = std::strtoull(str, &end, 10);
+                    if (errno == 0)
+                    {
+                        out = static_cast<nlohmann::json::number_unsigned_t>(value);
+                        return true;
+                    }
+                }
+                // Out of range: nlohmann falls back to a float as well
+            }
+            const double value = std::strtod(str, nullptr);
+            if (!std::isfinite(value))
+                return false; // nlohmann rejects overflow to infinity
+            out = static_cast<nlohmann::json::number_float_t>(value);
+            return true;
+        }
+
+        // Scalars run up to the next indexed position, minus trailing whitespace
+        [[nodiscard]] inline std::string_view jsonScalarToken(std::string_view text, const std::vector<uint32_t> &index, size_t at) noexcept
+        {
+            const size_t start = index[at];
+            size_t end = at + 1 < index.size() ? index[at + 1] : text.size();
+            while (end > start && (text[end - 1] == ' ' || text[end - 1] == '\t' || text[end - 1] == '\n' || text[end - 1] == '\r'))
+                --end;
+            return text.substr(start, end - start);
+        }
+
+        // Second pass over the index. Iterative, so deep nesting cannot overflow the stack.
+        [[nodiscard]] inline bool buildJsonTree(std::string_view text, const std::vector<uint32_t> &index, nlohmann::json &root)
+        {
+            enum class Next
+            {
+                Value,
+                Key,
+                AfterValue,
+            };
+
+            const size_t count = index.size();
+            std::vector<nlohmann::json *> stack;
+            nlohmann::json *target = &root;
+            std::string key;
+            Next next = Next::Value;
+            size_t i = 0;
+
+            // Both quotes are indexed and nothing in between is
+            const auto stringBody = [&](size_t at)
+            { return text.substr(index[at] + 1, index[at + 1] - index[at] - 1); };
+
+            for (;;)
+            {
+                switch (next)
+                {
+                case Next::Value:
+                {
+                    if (i >= count)
+                        return false;
+                    const char c = text[index[i]];
+                    if (c == '{' || c == '[')
+                    {
+                        const bool object = c == '{';
+                        *target = object ? nlohmann::json::object() : nlohmann::json::array();
+                        ++i;
+                        if (i < count && text[index[i]] == (object ? '}' : ']'))
+                        {
+                            ++i;
+                            next = Next::AfterValue;
+                            break;
+                        }
+                        stack.push_back(target);
+                        if (object)
+                            next = Next::Key;
+                        else
+                            target = &target->emplace_back();
+                        break;
+                    }
+                    if (c == '"')
+                    {
+                        if (i + 1 >= count)
+                            return false;
+                        std::string value;
+                        if (!decodeJsonString(stringBody(i), value))
+                            return false;
+                        *target = std::move(value);
+                        i += 2;
+                    }
+                    else
+                    {
+                        if (c == '}' || c == ']' || c == ':' || c == ',' || !parseJsonScalar(jsonScalarToken(text, index, i), *target))
+                            return false;
+                        ++i;
+                    }
+                    next = Next::AfterValue;
+                    break;
+                }
+
+                case Next::Key:
+                    if (i + 2 >= count || text[index[i]] != '"' || text[index[i + 2]] != ':' ||
+                        !decodeJsonString(stringBody(i), key))
+                        return false;
+                    i += 3;
+                    target = &(*stack.back())[key]; // a repeated key keeps the last value, as in nlohmann
+                    next = Next::Value;
+                    break;
+
+                case Next::AfterValue:
+                {
+                    if (stack.empty())
+                        return i == count;
+                    if (i >= count)
+                        return false;
+                    nlohmann::json *parent = stack.back();
+                    const char c = text[index[i++]];
+                    if (c == ',')
+                    {
+                        if (parent->is_object())
+                            next = Next::Key;
+                        else
+                        {
+                            target = &parent->emplace_back();
+                            next = Next::Value;
+                        }
+                    }
+                    else if (c == (parent->is_object() ? '}' : ']'))
+                        stack.pop_back();
+                    else
+                        return false;
+                    break;
+                }
+                }
+            }
+        }
+    } // namespace detail
+
+    // First pass plus the checks it leaves out: drops a byte order mark from text (nlohmann
+    // skips one too) and rejects malformed UTF-8
+    [[nodiscard]] inline bool indexJson(std::string_view &text, std::vector<uint32_t> &index)
+    {
+        if (text.size() >= 3 && text.compare(0, 3, "\xEF\xBB\xBF") == 0)
+            text.remove_prefix(3);
+        return text.size() <= UINT32_MAX && validUtf8(text) && detail::buildJsonIndex(text, index);
+    }
+
+    // Structural-index parse. Returns a discarded value on malformed input, like
+    // nlohmann::json::parse(text, nullptr, false).
+    [[nodiscard]] inline nlohmann::json parseJsonIndexed(std::string_view text)
+    {
+        std::vector<uint32_t> index;
+        nlohmann::json root;
+        if (!indexJson(text, index) || !detail::buildJsonTree(text, index, root))
+            return nlohmann::json(nlohmann::json::value_t::discarded);
+        return root;
+    }
+
+    // Forward-only reader over an index from indexJson(), for code that picks values out of
+    // a document without building a tree
+    class JsonCursor
+    {
+        std::string_view text_;
+        const std::vector<uint32_t> &index_;
+        size_t i_ = 0;
+
+        [[nodiscard]] bool key()
+        {
+            std::string_view raw;
+            return string(raw) && detail::validJsonString(raw) && consume(':');
+        }
+
+    public:
+        static constexpr int MAX_SKIP_DEPTH = 256;
+
+        JsonCursor(std::string_view text, const std::vector<uint32_t> &index) : text_(text), index_(index) {}
+
+        // Next indexed character, '\0' past the end
+        [[nodiscard]] char peek() const noexcept { return i_ < index_.size() ? text_[index_[i_]] : '\0'; }
+        [[nodiscard]] bool atEnd() const noexcept { return i_ >= index_.size(); }
+
+        bool consume(char c) noexcept
+        {
+            if (peek() != c)
+                return false;
+            ++i_;
+            return true;
+        }
+
+        // Body of the next string with its escapes still in place
+        [[nodiscard]] bool string(std::string_view &raw) noexcept
+        {
+            if (peek() != '"')
+                return false;
+            raw = text_.substr(index_[i_] + 1, index_[i_ + 1] - index_[i_] - 1);
+            i_ += 2;
+            return true;
+        }
+
+        // Skips one value of any type, checking that it is well formed. Containers nested
+        // deeper than MAX_SKIP_DEPTH are rejected.
+        [[nodiscard]] bool skipValue()
+        {
+            char open[MAX_SKIP_DEPTH];
+            int depth = 0;
+            for (;;)
+            {
+                const char c = peek();
+                if (c == '{' || c == '[')
+                {
+                    ++i_;
+                    if (!consume(c == '{' ? '}' : ']'))
+                    {
+                        if (depth == MAX_SKIP_DEPTH || (c == '{' && !key()))
+                            return false;
+                        open[depth++] = c;
+                        continue;
+                    }
+                }
+                else if (c == '"')
+                {
+                    std::string_view raw;
+                    if (!string(raw) || !detail::validJsonString(raw))
+                        return false;
+                }
+                else
+                {
+                    if (c == '\0' || c == '}' || c == ']' || c == ':' || c == ',')
+                        return false;
+                    nlohmann::json scalar;
+                    if (!detail::parseJsonScalar(detail::jsonScalarToken(text_, index_, i_), scalar))
+                        return false;
+                    ++i_;
+                }
+
+                // Close finished containers until one continues with a comma
+                for (;;)
+                {
+                    if (depth == 0)
+                        return true;
+                    const bool object = open[depth - 1] == '{';
+                    if (consume(','))
+                    {
+                        if (object && !key())
+                            return false;
+                        break;
+                    }
+                    if (!consume(object ? '}' : ']'))
+                        return false;
+                    --depth;
+                }
+            }
+        }
+    };
+
+    // Parser used for the database; build with JSON_PARSER=nlohmann to use the stock one
+    [[nodiscard]] inline nlohmann::json parseJson(std::string_view text)
+    {
+#if defined(AMIIBO_JSON_NLOHMANN)
+        return nlohmann::json::parse(text.begin(), text.end(), nullptr, false);
+#else
+        return parseJsonIndexed(text);
+#endif
+    }
+
+    // Whole file into memory, false if it cannot be opened or read
+    [[nodiscard]] inline bool readTextFile(const std::string &path, std::string &out)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            return false;
+        file.seekg(0, std::ios::end);
+        const std::streamoff size = file.tellg();
+        if (size < 0)
+            return false;
+        file.seekg(0, std::ios::beg);
+        out.resize(static_cast<size_t>(size));
+        file.read(out.data(), size);
+        out.resize(static_cast<size_t>(file.gcount()));
+        return !file.bad();
+    }
+} // namespace UTIL
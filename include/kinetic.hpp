@@ -0,0 +1,102 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+namespace UI
+{
+    inline constexpr float SCROLL_FRICTION = 3.0f;      // velocity decay rate, 1/s
+    inline constexpr float SCROLL_STOP_VELOCITY = 1.5f; // rows/s below which a fling ends
+    inline constexpr float SCROLL_MAX_VELOCITY = 240.0f;
+    inline constexpr float TAP_SLOP = 12.0f; // pixels a tap may wander before it is a drag
+
+    // Drag-and-fling scroll position over a list of rows. Only the fractional top row is
+    // tracked, so the cost per frame does not depend on how long the list is.
+    class KineticScroller
+    {
+        float rowHeight_;
+        float position_ = 0.0f; // in rows
+        float velocity_ = 0.0f; // in rows/s, positive scrolls towards the end
+        float maxPosition_ = 0.0f;
+        float lastY_ = 0.0f;
+        float travel_ = 0.0f;
+        bool dragging_ = false;
+
+        // True when the position hit either end
+        bool moveBy(float rows) noexcept
+        {
+            const float next = position_ + rows;
+            position_ = std::clamp(next, 0.0f, maxPosition_);
+            return position_ != next;
+        }
+
+    public:
+        explicit KineticScroller(float rowHeight) : rowHeight_(rowHeight > 0.0f ? rowHeight : 1.0f) {}
+
+        void setRange(int totalRows, int visibleRows) noexcept
+        {
+            maxPosition_ = static_cast<float>(std::max(0, totalRows - visibleRows));
+            position_ = std::min(position_, maxPosition_);
+        }
+
+        // Finger down; stops any fling in progress
+        void press(float y) noexcept
+        {
+            dragging_ = true;
+            velocity_ = 0.0f;
+            lastY_ = y;
+            travel_ = 0.0f;
+        }
+
+        // Finger moved to y after dt seconds; the list follows the finger
+        void drag(float y, float dt) noexcept
+        {
+            if (!dragging_)
+                return;
+            const float rows = (lastY_ - y) / rowHeight_;
+            travel_ += std::fabs(y - lastY_);
+            lastY_ = y;
+            if (moveBy(rows))
+                velocity_ = 0.0f;
+            else if (dt > 0.0f)
+                velocity_ = 0.6f * velocity_ + 0.4f * (rows / dt); // smooth out jittery samples
+        }
+
+        // Finger up. Returns true for a tap, which does not fling.
+        bool release() noexcept
+        {
+            if (!dragging_)
+                return false;
+            dragging_ = false;
+            const bool tap = travel_ < TAP_SLOP;
+            velocity_ = tap ? 0.0f : std::clamp(velocity_, -SCROLL_MAX_VELOCITY, SCROLL_MAX_VELOCITY);
+            return tap;
+        }
+
+        // Advance a fling by dt seconds
+        void step(float dt) noexcept
+        {
+            if (dragging_ || velocity_ == 0.0f)
+                return;
+            if (std::fabs(velocity_) < SCROLL_STOP_VELOCITY || moveBy(velocity_ * dt))
+            {
+                velocity_ = 0.0f;
+                return;
+            }
+            velocity_ *= std::exp(-SCROLL_FRICTION * dt);
+        }
+
+        // Follow scrolling done some other way, e.g. with the D-pad
+        void jumpTo(int row) noexcept
+        {
+            velocity_ = 0.0f;
+            position_ = std::clamp(static_cast<float>(row), 0.0f, maxPosition_);
+        }
+
+        [[nodiscard]] int firstRow() const noexcept { return static_cast<int>(position_ + 0.5f); }
+        [[nodiscard]] float position() const noexcept { return position_; }
+        [[nodiscard]] float velocity() const noexcept { return velocity_; }
+        [[nodiscard]] bool dragging() const noexcept { return dragging_; }
+        [[nodiscard]] bool moving() const noexcept { return dragging_ || velocity_ != 0.0f; }
+    };
+} // namespace UI
@@ -0,0 +1,498 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "terminal.hpp"
+
+namespace UTIL
+{
+    enum class LogLevel : uint8_t
+    {
+        Debug,
+        Info,
+        Warning,
+        Error,
+        Off,
+    };
+
+    inline constexpr size_t LOG_RING_SIZE = 16 * 1024; // bytes per thread, power of two
+    inline constexpr size_t LOG_RECORD_MAX = 512;      // longer string arguments are truncated
+    inline constexpr auto LOG_FLUSH_INTERVAL = std::chrono::milliseconds(50);
+
+    namespace detail
+    {
+        enum class LogArg : uint8_t
+        {
+            Int,
+            UInt,
+            Double,
+            Pointer,
+            String,
+        };
+
+        // Record layout: header, then per argument a tag byte and its payload
+        struct LogHeader
+        {
+            const char *format;
+            uint64_t timeNs;
+            LogLevel level;
+            uint8_t argCount;
+        };
+
+        class LogEncoder
+        {
+            std::array<uint8_t, LOG_RECORD_MAX> bytes_;
+            size_t size_ = 0;
+
+            void put(const void *data, size_t size) noexcept
+            {
+                size = std::min(size, bytes_.size() - size_);
+                std::memcpy(bytes_.data() + size_, data, size);
+                size_ += size;
+            }
+
+            template <typename T>
+            void putValue(LogArg tag, T value) noexcept
+            {
+                if (size_ + 1 + sizeof(T) > bytes_.size())
+                    return;
+                put(&tag, 1);
+                put(&value, sizeof(T));
+            }
+
+            void putString(std::string_view text) noexcept
+            {
+                if (size_ + 3 > bytes_.size())
+                    return;
+                const auto length = static_cast<uint16_t>(std::min(text.size(), bytes_.size() - size_ - 3));
+                const LogArg tag = LogArg::String;
+                put(&tag, 1);
+                put(&length, sizeof(length));
+                put(text.data(), length);
+            }
+
+        public:
+            explicit LogEncoder(const LogHeader &header) noexcept { put(&header, sizeof(header)); }
+
+            template <typename T>
+            void add(const T &arg) noexcept
+            {
+                using U = std::decay_t<T>;
+                if constexpr (std::is_same_v<U, std::string> || std::is_same_v<U, std::string_view>)
+                    putString(arg);
+                else if constexpr (std::is_same_v<U, const char *> || std::is_same_v<U, char *>)
+                    putString(arg ? std::string_view(arg) : std::string_view("(null)"));
+                else if constexpr (std::is_floating_point_v<U>)
+                    putValue(LogArg::Double, static_cast<double>(arg));
+                else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>)
+                    putValue(LogArg::Int, static_cast<int64_t>(arg));
+                else if constexpr (std::is_integral_v<U> || std::is_enum_v<U>)
+                    putValue(LogArg::UInt, static_cast<uint64_t>(arg));
+                else
+                {
+                    static_assert(std::is_pointer_v<U>, "unsupported log argument type");
+                    putValue(LogArg::Pointer, reinterpret_cast<uintptr_t>(arg));
+                }
+            }
+
+            [[nodiscard]] const uint8_t *data() const noexcept { return bytes_.data(); }
+            [[nodiscard]] size_t size() const noexcept { return size_; }
+        };
+
+        // printf-style formatting of a decoded record, one conversion at a time
+        class LogFormatter
+        {
+            const uint8_t *cursor_;
+            const uint8_t *end_;
+
+            [[nodiscard]] bool next(LogArg &tag, const uint8_t *&payload) noexcept
+            {
+                if (cursor_ >= end_)
+                    return false;
+                tag = static_cast<LogArg>(*cursor_++);
+                payload = cursor_;
+                size_t size = 8;
+                if (tag == LogArg::String)
+                {
+                    uint16_t length = 0;
+                    std::memcpy(&length, cursor_, sizeof(length));
+                    size = sizeof(length) + length;
+                }
+                cursor_ += size;
+                return cursor_ <= end_;
+            }
+
+            template <typename T>
+            [[nodiscard]] static T read(const uint8_t *payload) noexcept
+            {
+                T value;
+                std::memcpy(&value, payload, sizeof(T));
+                return value;
+            }
+
+            [[nodiscard]] int64_t nextInt() noexcept
+            {
+                LogArg tag;
+                const uint8_t *payload = nullptr;
+                if (!next(tag, payload) || tag == LogArg::String)
+                    return 0;
+                return tag == LogArg::Double ? static_cast<int64_t>(read<double>(payload)) : read<int64_t>(payload);
+            }
+
+        public:
+            LogFormatter(const uint8_t *args, const uint8_t *end) noexcept : cursor_(args), end_(end) {}
+
+            void format(const char *fmt, std::string &out)
+            {
+                char spec[32], piece[LOG_RECORD_MAX + 64];
+                while (*fmt)
+                {
+                    if (*fmt != '%')
+                    {
+                        out += *fmt++;
+                        continue;
+                    }
+                    if (fmt[1] == '%')
+                    {
+                        out += '%';
+                        fmt += 2;
+                        continue;
+                    }
+
+                    // Copy flags, width and precision (resolving '*'), drop length modifiers
+                    size_t n = 0;
+                    spec[n++] = *fmt++;
+                    while (*fmt && !std::strchr("diouxXeEfFgGaAcsp", *fmt) && n < sizeof(spec) - 24)
+                    {
+                        if (*fmt == '*')
+                            n += static_cast<size_t>(std::snprintf(spec + n, sizeof(spec) - n, "%d", static_cast<int>(nextInt())));
+                        else if (!std::strchr("hlLqjzt", *fmt))
+                            spec[n++] = *fmt;
+                        ++fmt;
+                    }
+                    const char conv = *fmt;
+                    if (!conv)
+                        break;
+                    ++fmt;
+
+                    LogArg tag;
+                    const uint8_t *payload = nullptr;
+                    if (!next(tag, payload))
+                    {
+                        out += "(missing)";
+                        continue;
+                    }
+
+                    if (tag == LogArg::String)
+                    {
+                        uint16_t length = 0;
+                        std::memcpy(&length, payload, sizeof(length));
+                        const std::string text(reinterpret_cast<const char *>(payload + sizeof(length)), length);
+                        if (n == 1)
+                        {
+                            out += text;
+                            continue;
+                        }
+                        spec[n++] = 's';
+                        spec[n] = '\0';
+                        std::snprintf(piece, sizeof(piece), spec, text.c_str());
+                    }
+                    else if (std::strchr("eEfFgGaA", conv))
+                    {
+                        spec[n++] = conv;
+                        spec[n] = '\0';
+                        const double value = tag == LogArg::Double ? read<double>(payload) : static_cast<double>(read<int64_t>(payload));
+                        std::snprintf(piece, sizeof(piece), spec, value);
+                    }
+                    else if (conv == 'p')
+                    {
+                        spec[n++] = 'p';
+                        spec[n] = '\0';
+                        std::snprintf(piece, sizeof(piece), spec, reinterpret_cast<void *>(read<uintptr_t>(payload)));
+                    }
+                    else if (conv == 'c')
+                    {
+                        spec[n++] = 'c';
+                        spec[n] = '\0';
+                        std::snprintf(piece, sizeof(piece), spec, static_cast<int>(read<int64_t>(payload)));
+                    }
+                    else
+                    {
+                        const char real = conv == 's' ? 'd' : conv; // numbers passed to %s still print
+                        spec[n++] = 'l';
+                        spec[n++] = 'l';
+                        spec[n++] = real;
+                        spec[n] = '\0';
+                        const int64_t value = tag == LogArg::Double ? static_cast<int64_t>(read<double>(payload)) : read<int64_t>(payload);
+                        if (real == 'd' || real == 'i')
+                            std::snprintf(piece, sizeof(piece), spec, static_cast<long long>(value));
+                        else
+                            std::snprintf(piece, sizeof(piece), spec, static_cast<unsigned long long>(value));
+                    }
+                    out += piece;
+                }
+            }
+        };
+
+        // Single-producer/single-consumer byte ring; records are a uint32 length and the bytes
+        class LogRing
+        {
+            static constexpr size_t MASK = LOG_RING_SIZE - 1;
+
+            std::unique_ptr<uint8_t[]> data_ = std::make_unique<uint8_t[]>(LOG_RING_SIZE);
+            std::atomic<size_t> head_{0}; // written by the owning thread
+            std::atomic<size_t> tail_{0}; // written by the flusher
+
+            void copyIn(size_t pos, const void *src, size_t size) noexcept
+            {
+                const size_t offset = pos & MASK, first = std::min(size, LOG_RING_SIZE - offset);
+                std::memcpy(data_.get() + offset, src, first);
+                std::memcpy(data_.get(), static_cast<const uint8_t *>(src) + first, size - first);
+            }
+
+            void copyOut(size_t pos, void *dst, size_t size) const noexcept
+            {
+                const size_t offset = pos & MASK, first = std::min(size, LOG_RING_SIZE - offset);
+                std::memcpy(dst, data_.get() + offset, first);
+                std::memcpy(static_cast<uint8_t *>(dst) + first, data_.get(), size - first);
+            }
+
+        public:
+            std::atomic<uint64_t> dropped{0};
+
+            bool push(const uint8_t *record, uint32_t size) noexcept
+            {
+                const size_t head = head_.load(std::memory_order_relaxed);
+                if (LOG_RING_SIZE - (head - tail_.load(std::memory_order_acquire)) < sizeof(size) + size)
+                {
+                    dropped.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                copyIn(head, &size, sizeof(size));
+                copyIn(head + sizeof(size), record, size);
+                head_.store(head + sizeof(size) + size, std::memory_order_release);
+                return true;
+            }
+
+            template <typename Fn>
+            void drain(std::vector<uint8_t> &scratch, Fn &&fn)
+            {
+                size_t tail = tail_.load(std::memory_order_relaxed);
+                const size_t head = head_.load(std::memory_order_acquire);
+                while (tail != head)
+                {
+                    uint32_t size = 0;
+                    copyOut(tail, &size, sizeof(size));
+                    scratch.resize(size);
+                    copyOut(tail + sizeof(size), scratch.data(), size);
+                    tail += sizeof(size) + size;
+                    fn(scratch.data(), scratch.size());
+                }
+                tail_.store(tail, std::memory_order_release);
+            }
+        };
+    } // namespace detail
+
+    // Logging without a shared lock on the hot path. Each thread appends binary records
+    // (format pointer plus raw arguments) to its own ring; a background flusher formats
+    // them in batches and hands the text to the console and an optional log file.
+    // Formats must be string literals, since only the pointer is stored.
+    class Logger
+    {
+        std::atomic<LogLevel> level_{LogLevel::Info};
+        std::mutex registryMutex_;
+        std::vector<std::shared_ptr<detail::LogRing>> rings_;
+
+        std::mutex drainMutex_; // one consumer at a time: the flusher or flush()
+        std::vector<uint8_t> scratch_;
+        std::string text_;
+        uint64_t reportedDrops_ = 0;
+
+        std::mutex sinkMutex_;
+        UI::Terminal *console_ = nullptr;
+        std::FILE *file_ = nullptr;
+
+        std::mutex wakeMutex_;
+        std::condition_variable wake_;
+        bool stop_ = false;
+        std::thread flusher_;
+        const std::chrono::steady_clock::time_point start_ = std::chrono::steady_clock::now();
+
+        [[nodiscard]] detail::LogRing &ring()
+        {
+            thread_local std::shared_ptr<detail::LogRing> ring;
+            if (!ring)
+            {
+                ring = std::make_shared<detail::LogRing>();
+                std::lock_guard<std::mutex> lock(registryMutex_);
+                rings_.push_back(ring);
+            }
+            return *ring;
+        }
+
+        // Format everything queued and pass it on, one console batch per run of same-style
+        // records; caller holds drainMutex_
+        void drainAll()
+        {
+            std::vector<std::shared_ptr<detail::LogRing>> rings;
+            {
+                std::lock_guard<std::mutex> lock(registryMutex_);
+                rings = rings_;
+            }
+
+            std::string consoleText, fileText;
+            bool consoleError = false;
+            const auto emit = [&](LogLevel level, std::string_view text)
+            {
+                const bool error = level >= LogLevel::Warning;
+                if (error != consoleError)
+                {
+                    post(consoleText, consoleError);
+                    consoleError = error;
+                }
+                consoleText += text;
+            };
+
+            uint64_t drops = 0;
+            for (const auto &ring : rings)
+            {
+                drops += ring->dropped.load(std::memory_order_relaxed);
+                ring->drain(scratch_, [&](const uint8_t *record, size_t size)
+                            {
+                                detail::LogHeader header;
+                                std::memcpy(&header, record, sizeof(header));
+                                text_.clear();
+                                detail::LogFormatter(record + sizeof(header), record + size).format(header.format, text_);
+                                emit(header.level, text_);
+
+                                char stamp[32];
+                                std::snprintf(stamp, sizeof(stamp), "[%10.3f] %c ", static_cast<double>(header.timeNs) / 1e9,
+                                              "DIWE"[static_cast<int>(header.level)]);
+                                fileText += stamp;
+                                fileText += text_; });
+            }
+
+            if (drops != reportedDrops_)
+            {
+                char line[64];
+                std::snprintf(line, sizeof(line), "(%llu log messages dropped)\n", static_cast<unsigned long long>(drops - reportedDrops_));
+                reportedDrops_ = drops;
+                emit(LogLevel::Warning, line);
+                fileText += line;
+            }
+            post(consoleText, consoleError);
+
+            std::lock_guard<std::mutex> lock(sinkMutex_);
+            if (file_ && !fileText.empty())
+            {
+                std::fwrite(fileText.data(), 1, fileText.size(), file_);
+                std::fflush(file_);
+            }
+        }
+
+        void post(std::string &text, bool error)
+        {
+            if (text.empty())
+                return;
+            {
+                std::lock_guard<std::mutex> lock(sinkMutex_);
+                if (console_)
+                    console_->post(text, error ? UI::STYLE_ERROR : UI::STYLE_NORMAL);
+            }
+            text.clear();
+        }
+
+        void run()
+        {
+            std::unique_lock<std::mutex> lock(wakeMutex_);
+            while (!stop_)
+            {
+                wake_.wait_for(lock, LOG_FLUSH_INTERVAL);
+                lock.unlock();
+                flush();
+                lock.lock();
+            }
+        }
+
+    public:
+        Logger() : flusher_([this]
+                            { run(); })
+        {
+        }
+
+        ~Logger()
+        {
+            {
+                std::lock_guard<std::mutex> lock(wakeMutex_);
+                stop_ = true;
+            }
+            wake_.notify_one();
+            flusher_.join();
+            flush();
+            setFile({});
+        }
+
+        Logger(const Logger &) = delete;
+        Logger &operator=(const Logger &) = delete;
+
+        void setLevel(LogLevel level) noexcept { level_.store(level, std::memory_order_relaxed); }
+        [[nodiscard]] LogLevel level() const noexcept { return level_.load(std::memory_order_relaxed); }
+        [[nodiscard]] bool enabled(LogLevel level) const noexcept { return level >= this->level() && level != LogLevel::Off; }
+
+        // Terminal that receives formatted output; null detaches it
+        void setConsole(UI::Terminal *terminal)
+        {
+            std::lock_guard<std::mutex> lock(sinkMutex_);
+            console_ = terminal;
+        }
+
+        // Append to a log file as well; an empty path closes it
+        bool setFile(const std::string &path)
+        {
+            std::lock_guard<std::mutex> lock(sinkMutex_);
+            if (file_)
+                std::fclose(file_);
+            file_ = path.empty() ? nullptr : std::fopen(path.c_str(), "a");
+            return path.empty() || file_;
+        }
+
+        template <typename... Args>
+        void log(LogLevel level, const char *format, const Args &...args) noexcept
+        {
+            if (!enabled(level)) // filtered before anything is encoded
+                return;
+            const auto now = std::chrono::steady_clock::now() - start_;
+            detail::LogEncoder encoder({format, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count()),
+                                        level, static_cast<uint8_t>(sizeof...(Args))});
+            (encoder.add(args), ...);
+            ring().push(encoder.data(), static_cast<uint32_t>(encoder.size()));
+        }
+
+        // Format everything logged so far, on the calling thread
+        void flush()
+        {
+            std::lock_guard<std::mutex> lock(drainMutex_);
+            drainAll();
+        }
+    };
+
+    [[nodiscard]] inline Logger &logger()
+    {
+        static Logger instance;
+        return instance;
+    }
+} // namespace UTIL
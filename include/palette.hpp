@@ -0,0 +1,413 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "allocprof.hpp"
+#include "libs/stb_image_write.h"
+
+// Defined by the stb_image_write implementation, but only declared there
+extern "C" unsigned char *stbi_zlib_compress(unsigned char *data, int data_len, int *out_len, int quality);
+
+namespace UTIL
+{
+    inline constexpr int PALETTE_MAX_COLORS = 256;
+
+    // 8-bit indexed image, palette entries with alpha < 255 come first so tRNS stays short
+    struct PalettedImage
+    {
+        int width = 0, height = 0;
+        std::vector<uint8_t> palette; // RGBA quads
+        std::vector<uint8_t> indices; // one entry per pixel
+
+        [[nodiscard]] int colorCount() const noexcept { return static_cast<int>(palette.size() / 4); }
+    };
+
+    namespace detail
+    {
+        struct ColorCount
+        {
+            uint32_t rgba;
+            uint32_t count;
+        };
+
+        [[nodiscard]] constexpr uint8_t channelOf(uint32_t rgba, int ch) noexcept
+        {
+            return static_cast<uint8_t>(rgba >> (ch * 8));
+        }
+
+        [[nodiscard]] constexpr uint32_t packRgba(const uint8_t *p) noexcept
+        {
+            return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+                   (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+        }
+
+        // Median-cut over the unique visible colors, returns at most maxColors RGBA entries
+        [[nodiscard]] inline std::vector<uint8_t> medianCut(std::vector<ColorCount> &colors, int maxColors)
+        {
+            struct Box
+            {
+                size_t begin, end;
+                uint64_t pixels;
+                int splitChannel;
+                int range;
+            };
+
+            const auto measure = [&colors](Box &box)
+            {
+                int lo[4] = {255, 255, 255, 255}, hi[4] = {0, 0, 0, 0};
+                box.pixels = 0;
+                for (size_t i = box.begin; i < box.end; ++i)
+                {
+                    for (int ch = 0; ch < 4; ++ch)
+                    {
+                        const int v = channelOf(colors[i].rgba, ch);
+                        lo[ch] = std::min(lo[ch], v);
+                        hi[ch] = std::max(hi[ch], v);
+                    }
+                    box.pixels += colors[i].count;
+                }
+                box.splitChannel = 0;
+                box.range = -1;
+                for (int ch = 0; ch < 4; ++ch)
+                {
+                    if (hi[ch] - lo[ch] > box.range)
+                    {
+                        box.range = hi[ch] - lo[ch];
+                        box.splitChannel = ch;
+                    }
+                }
+            };
+
+            std::vector<Box> boxes;
+            boxes.reserve(static_cast<size_t>(maxColors));
+            boxes.push_back({0, colors.size(), 0, 0, 0});
+            measure(boxes.back());
+
+            while (static_cast<int>(boxes.size()) < maxColors)
+            {
+                // Split the box with the widest channel, weighted by how many pixels it covers
+                Box *target = nullptr;
+                uint64_t bestScore = 0;
+                for (auto &box : boxes)
+                {
+                    if (box.end - box.begin < 2 || box.range <= 0)
+                        continue;
+                    const uint64_t score = static_cast<uint64_t>(box.range) * box.pixels;
+                    if (score > bestScore)
+                    {
+                        bestScore = score;
+                        target = &box;
+                    }
+                }
+                if (!target)
+                    break;
+
+                const int ch = target->splitChannel;
+                std::sort(colors.begin() + static_cast<std::ptrdiff_t>(target->begin),
+                          colors.begin() + static_cast<std::ptrdiff_t>(target->end),
+                          [ch](const ColorCount &a, const ColorCount &b)
+                          { return channelOf(a.rgba, ch) < channelOf(b.rgba, ch); });
+
+                uint64_t acc = 0;
+                size_t mid = target->begin + 1;
+                for (size_t i = target->begin; i < target->end - 1; ++i)
+                {
+                    acc += colors[i].count;
+                    mid = i + 1;
+                    if (acc * 2 >= target->pixels)
+                        break;
+                }
+
+                Box upper{mid, target->end, 0, 0, 0};
+                target->end = mid;
+                measure(*target);
+                measure(upper);
+                boxes.push_back(upper);
+            }
+
+            std::vector<uint8_t> palette;
+            palette.reserve(boxes.size() * 4);
+            for (const auto &box : boxes)
+            {
+                uint64_t sum[4] = {0, 0, 0, 0};
+                for (size_t i = box.begin; i < box.end; ++i)
+                    for (int ch = 0; ch < 4; ++ch)
+                        sum[ch] += static_cast<uint64_t>(channelOf(colors[i].rgba, ch)) * colors[i].count;
+                for (int ch = 0; ch < 4; ++ch)
+                    palette.push_back(static_cast<uint8_t>((sum[ch] + box.pixels / 2) / box.pixels));
+            }
+            return palette;
+        }
+
+        // Alpha-aware distance: color errors under low alpha are barely visible
+        [[nodiscard]] inline int nearestColor(const std::vector<uint8_t> &palette, int first, const int px[4]) noexcept
+        {
+            int best = first;
+            long bestDist = -1;
+            const int count = static_cast<int>(palette.size() / 4);
+            for (int i = first; i < count; ++i)
+            {
+                const uint8_t *p = &palette[static_cast<size_t>(i) * 4];
+                const long dr = px[0] - p[0], dg = px[1] - p[1], db = px[2] - p[2], da = px[3] - p[3];
+                const long dist = ((dr * dr + dg * dg + db * db) * (px[3] + 1) >> 8) + 2 * da * da;
+                if (bestDist < 0 || dist < bestDist)
+                {
+                    bestDist = dist;
+                    best = i;
+                    if (dist == 0)
+                        break;
+                }
+            }
+            return best;
+        }
+
+        [[nodiscard]] inline uint32_t crc32(const uint8_t *data, size_t len, uint32_t crc = 0) noexcept
+        {
+            static const auto table = []
+            {
+                std::array<uint32_t, 256> t{};
+                for (uint32_t n = 0; n < 256; ++n)
+                {
+                    uint32_t c = n;
+                    for (int k = 0; k < 8; ++k)
+                        c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                    t[n] = c;
+                }
+                return t;
+            }();
+
+            crc = ~crc;
+            for (size_t i = 0; i < len; ++i)
+                crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+            return ~crc;
+        }
+
+        inline void putBigEndian32(std::vector<uint8_t> &out, uint32_t v)
+        {
+            out.push_back(static_cast<uint8_t>(v >> 24));
+            out.push_back(static_cast<uint8_t>(v >> 16));
+            out.push_back(static_cast<uint8_t>(v >> 8));
+            out.push_back(static_cast<uint8_t>(v));
+        }
+
+        inline void putChunk(std::vector<uint8_t> &out, const char type[4], const uint8_t *data, size_t len)
+        {
+            putBigEndian32(out, static_cast<uint32_t>(len));
+            const size_t typeOffset = out.size();
+            out.insert(out.end(), type, type + 4);
+            if (len)
+                out.insert(out.end(), data, data + len);
+            putBigEndian32(out, crc32(&out[typeOffset], len + 4));
+        }
+    } // namespace detail
+
+    // Reduce an RGBA buffer to at most 256 colors. Fully transparent pixels share one entry,
+    // images that already fit are mapped exactly, everything else is median-cut and dithered.
+    [[nodiscard]] inline PalettedImage quantizeRgba(const uint8_t *rgba, int width, int height, bool dither = true)
+    {
+        PalettedImage out;
+        out.width = width;
+        out.height = height;
+        const size_t pixelCount = static_cast<size_t>(width) * static_cast<size_t>(height);
+        out.indices.resize(pixelCount);
+
+        std::vector<uint32_t> keys;
+        keys.reserve(pixelCount);
+        bool hasTransparent = false;
+        for (size_t i = 0; i < pixelCount; ++i)
+        {
+            if (rgba[i * 4 + 3] == 0)
+                hasTransparent = true;
+            else
+                keys.push_back(detail::packRgba(&rgba[i * 4]));
+        }
+        std::sort(keys.begin(), keys.end());
+
+        std::vector<detail::ColorCount> colors;
+        for (const uint32_t key : keys)
+        {
+            if (!colors.empty() && colors.back().rgba == key)
+                ++colors.back().count;
+            else
+                colors.push_back({key, 1});
+        }
+        keys.clear();
+        keys.shrink_to_fit();
+
+        const int reserved = hasTransparent ? 1 : 0;
+        const int maxColors = PALETTE_MAX_COLORS - reserved;
+        const bool exact = static_cast<int>(colors.size()) <= maxColors;
+
+        std::vector<uint8_t> palette;
+        if (hasTransparent)
+            palette.insert(palette.end(), {0, 0, 0, 0});
+        if (exact)
+        {
+            for (const auto &c : colors)
+                for (int ch = 0; ch < 4; ++ch)
+                    palette.push_back(detail::channelOf(c.rgba, ch));
+        }
+        else
+        {
+            const auto cut = detail::medianCut(colors, maxColors);
+            palette.insert(palette.end(), cut.begin(), cut.end());
+        }
+
+        // Translucent entries first so the tRNS chunk can be truncated
+        const int count = static_cast<int>(palette.size() / 4);
+        std::vector<int> order(static_cast<size_t>(count));
+        for (int i = 0; i < count; ++i)
+            order[static_cast<size_t>(i)] = i;
+        std::stable_sort(order.begin(), order.end(), [&palette](int a, int b)
+                         { return (palette[static_cast<size_t>(a) * 4 + 3] < 255) > (palette[static_cast<size_t>(b) * 4 + 3] < 255); });
+        out.palette.reserve(palette.size());
+        for (const int idx : order)
+            out.palette.insert(out.palette.end(), palette.begin() + idx * 4, palette.begin() + idx * 4 + 4);
+
+        // Transparent entry (alpha 0) always sorts to index 0 when present
+        const int firstVisible = reserved;
+
+        if (exact)
+        {
+            std::vector<std::pair<uint32_t, uint8_t>> lookup;
+            lookup.reserve(static_cast<size_t>(count));
+            for (int i = firstVisible; i < count; ++i)
+                lookup.emplace_back(detail::packRgba(&out.palette[static_cast<size_t>(i) * 4]), static_cast<uint8_t>(i));
+            std::sort(lookup.begin(), lookup.end());
+
+            for (size_t i = 0; i < pixelCount; ++i)
+            {
+                if (rgba[i * 4 + 3] == 0)
+                {
+                    out.indices[i] = 0;
+                    continue;
+                }
+                const uint32_t key = detail::packRgba(&rgba[i * 4]);
+                const auto it = std::lower_bound(lookup.begin(), lookup.end(), std::make_pair(key, uint8_t{0}));
+                out.indices[i] = it->second;
+            }
+            return out;
+        }
+
+        // Floyd-Steinberg over RGBA; error never leaks into or out of fully transparent pixels
+        const size_t rowLen = static_cast<size_t>(width + 2) * 4;
+        std::vector<int> errCur(dither ? rowLen : 0, 0), errNext(dither ? rowLen : 0, 0);
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                const size_t i = static_cast<size_t>(y) * static_cast<size_t>(width) + static_cast<size_t>(x);
+                const uint8_t *src = &rgba[i * 4];
+                if (src[3] == 0)
+                {
+                    out.indices[i] = 0;
+                    continue;
+                }
+
+                int px[4];
+                for (int ch = 0; ch < 4; ++ch)
+                {
+                    const int e = dither ? errCur[static_cast<size_t>(x + 1) * 4 + static_cast<size_t>(ch)] : 0;
+                    px[ch] = std::clamp(src[ch] + e / 16, 0, 255);
+                }
+                if (px[3] == 0)
+                    px[3] = 1;
+
+                const int idx = detail::nearestColor(out.palette, firstVisible, px);
+                out.indices[i] = static_cast<uint8_t>(idx);
+                if (!dither)
+                    continue;
+
+                const uint8_t *p = &out.palette[static_cast<size_t>(idx) * 4];
+                for (int ch = 0; ch < 4; ++ch)
+                {
+                    const int err = px[ch] - p[ch];
+                    const size_t c = static_cast<size_t>(ch);
+                    errCur[static_cast<size_t>(x + 2) * 4 + c] += err * 7;
+                    errNext[static_cast<size_t>(x) * 4 + c] += err * 3;
+                    errNext[static_cast<size_t>(x + 1) * 4 + c] += err * 5;
+                    errNext[static_cast<size_t>(x + 2) * 4 + c] += err;
+                }
+            }
+            if (dither)
+            {
+                errCur.swap(errNext);
+                std::fill(errNext.begin(), errNext.end(), 0);
+            }
+        }
+        return out;
+    }
+
+    // Write an indexed PNG (color type 3) with PLTE and, if needed, tRNS
+    // The PNG file's bytes, empty if the image is invalid
+    [[nodiscard]] inline std::vector<uint8_t> encodePalettedPng(const PalettedImage &img)
+    {
+        const int colors = img.colorCount();
+        if (img.width <= 0 || img.height <= 0 || colors <= 0 || colors > PALETTE_MAX_COLORS)
+            return {};
+
+        // Palette images compress best unfiltered, so every row gets filter type 0
+        const size_t stride = static_cast<size_t>(img.width) + 1;
+        std::vector<uint8_t> raw(stride * static_cast<size_t>(img.height));
+        for (int y = 0; y < img.height; ++y)
+        {
+            raw[static_cast<size_t>(y) * stride] = 0;
+            std::copy_n(img.indices.begin() + static_cast<std::ptrdiff_t>(y) * img.width, img.width,
+                        raw.begin() + static_cast<std::ptrdiff_t>(static_cast<size_t>(y) * stride + 1));
+        }
+
+        int zlen = 0;
+        unsigned char *zlib = stbi_zlib_compress(raw.data(), static_cast<int>(raw.size()), &zlen,
+                                                 stbi_write_png_compression_level);
+        if (!zlib)
+            return {};
+
+        std::vector<uint8_t> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+        png.reserve(static_cast<size_t>(zlen) + static_cast<size_t>(colors) * 4 + 64);
+
+        std::vector<uint8_t> ihdr;
+        detail::putBigEndian32(ihdr, static_cast<uint32_t>(img.width));
+        detail::putBigEndian32(ihdr, static_cast<uint32_t>(img.height));
+        ihdr.insert(ihdr.end(), {8, 3, 0, 0, 0});
+        detail::putChunk(png, "IHDR", ihdr.data(), ihdr.size());
+
+        std::vector<uint8_t> plte, trns;
+        plte.reserve(static_cast<size_t>(colors) * 3);
+        for (int i = 0; i < colors; ++i)
+        {
+            const uint8_t *p = &img.palette[static_cast<size_t>(i) * 4];
+            plte.insert(plte.end(), p, p + 3);
+            if (p[3] < 255)
+                trns.push_back(p[3]);
+        }
+        detail::putChunk(png, "PLTE", plte.data(), plte.size());
+        if (!trns.empty())
+            detail::putChunk(png, "tRNS", trns.data(), trns.size());
+        detail::putChunk(png, "IDAT", zlib, static_cast<size_t>(zlen));
+        detail::putChunk(png, "IEND", nullptr, 0);
+        stbFree(zlib); // allocated through STBIW_MALLOC
+        return png;
+    }
+
+    [[nodiscard]] inline bool writePngFile(std::string_view path, const std::vector<uint8_t> &png)
+    {
+        if (png.empty())
+            return false;
+        std::ofstream ofs(std::string(path), std::ios::binary | std::ios::trunc);
+        if (!ofs)
+            return false;
+        ofs.write(reinterpret_cast<const char *>(png.data()), static_cast<std::streamsize>(png.size()));
+        return static_cast<bool>(ofs);
+    }
+
+    [[nodiscard]] inline bool writePalettedPng(std::string_view path, const PalettedImage &img)
+    {
+        return writePngFile(path, encodePalettedPng(img));
+    }
+} // namespace UTIL
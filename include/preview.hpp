@@ -0,0 +1,362 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "downloader.hpp"
+#include "util.hpp"
+#include "scheduler.hpp"
+
+namespace UTIL
+{
+    inline constexpr int PREVIEW_SIZE = 256;
+    inline constexpr size_t PREVIEW_CACHE_CAPACITY = 32;
+    inline constexpr int PREVIEW_PREFETCH_ROWS = 3;
+
+    // Decoded RGBA thumbnail, at most PREVIEW_SIZE on its longest side
+    struct PreviewImage
+    {
+        int width = 0, height = 0;
+        std::vector<uint8_t> rgba;
+    };
+
+    // Where a preview can come from: the generated amiibo.png first, the image URL second.
+    // The file is looked up by locate() on the worker that loads the row, since finding it
+    // touches the card; the menu only hands over the key and URL.
+    struct PreviewSource
+    {
+        std::string key;
+        std::string url;
+        std::function<std::string()> locate; // path of the local image, empty if none
+    };
+
+    struct PreviewStats
+    {
+        uint64_t hits = 0, misses = 0, decoded = 0, fetched = 0, evicted = 0;
+
+        [[nodiscard]] double hitRate() const noexcept
+        {
+            const uint64_t total = hits + misses;
+            return total ? static_cast<double>(hits) / static_cast<double>(total) : 0.0;
+        }
+    };
+
+    // Bounded LRU of decoded previews. A null image marks a known miss; 'complete' is false
+    // while only the local file was tried and a fetch may still produce an image.
+    class PreviewCache
+    {
+    public:
+        struct Entry
+        {
+            std::shared_ptr<const PreviewImage> image;
+            bool complete = true;
+        };
+
+    private:
+        using Item = std::pair<std::string, Entry>;
+
+        size_t capacity_;
+        std::list<Item> items_; // most recently used first
+        std::unordered_map<std::string, std::list<Item>::iterator> index_;
+
+    public:
+        explicit PreviewCache(size_t capacity = PREVIEW_CACHE_CAPACITY) : capacity_(capacity ? capacity : 1) {}
+
+        [[nodiscard]] const Entry *find(const std::string &key)
+        {
+            const auto it = index_.find(key);
+            if (it == index_.end())
+                return nullptr;
+            items_.splice(items_.begin(), items_, it->second);
+            return &it->second->second;
+        }
+
+        [[nodiscard]] const Entry *peek(const std::string &key) const
+        {
+            const auto it = index_.find(key);
+            return it == index_.end() ? nullptr : &it->second->second;
+        }
+
+        // Returns the number of entries evicted to make room
+        size_t put(const std::string &key, Entry entry)
+        {
+            if (const auto it = index_.find(key); it != index_.end())
+            {
+                it->second->second = std::move(entry);
+                items_.splice(items_.begin(), items_, it->second);
+                return 0;
+            }
+
+            items_.emplace_front(key, std::move(entry));
+            index_.emplace(key, items_.begin());
+
+            size_t evicted = 0;
+            while (items_.size() > capacity_)
+            {
+                index_.erase(items_.back().first);
+                items_.pop_back();
+                ++evicted;
+            }
+            return evicted;
+        }
+
+        void erase(const std::string &key)
+        {
+            if (const auto it = index_.find(key); it != index_.end())
+            {
+                items_.erase(it->second);
+                index_.erase(it);
+            }
+        }
+
+        void clear() noexcept
+        {
+            items_.clear();
+            index_.clear();
+        }
+
+        [[nodiscard]] size_t size() const noexcept { return items_.size(); }
+    };
+
+    // Decode, crop and shrink an image into a preview
+    [[nodiscard]] inline std::shared_ptr<const PreviewImage> makePreview(unsigned char *pixels, int width, int height)
+    {
+        CropRect src{0, 0, width, height};
+        if (const auto bounds = findOpaqueBounds(pixels, width, height, 4))
+            src = *bounds;
+
+        const float scale = static_cast<float>(PREVIEW_SIZE) / static_cast<float>(std::max(src.width(), src.height()));
+        auto preview = std::make_shared<PreviewImage>();
+        preview->width = std::max(1, static_cast<int>(static_cast<float>(src.width()) * scale));
+        preview->height = std::max(1, static_cast<int>(static_cast<float>(src.height()) * scale));
+        preview->rgba.resize(static_cast<size_t>(preview->width) * static_cast<size_t>(preview->height) * 4);
+
+        const unsigned char *origin = pixels + (static_cast<size_t>(src.top) * static_cast<size_t>(width) + static_cast<size_t>(src.left)) * 4;
+        if (!resizeBoxUint8(origin, src.width(), src.height(), width * 4,
+                            preview->rgba.data(), preview->width, preview->height, 4))
+            return nullptr;
+        return preview;
+    }
+
+    // Background loader feeding the menu's preview panel. The menu publishes the rows it
+    // wants in priority order (cursor first); each row that is not cached yet becomes a
+    // scheduler task, interactive for the cursor and prefetch for its neighbours. Tasks
+    // for rows that are no longer wanted by the time they run are simply dropped. The
+    // cursor row's image download is queued on the downloader, not waited for.
+    class PreviewLoader
+    {
+    public:
+        enum class State
+        {
+            Pending,
+            Ready,
+            Missing,
+        };
+
+    private:
+        // Outlives the loader while tasks still reference it
+        struct Shared
+        {
+            std::mutex mutex;
+            std::vector<PreviewSource> wanted;
+            std::unordered_set<std::string> loading;
+            PreviewCache cache;
+            PreviewStats stats;
+            bool fetchMissing = true;
+            bool stopped = false;
+            std::atomic<bool> updated{false};
+        };
+
+        Scheduler &scheduler_;
+        Downloader &downloader_;
+        std::shared_ptr<Shared> shared_;
+
+        // Only the cursor row (index 0) may hit the network
+        [[nodiscard]] static bool fetchable(const Shared &shared, size_t index)
+        {
+            return index == 0 && shared.fetchMissing && !shared.wanted[index].url.empty();
+        }
+
+        // Submit every wanted row that is neither cached nor loading; caller holds the lock
+        static void schedule(Scheduler &scheduler, Downloader &downloader, const std::shared_ptr<Shared> &shared)
+        {
+            for (size_t i = 0; i < shared->wanted.size(); ++i)
+            {
+                const std::string &key = shared->wanted[i].key;
+                const auto *entry = shared->cache.peek(key);
+                if ((entry && (entry->complete || !fetchable(*shared, i))) || shared->loading.count(key))
+                    continue;
+                shared->loading.insert(key);
+                scheduler.submit(i == 0 ? TaskPriority::Interactive : TaskPriority::Prefetch,
+                                 [&scheduler, &downloader, shared, key]
+                                 { run(scheduler, downloader, shared, key); });
+            }
+        }
+
+        [[nodiscard]] static std::shared_ptr<const PreviewImage> decode(unsigned char *pixels, int w, int h)
+        {
+            if (!pixels)
+                return nullptr;
+            auto preview = makePreview(pixels, w, h);
+            stbi_image_free(pixels);
+            return preview;
+        }
+
+        static void store(Scheduler &scheduler, Downloader &downloader, const std::shared_ptr<Shared> &shared, const std::string &key,
+                          PreviewCache::Entry entry, bool fetched)
+        {
+            std::lock_guard<std::mutex> lock(shared->mutex);
+            shared->loading.erase(key);
+            shared->stats.decoded += entry.image ? 1 : 0;
+            shared->stats.fetched += fetched ? 1 : 0;
+            shared->stats.evicted += shared->cache.put(key, std::move(entry));
+            shared->updated.store(true, std::memory_order_release);
+            // The cursor may have landed on this row while only its local file was tried
+            if (!shared->stopped)
+                schedule(scheduler, downloader, shared);
+        }
+
+        static void decodeFetched(Scheduler &scheduler, Downloader &downloader, const std::shared_ptr<Shared> &shared, const std::string &key,
+                            int result, const std::vector<unsigned char> &encoded)
+        {
+            const TraceScope trace("preview", "image");
+            const AllocPhaseScope phase(AllocPhase::Image);
+            int w = 0, h = 0, channels = 0;
+            std::shared_ptr<const PreviewImage> image;
+            if (result == 0)
+            {
+                // Loaded first: decode's size arguments must not be read before stb sets them
+                unsigned char *pixels = stbi_load_from_memory(encoded.data(), static_cast<int>(encoded.size()), &w, &h, &channels, 4);
+                image = decode(pixels, w, h);
+            }
+            store(scheduler, downloader, shared, key, {std::move(image), true}, true);
+        }
+
+        static void run(Scheduler &scheduler, Downloader &downloader, const std::shared_ptr<Shared> &shared, const std::string &key)
+        {
+            PreviewSource job;
+            bool allowFetch = false;
+            {
+                std::lock_guard<std::mutex> lock(shared->mutex);
+                const auto it = std::find_if(shared->wanted.begin(), shared->wanted.end(),
+                                             [&](const PreviewSource &s)
+                                             { return s.key == key; });
+                if (shared->stopped || it == shared->wanted.end())
+                {
+                    shared->loading.erase(key);
+                    return;
+                }
+                job = *it;
+                allowFetch = fetchable(*shared, static_cast<size_t>(it - shared->wanted.begin()));
+            }
+
+            int w = 0, h = 0, channels = 0;
+            std::error_code ec;
+            std::shared_ptr<const PreviewImage> image;
+            const std::string path = job.locate ? job.locate() : std::string();
+            if (!path.empty() && std::filesystem::exists(path, ec))
+            {
+                const TraceScope trace("preview", "image");
+                const AllocPhaseScope phase(AllocPhase::Image);
+                unsigned char *pixels = stbi_load(path.c_str(), &w, &h, &channels, 4);
+                image = decode(pixels, w, h);
+            }
+
+            // The download goes through the shared downloader's preview class; the row stays
+            // loading until its bytes are decoded on another task
+            if (!image && allowFetch)
+            {
+                std::lock_guard<std::mutex> lock(shared->mutex);
+                if (!shared->stopped)
+                {
+                    downloader.fetchToMemory(job.url, [&scheduler, &downloader, shared, key](int result, std::vector<unsigned char> encoded)
+                                             { scheduler.submit(TaskPriority::Interactive, [&scheduler, &downloader, shared, key, result, encoded = std::move(encoded)]
+                                                                { decodeFetched(scheduler, downloader, shared, key, result, encoded); }); },
+                                             DownloadClass::Preview);
+                    return;
+                }
+            }
+
+            const bool complete = image || allowFetch || job.url.empty() || !shared->fetchMissing;
+            store(scheduler, downloader, shared, key, {std::move(image), complete}, false);
+        }
+
+    public:
+        PreviewLoader(Scheduler &scheduler, Downloader &downloader, bool fetchMissing = true)
+            : scheduler_(scheduler), downloader_(downloader), shared_(std::make_shared<Shared>())
+        {
+            shared_->fetchMissing = fetchMissing;
+        }
+
+        // Queued tasks turn into no-ops; one already decoding finishes into the orphaned cache
+        ~PreviewLoader()
+        {
+            std::lock_guard<std::mutex> lock(shared_->mutex);
+            shared_->stopped = true;
+        }
+
+        PreviewLoader(const PreviewLoader &) = delete;
+        PreviewLoader &operator=(const PreviewLoader &) = delete;
+
+        // Replace the wanted list, cursor row first, prefetch rows after it
+        void want(std::vector<PreviewSource> sources)
+        {
+            std::lock_guard<std::mutex> lock(shared_->mutex);
+            shared_->wanted = std::move(sources);
+            schedule(scheduler_, downloader_, shared_);
+        }
+
+        // Non-blocking lookup for the panel; counts towards the hit rate
+        [[nodiscard]] State get(const std::string &key, std::shared_ptr<const PreviewImage> &image)
+        {
+            std::lock_guard<std::mutex> lock(shared_->mutex);
+            const auto *entry = shared_->cache.find(key);
+            if (!entry)
+            {
+                ++shared_->stats.misses;
+                image.reset();
+                return State::Pending;
+            }
+            ++shared_->stats.hits;
+            image = entry->image;
+            if (image)
+                return State::Ready;
+            return entry->complete ? State::Missing : State::Pending;
+        }
+
+        // Drop a cached entry, e.g. after the amiibo was generated or deleted
+        void invalidate(const std::string &key)
+        {
+            std::lock_guard<std::mutex> lock(shared_->mutex);
+            shared_->cache.erase(key);
+            schedule(scheduler_, downloader_, shared_);
+        }
+
+        void clear()
+        {
+            std::lock_guard<std::mutex> lock(shared_->mutex);
+            shared_->cache.clear();
+            schedule(scheduler_, downloader_, shared_);
+        }
+
+        // True once per batch of newly finished loads
+        [[nodiscard]] bool takeUpdated() noexcept { return shared_->updated.exchange(false, std::memory_order_acq_rel); }
+
+        [[nodiscard]] PreviewStats stats() const
+        {
+            std::lock_guard<std::mutex> lock(shared_->mutex);
+            return shared_->stats;
+        }
+    };
+} // namespace UTIL
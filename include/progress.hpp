@@ -0,0 +1,256 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <system_error>
+
+#include <curl/curl.h>
+
+#include "terminal.hpp"
+
+namespace UTIL
+{
+    inline constexpr size_t PROGRESS_CAPACITY = 1024; // power of two
+
+    enum class ProgressStage : uint8_t
+    {
+        Item,      // an item was picked up, or finished (Done)
+        Validate,  // amiibo data and ID
+        Directory, // figure directory creation
+        Metadata,  // amiibo.flag / amiibo.json
+        Download,
+        Decode,
+        Resize,
+        Write,
+        Sync,      // forcing finished figures out to the card
+    };
+
+    enum class ProgressCode : uint8_t
+    {
+        Started,
+        Ok,
+        Done,
+        Failed,
+        Exists,
+        InvalidData,
+        IoError,
+        NetworkError, // detail: CURLcode
+        HttpError,    // detail: HTTP status
+        TooSmall,
+        ImageError,
+    };
+
+    // One result reported by worker code. Kept small and string-free so posting never allocates;
+    // the UI turns it back into text with describe().
+    struct ProgressEvent
+    {
+        uint32_t item = 0;
+        ProgressStage stage = ProgressStage::Item;
+        ProgressCode code = ProgressCode::Ok;
+        int32_t detail = 0; // curl code, HTTP status, errno or image height, depending on code
+        uint64_t bytes = 0;
+    };
+
+    [[nodiscard]] constexpr bool isError(ProgressCode code) noexcept
+    {
+        return code != ProgressCode::Started && code != ProgressCode::Ok && code != ProgressCode::Done &&
+               code != ProgressCode::Exists;
+    }
+
+    // Console line for an event, empty for events that only carry state (Started/Done)
+    [[nodiscard]] inline std::string describe(const ProgressEvent &e)
+    {
+        char line[256];
+        line[0] = '\0';
+        switch (e.code)
+        {
+        case ProgressCode::Started:
+        case ProgressCode::Done:
+            break;
+        case ProgressCode::Ok:
+            if (e.stage == ProgressStage::Download)
+                std::snprintf(line, sizeof(line), "Downloaded: %llu bytes\n", static_cast<unsigned long long>(e.bytes));
+            break;
+        case ProgressCode::Failed:
+            std::snprintf(line, sizeof(line), "Failed to generate amiibo.\n");
+            break;
+        case ProgressCode::Exists:
+            std::snprintf(line, sizeof(line), "Amiibo already exists.\n");
+            break;
+        case ProgressCode::InvalidData:
+            std::snprintf(line, sizeof(line), "%s\n",
+                          e.stage == ProgressStage::Download ? "Error: empty URL or path provided to downloadFile"
+                          : e.stage == ProgressStage::Decode ? "Error: empty image path"
+                                                             : "Error: Invalid amiibo data or ID");
+            break;
+        case ProgressCode::IoError:
+            std::snprintf(line, sizeof(line), "Error: Failed to %s: %s\n",
+                          e.stage == ProgressStage::Directory  ? "create directory"
+                          : e.stage == ProgressStage::Metadata ? "write amiibo files"
+                          : e.stage == ProgressStage::Write    ? "write image"
+                          : e.stage == ProgressStage::Sync     ? "sync to the card"
+                                                               : "open file for writing",
+                          std::generic_category().message(e.detail).c_str());
+            break;
+        case ProgressCode::NetworkError:
+            std::snprintf(line, sizeof(line), "CURL error: %s%s\n", curl_easy_strerror(static_cast<CURLcode>(e.detail)),
+                          e.detail == CURLE_SSL_CACERT_BADFILE || e.detail == CURLE_PEER_FAILED_VERIFICATION
+                              ? " - check tls.caBundle in config.json"
+                              : "");
+            break;
+        case ProgressCode::HttpError:
+            std::snprintf(line, sizeof(line), "HTTP error: %ld\n", static_cast<long>(e.detail));
+            break;
+        case ProgressCode::TooSmall:
+            std::snprintf(line, sizeof(line), "Downloaded file too small: %llu bytes\n", static_cast<unsigned long long>(e.bytes));
+            break;
+        case ProgressCode::ImageError:
+            if (e.stage == ProgressStage::Decode)
+                std::snprintf(line, sizeof(line), "Error loading image\n");
+            else
+                std::snprintf(line, sizeof(line), "Error: Failed to %s image to %dpx\n",
+                              e.stage == ProgressStage::Write ? "write" : "resize", static_cast<int>(e.detail));
+            break;
+        }
+        return line;
+    }
+
+    // Bounded multi-producer/single-consumer ring (Vyukov's sequence-per-cell queue).
+    // Producers never block: when the UI falls a full ring behind, events are counted
+    // as dropped instead.
+    class ProgressChannel
+    {
+        static_assert((PROGRESS_CAPACITY & (PROGRESS_CAPACITY - 1)) == 0, "capacity must be a power of two");
+        static constexpr size_t MASK = PROGRESS_CAPACITY - 1;
+
+        struct Cell
+        {
+            std::atomic<size_t> sequence;
+            ProgressEvent event;
+        };
+
+        std::array<Cell, PROGRESS_CAPACITY> cells_;
+        alignas(64) std::atomic<size_t> head_{0}; // next slot to claim, shared by producers
+        alignas(64) size_t tail_ = 0;             // next slot to read, consumer only
+        std::atomic<uint64_t> dropped_{0};
+
+    public:
+        ProgressChannel()
+        {
+            for (size_t i = 0; i < PROGRESS_CAPACITY; ++i)
+                cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        ProgressChannel(const ProgressChannel &) = delete;
+        ProgressChannel &operator=(const ProgressChannel &) = delete;
+
+        // Any thread. Returns false if the ring was full and the event was dropped.
+        bool post(const ProgressEvent &event) noexcept
+        {
+            size_t pos = head_.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                Cell &cell = cells_[pos & MASK];
+                const size_t seq = cell.sequence.load(std::memory_order_acquire);
+                const auto diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+                if (diff == 0)
+                {
+                    if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        cell.event = event;
+                        cell.sequence.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                else
+                {
+                    pos = head_.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        // Consumer thread only. Hands every queued event to fn, returns how many.
+        template <typename Fn>
+        size_t drain(Fn &&fn)
+        {
+            size_t count = 0;
+            for (;;)
+            {
+                Cell &cell = cells_[tail_ & MASK];
+                if (cell.sequence.load(std::memory_order_acquire) != tail_ + 1)
+                    return count;
+                const ProgressEvent event = cell.event;
+                cell.sequence.store(tail_ + PROGRESS_CAPACITY, std::memory_order_release);
+                ++tail_;
+                ++count;
+                fn(event);
+            }
+        }
+
+        [[nodiscard]] uint64_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+    };
+
+    namespace detail
+    {
+        struct ProgressTarget
+        {
+            ProgressChannel *channel = nullptr;
+            uint32_t item = 0;
+        };
+
+        [[nodiscard]] inline ProgressTarget &progressTarget() noexcept
+        {
+            thread_local ProgressTarget target;
+            return target;
+        }
+    } // namespace detail
+
+    // Where this thread's reports currently go; lets work continued on another thread
+    // (e.g. a download completion) report against the same item
+    using ProgressContext = detail::ProgressTarget;
+
+    [[nodiscard]] inline ProgressContext currentProgress() noexcept { return detail::progressTarget(); }
+
+    // Routes report() calls on this thread to a channel, tagged with the item being worked on
+    class ProgressScope
+    {
+        detail::ProgressTarget saved_;
+
+    public:
+        ProgressScope(ProgressChannel &channel, uint32_t item) : ProgressScope(ProgressContext{&channel, item}) {}
+        explicit ProgressScope(const ProgressContext &context) : saved_(detail::progressTarget())
+        {
+            detail::progressTarget() = context;
+        }
+        ~ProgressScope() { detail::progressTarget() = saved_; }
+
+        ProgressScope(const ProgressScope &) = delete;
+        ProgressScope &operator=(const ProgressScope &) = delete;
+    };
+
+    // Report from working code. Outside a ProgressScope the event is printed right away,
+    // so single-shot callers keep their console output.
+    inline void report(ProgressStage stage, ProgressCode code, int32_t detail = 0, uint64_t bytes = 0)
+    {
+        const auto &target = detail::progressTarget();
+        const ProgressEvent event{target.item, stage, code, detail, bytes};
+        if (target.channel)
+        {
+            target.channel->post(event);
+            return;
+        }
+        if (const std::string line = describe(event); !line.empty())
+        {
+            std::fputs(line.c_str(), isError(code) ? stderr : stdout);
+            UI::present();
+        }
+    }
+} // namespace UTIL
@@ -0,0 +1,264 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "libs/json.hpp"
+#include "jsonindex.hpp"
+
+namespace UTIL
+{
+    // One schema key and the record slot it binds to. A null slot marks an object whose
+    // members are bound under "key.member".
+    template <typename Record>
+    struct RecordField
+    {
+        std::string_view key;
+        std::string Record::*slot = nullptr;
+    };
+
+    namespace detail
+    {
+        // FNV-1a; it streams, so hashing "release", '.' and "au" in turn equals hashing "release.au"
+        [[nodiscard]] constexpr uint32_t fieldHash(std::string_view key, uint32_t state) noexcept
+        {
+            for (const char c : key)
+            {
+                state ^= static_cast<uint8_t>(c);
+                state *= 16777619u;
+            }
+            return state;
+        }
+
+        [[nodiscard]] constexpr uint32_t fieldHashStart(std::string_view prefix, uint32_t seed) noexcept
+        {
+            const uint32_t state = 2166136261u ^ seed * 0x9E3779B9u;
+            return prefix.empty() ? state : fieldHash(".", fieldHash(prefix, state));
+        }
+
+        [[nodiscard]] constexpr size_t fieldTableSize(size_t fields) noexcept
+        {
+            size_t size = 1;
+            while (size < 2 * fields)
+                size <<= 1;
+            return size;
+        }
+    } // namespace detail
+
+    // Key -> field dispatch with a seed picked at compile time so that every schema key
+    // lands in its own slot: a lookup is one hash, one table load and one compare, with
+    // no std::string built for the key.
+    template <typename Record, size_t N>
+    class FieldTable
+    {
+        static constexpr size_t SIZE = detail::fieldTableSize(N);
+        static constexpr uint32_t MAX_SEED = 1u << 16;
+
+        std::array<RecordField<Record>, N> fields_{};
+        std::array<int16_t, SIZE> slots_{};
+        uint32_t seed_ = 0;
+        bool valid_ = false;
+
+        [[nodiscard]] static constexpr size_t slotOf(uint32_t hash) noexcept
+        {
+            return (hash ^ hash >> 16) & (SIZE - 1);
+        }
+
+        [[nodiscard]] constexpr bool trySeed(uint32_t seed) noexcept
+        {
+            for (auto &slot : slots_)
+                slot = -1;
+            for (size_t i = 0; i < N; ++i)
+            {
+                const size_t slot = slotOf(detail::fieldHash(fields_[i].key, detail::fieldHashStart({}, seed)));
+                if (slots_[slot] >= 0)
+                    return false;
+                slots_[slot] = static_cast<int16_t>(i);
+            }
+            return true;
+        }
+
+    public:
+        constexpr explicit FieldTable(const RecordField<Record> (&fields)[N])
+        {
+            for (size_t i = 0; i < N; ++i)
+                fields_[i] = fields[i];
+            for (uint32_t seed = 0; seed < MAX_SEED && !valid_; ++seed)
+            {
+                valid_ = trySeed(seed);
+                seed_ = seed;
+            }
+        }
+
+        // False if no seed separated the keys; checked with static_assert where a table is defined
+        [[nodiscard]] constexpr bool valid() const noexcept { return valid_; }
+        [[nodiscard]] constexpr const RecordField<Record> &field(int i) const noexcept { return fields_[static_cast<size_t>(i)]; }
+
+        // Index of "prefix.key" (or just key without a prefix), -1 for keys not in the schema
+        [[nodiscard]] constexpr int find(std::string_view prefix, std::string_view key) const noexcept
+        {
+            const int i = slots_[slotOf(detail::fieldHash(key, detail::fieldHashStart(prefix, seed_)))];
+            if (i < 0)
+                return -1;
+            const std::string_view name = fields_[static_cast<size_t>(i)].key;
+            if (prefix.empty())
+                return name == key ? i : -1;
+            return name.size() == prefix.size() + 1 + key.size() && name.substr(0, prefix.size()) == prefix &&
+                           name[prefix.size()] == '.' && name.substr(prefix.size() + 1) == key
+                       ? i
+                       : -1;
+        }
+    };
+
+    template <typename Record, size_t N>
+    [[nodiscard]] constexpr FieldTable<Record, N> makeFieldTable(const RecordField<Record> (&fields)[N])
+    {
+        return FieldTable<Record, N>(fields);
+    }
+
+    // Binds the object at the cursor into record. Values of other types than string (null
+    // included) leave the slot empty, and unknown keys are skipped without allocating.
+    template <typename Record, size_t N>
+    [[nodiscard]] bool bindRecord(JsonCursor &cursor, const FieldTable<Record, N> &table, Record &record,
+                                  std::string_view prefix = {})
+    {
+        if (!cursor.consume('{'))
+            return false;
+        if (cursor.consume('}'))
+            return true;
+        std::string escapedKey;
+        do
+        {
+            std::string_view key;
+            if (!cursor.string(key) || !cursor.consume(':'))
+                return false;
+            if (key.find('\\') != std::string_view::npos)
+            {
+                if (!detail::decodeJsonString(key, escapedKey))
+                    return false;
+                key = escapedKey;
+            }
+
+            const int index = table.find(prefix, key);
+            if (index < 0)
+            {
+                if (!cursor.skipValue())
+                    return false;
+                continue;
+            }
+            const RecordField<Record> &field = table.field(index);
+            if (!field.slot)
+            {
+                if (cursor.peek() == '{' ? !bindRecord(cursor, table, record, field.key) : !cursor.skipValue())
+                    return false;
+            }
+            else if (std::string_view raw; cursor.string(raw))
+            {
+                if (!detail::decodeJsonString(raw, record.*field.slot))
+                    return false;
+            }
+            else
+            {
+                (record.*field.slot).clear();
+                if (!cursor.skipValue())
+                    return false;
+            }
+        } while (cursor.consume(','));
+        return cursor.consume('}');
+    }
+
+    // Same binding from an already parsed object
+    template <typename Record, size_t N>
+    void bindRecord(const nlohmann::json &object, const FieldTable<Record, N> &table, Record &record,
+                    std::string_view prefix = {})
+    {
+        for (auto it = object.begin(); it != object.end(); ++it)
+        {
+            const int index = table.find(prefix, it.key());
+            if (index < 0)
+                continue;
+            const RecordField<Record> &field = table.field(index);
+            if (!field.slot)
+            {
+                if (it->is_object())
+                    bindRecord(*it, table, record, field.key);
+            }
+            else if (it->is_string())
+                record.*field.slot = it->template get_ref<const std::string &>();
+            else
+                (record.*field.slot).clear();
+        }
+    }
+
+    // Binds every object in the array under arrayKey of the root object. False if the text
+    // is malformed or has no such array; other members are skipped.
+    template <typename Record, size_t N>
+    [[nodiscard]] bool bindRecordArray(std::string_view text, std::string_view arrayKey, const FieldTable<Record, N> &table,
+                                       std::vector<Record> &records)
+    {
+        records.clear();
+        std::vector<uint32_t> index;
+        if (!indexJson(text, index))
+            return false;
+
+        JsonCursor cursor(text, index);
+        bool found = false;
+        if (!cursor.consume('{'))
+            return false;
+        if (!cursor.consume('}'))
+        {
+            std::string escapedKey;
+            do
+            {
+                std::string_view key;
+                if (!cursor.string(key) || !cursor.consume(':'))
+                    return false;
+                if (key.find('\\') != std::string_view::npos)
+                {
+                    if (!detail::decodeJsonString(key, escapedKey))
+                        return false;
+                    key = escapedKey;
+                }
+                if (key != arrayKey)
+                {
+                    if (!cursor.skipValue())
+                        return false;
+                    continue;
+                }
+
+                // A repeated key replaces the earlier value, as in nlohmann
+                records.clear();
+                found = cursor.peek() == '[';
+                if (!found)
+                {
+                    if (!cursor.skipValue())
+                        return false;
+                    continue;
+                }
+                cursor.consume('[');
+                if (cursor.consume(']'))
+                    continue;
+                do
+                {
+                    if (cursor.peek() != '{')
+                    {
+                        if (!cursor.skipValue())
+                            return false;
+                        continue;
+                    }
+                    if (!bindRecord(cursor, table, records.emplace_back()))
+                        return false;
+                } while (cursor.consume(','));
+                if (!cursor.consume(']'))
+                    return false;
+            } while (cursor.consume(','));
+            if (!cursor.consume('}'))
+                return false;
+        }
+        return found && cursor.atEnd();
+    }
+} // namespace UTIL
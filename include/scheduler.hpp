@@ -0,0 +1,237 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __SWITCH__
+#include <switch.h>
+#endif
+
+#include "trace.hpp"
+
+namespace UTIL
+{
+    // Highest first: the cursor's preview, then rows around it, then generation
+    enum class TaskPriority : uint8_t
+    {
+        Interactive,
+        Prefetch,
+        Batch,
+    };
+
+    inline constexpr int TASK_PRIORITY_COUNT = 3;
+#ifdef __SWITCH__
+    inline constexpr int SCHEDULER_MAX_WORKERS = 3; // application cores 0-2
+#else
+    inline constexpr int SCHEDULER_MAX_WORKERS = 8;
+#endif
+
+    struct SchedulerStats
+    {
+        uint64_t executed = 0;
+        uint64_t stolen = 0;
+    };
+
+    // Small work-stealing pool. Every worker owns one deque per priority; a worker runs its
+    // own oldest task of the highest non-empty priority, or steals the newest one of that
+    // priority from a sibling. Batch tasks are kept off one worker so that interactive
+    // work never queues behind a long generation job.
+    class Scheduler
+    {
+    public:
+        using Task = std::function<void()>;
+
+    private:
+        struct Worker
+        {
+            std::mutex mutex;
+            std::array<std::deque<Task>, TASK_PRIORITY_COUNT> queues;
+            std::thread thread;
+        };
+
+        std::vector<std::unique_ptr<Worker>> workers_;
+        std::mutex sleepMutex_;
+        std::condition_variable wake_;
+        std::atomic<size_t> queued_{0};
+        std::atomic<int> batchRunning_{0};
+        std::atomic<unsigned> nextWorker_{0};
+        std::atomic<uint64_t> executed_{0}, stolen_{0};
+        std::atomic<bool> stop_{false};
+
+        [[nodiscard]] int batchLimit() const noexcept { return std::max(1, static_cast<int>(workers_.size()) - 1); }
+
+        [[nodiscard]] bool take(std::deque<Task> &queue, bool newest, Task &task)
+        {
+            if (queue.empty())
+                return false;
+            if (newest)
+            {
+                task = std::move(queue.back());
+                queue.pop_back();
+            }
+            else
+            {
+                task = std::move(queue.front());
+                queue.pop_front();
+            }
+            return true;
+        }
+
+        [[nodiscard]] bool findTask(size_t self, Task &task, TaskPriority &priority)
+        {
+            for (int p = 0; p < TASK_PRIORITY_COUNT; ++p)
+            {
+                priority = static_cast<TaskPriority>(p);
+                if (priority == TaskPriority::Batch)
+                {
+                    // Claim a batch slot first so two workers cannot both take the last one
+                    if (batchRunning_.fetch_add(1, std::memory_order_acq_rel) >= batchLimit())
+                    {
+                        batchRunning_.fetch_sub(1, std::memory_order_acq_rel);
+                        return false;
+                    }
+                }
+
+                for (size_t i = 0; i < workers_.size(); ++i)
+                {
+                    const size_t victim = (self + i) % workers_.size();
+                    Worker &worker = *workers_[victim];
+                    std::lock_guard<std::mutex> lock(worker.mutex);
+                    if (take(worker.queues[p], victim != self, task))
+                    {
+                        queued_.fetch_sub(1, std::memory_order_acq_rel);
+                        if (victim != self)
+                            stolen_.fetch_add(1, std::memory_order_relaxed);
+                        return true;
+                    }
+                }
+
+                if (priority == TaskPriority::Batch)
+                    batchRunning_.fetch_sub(1, std::memory_order_acq_rel);
+            }
+            return false;
+        }
+
+        void run(size_t self)
+        {
+            tracer().nameThread("worker " + std::to_string(self));
+#ifdef __SWITCH__
+            const s32 core = static_cast<s32>(self % SCHEDULER_MAX_WORKERS);
+            svcSetThreadCoreMask(threadGetCurHandle(), core, 1ULL << core);
+#endif
+            // After stop the queues are still drained; a worker leaves once nothing is queued
+            while (true)
+            {
+                Task task;
+                TaskPriority priority = TaskPriority::Batch;
+                if (findTask(self, task, priority))
+                {
+                    task();
+                    executed_.fetch_add(1, std::memory_order_relaxed);
+                    if (priority == TaskPriority::Batch)
+                    {
+                        batchRunning_.fetch_sub(1, std::memory_order_acq_rel);
+                        {
+                            // A sleeper between its predicate check and the wait would miss it otherwise
+                            std::lock_guard<std::mutex> lock(sleepMutex_);
+                        }
+                        wake_.notify_all(); // a batch slot opened up
+                    }
+                    continue;
+                }
+
+                // Re-checked under the lock so a submit between findTask and here is not lost;
+                // queued batch work that cannot start yet waits for a finishing batch task
+                std::unique_lock<std::mutex> lock(sleepMutex_);
+                wake_.wait(lock, [this]
+                           { return (stop_.load(std::memory_order_acquire) && queued_.load(std::memory_order_acquire) == 0) ||
+                                    queued_.load(std::memory_order_acquire) > queuedBatch() ||
+                                    (queuedBatch() > 0 && batchRunning_.load(std::memory_order_acquire) < batchLimit()); });
+                if (stop_.load(std::memory_order_acquire) && queued_.load(std::memory_order_acquire) == 0)
+                    return;
+            }
+        }
+
+        [[nodiscard]] size_t queuedBatch()
+        {
+            size_t count = 0;
+            for (auto &worker : workers_)
+            {
+                std::lock_guard<std::mutex> lock(worker->mutex);
+                count += worker->queues[static_cast<int>(TaskPriority::Batch)].size();
+            }
+            return count;
+        }
+
+    public:
+        // workers = 0 picks one per core, capped at SCHEDULER_MAX_WORKERS
+        explicit Scheduler(int workers = 0)
+        {
+#ifdef __SWITCH__
+            if (workers <= 0)
+                workers = SCHEDULER_MAX_WORKERS;
+#else
+            if (workers <= 0)
+                workers = static_cast<int>(std::thread::hardware_concurrency());
+#endif
+            workers = std::clamp(workers, 1, SCHEDULER_MAX_WORKERS);
+
+            workers_.reserve(static_cast<size_t>(workers));
+            for (int i = 0; i < workers; ++i)
+                workers_.push_back(std::make_unique<Worker>());
+            for (size_t i = 0; i < workers_.size(); ++i)
+                workers_[i]->thread = std::thread([this, i]
+                                                  { run(i); });
+        }
+
+        // Every queued task still runs, including ones tasks submit while draining. Owners
+        // that submit from their own threads (Downloader, PreviewLoader) are destroyed first.
+        ~Scheduler()
+        {
+            {
+                std::lock_guard<std::mutex> lock(sleepMutex_);
+                stop_.store(true, std::memory_order_release);
+            }
+            wake_.notify_all();
+            for (auto &worker : workers_)
+                if (worker->thread.joinable())
+                    worker->thread.join();
+        }
+
+        Scheduler(const Scheduler &) = delete;
+        Scheduler &operator=(const Scheduler &) = delete;
+
+        // Any thread. Tasks are spread round-robin; idle workers steal the rest.
+        void submit(TaskPriority priority, Task task)
+        {
+            const size_t target = nextWorker_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+            {
+                std::lock_guard<std::mutex> lock(workers_[target]->mutex);
+                workers_[target]->queues[static_cast<int>(priority)].push_back(std::move(task));
+                queued_.fetch_add(1, std::memory_order_acq_rel);
+            }
+            {
+                std::lock_guard<std::mutex> lock(sleepMutex_);
+            }
+            wake_.notify_one();
+        }
+
+        [[nodiscard]] int workerCount() const noexcept { return static_cast<int>(workers_.size()); }
+        [[nodiscard]] size_t queued() const noexcept { return queued_.load(std::memory_order_acquire); }
+
+        [[nodiscard]] SchedulerStats stats() const noexcept
+        {
+            return {executed_.load(std::memory_order_relaxed), stolen_.load(std::memory_order_relaxed)};
+        }
+    };
+} // namespace UTIL
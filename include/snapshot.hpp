@@ -0,0 +1,51 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace UTIL
+{
+    // Single-producer/single-consumer latest-value mailbox. The writer fills back() and
+    // publishes it; the reader picks up the newest published value. A third slot sits
+    // between the two, so neither side ever waits and intermediate values are dropped.
+    template <typename T>
+    class SnapshotBuffer
+    {
+        static constexpr uint8_t INDEX_MASK = 0x3;
+        static constexpr uint8_t FRESH = 0x4;
+
+        std::array<T, 3> slots_{};
+        std::atomic<uint8_t> middle_{1};
+        uint8_t back_ = 0;  // owned by the writer
+        uint8_t front_ = 2; // owned by the reader
+
+    public:
+        SnapshotBuffer() = default;
+        SnapshotBuffer(const SnapshotBuffer &) = delete;
+        SnapshotBuffer &operator=(const SnapshotBuffer &) = delete;
+
+        // Writer side. Holds whatever was published two or more times ago, so callers
+        // can update it in place instead of rebuilding it.
+        [[nodiscard]] T &back() noexcept { return slots_[back_]; }
+
+        void publish() noexcept
+        {
+            back_ = middle_.exchange(static_cast<uint8_t>(back_ | FRESH), std::memory_order_acq_rel) & INDEX_MASK;
+        }
+
+        // Reader side
+        [[nodiscard]] bool fresh() const noexcept { return (middle_.load(std::memory_order_acquire) & FRESH) != 0; }
+
+        // Swap in the newest value; false when nothing was published since the last call
+        [[nodiscard]] bool acquire() noexcept
+        {
+            if (!fresh())
+                return false;
+            front_ = middle_.exchange(front_, std::memory_order_acq_rel) & INDEX_MASK;
+            return true;
+        }
+
+        [[nodiscard]] const T &front() const noexcept { return slots_[front_]; }
+    };
+} // namespace UTIL
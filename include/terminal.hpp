@@ -0,0 +1,560 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "framebuffer.hpp"
+#include "fontatlas.hpp"
+#include "snapshot.hpp"
+
+#ifdef __SWITCH__
+#include <sys/iosupport.h>
+#endif
+
+namespace UI
+{
+    struct Style
+    {
+        uint32_t fg;
+        uint32_t bg;
+
+        [[nodiscard]] bool operator==(const Style &o) const noexcept { return fg == o.fg && bg == o.bg; }
+        [[nodiscard]] bool operator!=(const Style &o) const noexcept { return !(*this == o); }
+    };
+
+    inline constexpr uint32_t COLOR_BACKGROUND = rgba(18, 18, 24);
+    inline constexpr Style STYLE_NORMAL{rgba(220, 220, 220), COLOR_BACKGROUND};
+    inline constexpr Style STYLE_ERROR{rgba(255, 110, 110), COLOR_BACKGROUND};
+    inline constexpr Style STYLE_HEADER{rgba(120, 200, 255), COLOR_BACKGROUND};
+    inline constexpr Style STYLE_CURSOR{rgba(255, 255, 255), rgba(50, 80, 140)};
+
+    struct FrameStats
+    {
+        uint64_t frames = 0;       // presents that touched the framebuffer
+        uint64_t skipped = 0;      // presents with nothing to draw
+        uint64_t coalesced = 0;    // published states replaced before they were drawn
+        int rowsDrawn = 0;         // in the last frame
+        uint64_t frameNs = 0;      // time spent in the last frame
+        uint64_t latencyNs = 0;    // input to framebuffer hand-off, last input frame
+        uint64_t maxLatencyNs = 0; // worst input latency seen so far
+    };
+
+    // Text grid rendered into the framebuffer from a pre-rasterized glyph atlas.
+    // Rows are only redrawn when their text or style differ from what that buffer
+    // already shows, so moving a highlight costs two rows, not a screen.
+    //
+    // Callers edit the grid on their own thread. present() either draws right away or,
+    // once startRendering() was called, publishes a snapshot to a render thread and
+    // returns; a slow frame then only delays the picture, never the caller.
+    class Terminal
+    {
+    public:
+        static constexpr int COLS = SCREEN_WIDTH / FONT::GLYPH_WIDTH;
+        static constexpr int ROWS = SCREEN_HEIGHT / FONT::GLYPH_HEIGHT;
+        static constexpr int TAB_WIDTH = 4;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Row
+        {
+            std::string text;
+            Style style = STYLE_NORMAL;
+            int styleCols = COLS; // columns past this use STYLE_NORMAL
+
+            [[nodiscard]] bool operator==(const Row &o) const noexcept
+            {
+                return style == o.style && styleCols == o.styleCols && text == o.text;
+            }
+            [[nodiscard]] bool operator!=(const Row &o) const noexcept { return !(*this == o); }
+        };
+
+        // Opaque pixels placed over the text grid, e.g. the preview panel. Immutable once
+        // built, so snapshots share it and buffers recognize it by address.
+        struct ImageLayer
+        {
+            int x = 0, y = 0, width = 0, height = 0;
+            std::vector<uint32_t> pixels;
+
+            [[nodiscard]] bool overlaps(int row) const noexcept
+            {
+                const int top = row * FONT::GLYPH_HEIGHT;
+                return top < y + height && top + FONT::GLYPH_HEIGHT > y;
+            }
+        };
+
+        using Rows = std::array<Row, ROWS>;
+        using ImagePtr = std::shared_ptr<const ImageLayer>;
+
+        // Everything the render thread needs for one frame
+        struct Snapshot
+        {
+            Rows rows;
+            ImagePtr image;
+            Clock::time_point input{}; // oldest input reflected in this state, if any
+            uint64_t serial = 0;
+        };
+
+        // Grid state, owned by the calling thread
+        Rows rows_;
+        ImagePtr image_;
+        bool dirty_ = true;
+        int cursorRow_ = 0, cursorCol_ = 0;
+        bool inEscape_ = false;
+        Clock::time_point pendingInput_{};
+        uint64_t serial_ = 0;
+
+        // Drawing state, owned by whichever thread presents
+        Framebuffer fb_;
+        std::array<Rows, FRAMEBUFFER_COUNT> drawn_;
+        std::array<bool, FRAMEBUFFER_COUNT> drawnValid_{};
+        std::array<ImagePtr, FRAMEBUFFER_COUNT> drawnImage_;
+        uint64_t drawnSerial_ = 0;
+
+        UTIL::SnapshotBuffer<Snapshot> snapshots_;
+        std::mutex wakeMutex_;
+        std::condition_variable wake_;
+        bool stopRendering_ = false;
+        std::thread renderer_;
+
+        mutable std::mutex statsMutex_;
+        FrameStats stats_;
+
+        // Text handed over by other threads, written out by the owner on its next present()
+        const std::thread::id owner_ = std::this_thread::get_id();
+        std::mutex inboxMutex_;
+        std::vector<std::pair<std::string, Style>> inbox_, inboxDrain_;
+        std::atomic<bool> inboxPending_{false};
+
+        // Glyph coverage unpacked to one byte (0-15) per pixel
+        [[nodiscard]] static const uint8_t *atlas() noexcept
+        {
+            static const auto unpacked = []
+            {
+                std::vector<uint8_t> out(static_cast<size_t>(FONT::CHAR_COUNT) * FONT::GLYPH_WIDTH * FONT::GLYPH_HEIGHT);
+                for (size_t i = 0; i < out.size(); i += 2)
+                {
+                    out[i] = FONT::GLYPHS[i / 2] >> 4;
+                    out[i + 1] = FONT::GLYPHS[i / 2] & 0x0F;
+                }
+                return out;
+            }();
+            return unpacked.data();
+        }
+
+        [[nodiscard]] static uint32_t blend(uint32_t fg, uint32_t bg, int level) noexcept
+        {
+            uint32_t out = 0xFF000000u;
+            for (int shift = 0; shift < 24; shift += 8)
+            {
+                const int f = (fg >> shift) & 0xFF, b = (bg >> shift) & 0xFF;
+                out |= static_cast<uint32_t>(b + (f - b) * level / 15) << shift;
+            }
+            return out;
+        }
+
+        static void drawRow(const Frame &frame, int r, const Row &row) noexcept
+        {
+            uint32_t styled[16], normal[16];
+            for (int level = 0; level < 16; ++level)
+            {
+                styled[level] = blend(row.style.fg, row.style.bg, level);
+                normal[level] = blend(STYLE_NORMAL.fg, STYLE_NORMAL.bg, level);
+            }
+
+            const uint8_t *glyphs = atlas();
+            uint32_t *origin = frame.pixels + static_cast<size_t>(r) * FONT::GLYPH_HEIGHT * static_cast<size_t>(frame.stride);
+            for (int col = 0; col < COLS; ++col)
+            {
+                const int c = col < static_cast<int>(row.text.size()) ? static_cast<unsigned char>(row.text[col]) : ' ';
+                const int idx = (c >= FONT::FIRST_CHAR && c < FONT::FIRST_CHAR + FONT::CHAR_COUNT) ? c - FONT::FIRST_CHAR : '?' - FONT::FIRST_CHAR;
+                const uint8_t *glyph = glyphs + static_cast<size_t>(idx) * FONT::GLYPH_WIDTH * FONT::GLYPH_HEIGHT;
+                const uint32_t *lut = col < row.styleCols ? styled : normal;
+                uint32_t *dst = origin + col * FONT::GLYPH_WIDTH;
+                for (int gy = 0; gy < FONT::GLYPH_HEIGHT; ++gy)
+                {
+                    for (int gx = 0; gx < FONT::GLYPH_WIDTH; ++gx)
+                        dst[gx] = lut[glyph[gx]];
+                    glyph += FONT::GLYPH_WIDTH;
+                    dst += frame.stride;
+                }
+            }
+        }
+
+        static void drawImage(const Frame &frame, const ImageLayer &image) noexcept
+        {
+            for (int y = 0; y < image.height; ++y)
+            {
+                const int sy = image.y + y;
+                if (sy < 0 || sy >= SCREEN_HEIGHT)
+                    continue;
+                const uint32_t *src = image.pixels.data() + static_cast<size_t>(y) * image.width;
+                uint32_t *dst = frame.pixels + static_cast<size_t>(sy) * frame.stride;
+                const int x0 = std::max(0, image.x), x1 = std::min(SCREEN_WIDTH, image.x + image.width);
+                if (x1 > x0)
+                    std::copy(src + (x0 - image.x), src + (x1 - image.x), dst + x0);
+            }
+        }
+
+        // Draw whatever differs from what the next buffer shows
+        void drawFrame(const Rows &rows, const ImagePtr &image, Clock::time_point input, uint64_t serial)
+        {
+            const auto start = Clock::now();
+            const Frame frame = fb_.begin();
+            if (!frame)
+                return;
+
+            auto &drawn = drawn_[frame.slot];
+            auto &shownImage = drawnImage_[frame.slot];
+            const bool full = !drawnValid_[frame.slot];
+            const bool imageChanged = shownImage != image;
+            bool imageTouched = false;
+            int rowsDrawn = 0;
+            for (int r = 0; r < ROWS; ++r)
+            {
+                // Rows the old or new image covers must be repainted when the image changes
+                const bool uncovered = imageChanged && ((shownImage && shownImage->overlaps(r)) || (image && image->overlaps(r)));
+                if (!full && !uncovered && drawn[r] == rows[r])
+                    continue;
+                drawRow(frame, r, rows[r]);
+                drawn[r] = rows[r];
+                imageTouched |= image && image->overlaps(r);
+                ++rowsDrawn;
+            }
+            if (image && (imageTouched || imageChanged))
+                drawImage(frame, *image);
+            shownImage = image;
+            drawnValid_[frame.slot] = true;
+            fb_.end();
+
+            const auto done = Clock::now();
+            std::lock_guard<std::mutex> lock(statsMutex_);
+            stats_.coalesced += serial > drawnSerial_ + 1 ? serial - drawnSerial_ - 1 : 0;
+            drawnSerial_ = serial;
+            stats_.rowsDrawn = rowsDrawn;
+            stats_.frameNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(done - start).count());
+            if (input != Clock::time_point{})
+            {
+                stats_.latencyNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(done - input).count());
+                stats_.maxLatencyNs = std::max(stats_.maxLatencyNs, stats_.latencyNs);
+            }
+            ++stats_.frames;
+        }
+
+        // Copy the grid into the writer's slot; rows already matching are left alone,
+        // which keeps their string storage and makes most publishes allocation-free
+        void publish()
+        {
+            Snapshot &snapshot = snapshots_.back();
+            for (int r = 0; r < ROWS; ++r)
+                if (snapshot.rows[r] != rows_[r])
+                    snapshot.rows[r] = rows_[r];
+            snapshot.image = image_;
+            snapshot.input = pendingInput_;
+            snapshot.serial = serial_;
+            snapshots_.publish();
+            {
+                std::lock_guard<std::mutex> lock(wakeMutex_);
+            }
+            wake_.notify_one();
+        }
+
+        void renderLoop()
+        {
+            for (;;)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(wakeMutex_);
+                    wake_.wait(lock, [this]
+                               { return stopRendering_ || snapshots_.fresh(); });
+                    if (stopRendering_ && !snapshots_.fresh())
+                        return;
+                }
+                if (snapshots_.acquire())
+                {
+                    const Snapshot &snapshot = snapshots_.front();
+                    drawFrame(snapshot.rows, snapshot.image, snapshot.input, snapshot.serial);
+                }
+            }
+        }
+
+        void newLine()
+        {
+            cursorCol_ = 0;
+            if (++cursorRow_ < ROWS)
+                return;
+            std::rotate(rows_.begin(), rows_.begin() + 1, rows_.end());
+            rows_.back() = {};
+            cursorRow_ = ROWS - 1;
+        }
+
+    public:
+        Terminal() = default;
+        ~Terminal() { stopRendering(); }
+
+        Terminal(const Terminal &) = delete;
+        Terminal &operator=(const Terminal &) = delete;
+
+        // Hand drawing over to a dedicated thread
+        void startRendering()
+        {
+            if (renderer_.joinable())
+                return;
+            stopRendering_ = false;
+            renderer_ = std::thread([this]
+                                    { renderLoop(); });
+        }
+
+        // Draw the last published state, then return drawing to present()
+        void stopRendering()
+        {
+            if (!renderer_.joinable())
+                return;
+            {
+                std::lock_guard<std::mutex> lock(wakeMutex_);
+                stopRendering_ = true;
+            }
+            wake_.notify_one();
+            renderer_.join();
+        }
+
+        [[nodiscard]] bool rendering() const noexcept { return renderer_.joinable(); }
+
+        // Stamp the next presented state as the response to an input event
+        void markInput() noexcept
+        {
+            if (pendingInput_ == Clock::time_point{})
+                pendingInput_ = Clock::now();
+        }
+
+        // Console-style output with wrapping and scrolling; escape sequences are skipped
+        void write(std::string_view text, const Style &style = STYLE_NORMAL)
+        {
+            for (const char c : text)
+            {
+                if (inEscape_)
+                {
+                    if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z'))
+                        inEscape_ = false;
+                    continue;
+                }
+                switch (c)
+                {
+                case '\x1b':
+                    inEscape_ = true;
+                    continue;
+                case '\n':
+                    newLine();
+                    continue;
+                case '\r':
+                    cursorCol_ = 0;
+                    continue;
+                case '\t':
+                    cursorCol_ = std::min(COLS - 1, (cursorCol_ / TAB_WIDTH + 1) * TAB_WIDTH);
+                    continue;
+                default:
+                    break;
+                }
+
+                if (cursorCol_ >= COLS)
+                    newLine();
+                Row &row = rows_[cursorRow_];
+                if (static_cast<int>(row.text.size()) <= cursorCol_)
+                    row.text.resize(static_cast<size_t>(cursorCol_) + 1, ' ');
+                row.text[cursorCol_++] = c;
+                row.style = style;
+                row.styleCols = COLS;
+            }
+            dirty_ = true;
+        }
+
+        // Replace a whole row, no-op when nothing changes. The style covers the first
+        // styleCols columns, e.g. to keep a highlight clear of a side panel.
+        void setLine(int row, std::string_view text, const Style &style = STYLE_NORMAL, int styleCols = COLS)
+        {
+            if (row < 0 || row >= ROWS)
+                return;
+            text = text.substr(0, COLS);
+            Row &dst = rows_[row];
+            if (dst.style == style && dst.styleCols == styleCols && dst.text == text)
+                return;
+            dst.text.assign(text.data(), text.size());
+            dst.style = style;
+            dst.styleCols = styleCols;
+            dirty_ = true;
+        }
+
+        void clear()
+        {
+            for (int r = 0; r < ROWS; ++r)
+                setLine(r, {});
+            cursorRow_ = cursorCol_ = 0;
+        }
+
+        void setCursor(int row, int col) noexcept
+        {
+            cursorRow_ = std::clamp(row, 0, ROWS - 1);
+            cursorCol_ = std::clamp(col, 0, COLS - 1);
+        }
+
+        // Show an RGBA image at a pixel position, composited over the background once here
+        void setImage(int x, int y, int width, int height, const uint8_t *pixels)
+        {
+            hideImage();
+            if (width <= 0 || height <= 0 || !pixels)
+                return;
+
+            auto image = std::make_shared<ImageLayer>();
+            image->x = x;
+            image->y = y;
+            image->width = width;
+            image->height = height;
+            image->pixels.resize(static_cast<size_t>(width) * height);
+            for (size_t i = 0; i < image->pixels.size(); ++i)
+            {
+                const uint8_t *p = pixels + i * 4;
+                image->pixels[i] = blend(rgba(p[0], p[1], p[2]), COLOR_BACKGROUND, (p[3] * 15 + 127) / 255);
+            }
+            image_ = std::move(image);
+            dirty_ = true;
+        }
+
+        void hideImage() noexcept
+        {
+            if (!image_)
+                return;
+            image_.reset();
+            dirty_ = true;
+        }
+
+        // Any thread. Queue console output for the thread that owns the terminal.
+        void post(std::string_view text, const Style &style = STYLE_NORMAL)
+        {
+            {
+                std::lock_guard<std::mutex> lock(inboxMutex_);
+                inbox_.emplace_back(std::string(text), style);
+            }
+            inboxPending_.store(true, std::memory_order_release);
+        }
+
+        [[nodiscard]] bool onOwnerThread() const noexcept { return std::this_thread::get_id() == owner_; }
+
+        // Show the current grid: drawn here, or handed to the render thread if one runs
+        void present()
+        {
+            if (inboxPending_.exchange(false, std::memory_order_acq_rel))
+            {
+                {
+                    std::lock_guard<std::mutex> lock(inboxMutex_);
+                    inboxDrain_.swap(inbox_);
+                }
+                for (const auto &[text, style] : inboxDrain_)
+                    write(text, style);
+                inboxDrain_.clear();
+            }
+
+            if (!dirty_)
+            {
+                std::lock_guard<std::mutex> lock(statsMutex_);
+                ++stats_.skipped;
+                return;
+            }
+
+            ++serial_;
+            if (rendering())
+                publish();
+            else
+                drawFrame(rows_, image_, pendingInput_, serial_);
+            pendingInput_ = {};
+            dirty_ = false;
+        }
+
+        [[nodiscard]] FrameStats stats() const
+        {
+            std::lock_guard<std::mutex> lock(statsMutex_);
+            return stats_;
+        }
+
+        // Only meaningful while no render thread is running
+        [[nodiscard]] const Framebuffer &framebuffer() const noexcept { return fb_; }
+    };
+
+    // Terminal used by the free functions below and by redirected stdio
+    [[nodiscard]] inline Terminal *&activeTerminal() noexcept
+    {
+        static Terminal *terminal = nullptr;
+        return terminal;
+    }
+
+    inline void present()
+    {
+        if (auto *terminal = activeTerminal())
+            terminal->present();
+    }
+
+    inline void clear()
+    {
+        if (auto *terminal = activeTerminal())
+            terminal->clear();
+    }
+
+    inline void markInput()
+    {
+        if (auto *terminal = activeTerminal())
+            terminal->markInput();
+    }
+
+#ifdef __SWITCH__
+    namespace detail
+    {
+        // Writes from other threads are queued instead of touching the grid directly
+        inline void consoleWrite(std::string_view text, const Style &style)
+        {
+            auto *terminal = activeTerminal();
+            if (!terminal)
+                return;
+            if (terminal->onOwnerThread())
+                terminal->write(text, style);
+            else
+                terminal->post(text, style);
+        }
+
+        inline ssize_t stdoutWrite(struct _reent *, void *, const char *ptr, size_t len)
+        {
+            consoleWrite({ptr, len}, STYLE_NORMAL);
+            return static_cast<ssize_t>(len);
+        }
+
+        inline ssize_t stderrWrite(struct _reent *, void *, const char *ptr, size_t len)
+        {
+            consoleWrite({ptr, len}, STYLE_ERROR);
+            return static_cast<ssize_t>(len);
+        }
+    } // namespace detail
+
+    // Route stdout/stderr into the active terminal, the way consoleInit does for the libnx console
+    inline void redirectStdio()
+    {
+        static devoptab_t out{}, err{};
+        out.name = err.name = "con";
+        out.write_r = detail::stdoutWrite;
+        err.write_r = detail::stderrWrite;
+        devoptab_list[STD_OUT] = &out;
+        devoptab_list[STD_ERR] = &err;
+        std::setvbuf(stdout, nullptr, _IONBF, 0);
+        std::setvbuf(stderr, nullptr, _IONBF, 0);
+    }
+#endif
+} // namespace UI
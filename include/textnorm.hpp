@@ -0,0 +1,308 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define AMIIBO_TEXTNORM_NEON 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define AMIIBO_TEXTNORM_SSE2 1
+#endif
+
+namespace UTIL
+{
+    // What foldText() produces
+    enum class TextForm : uint8_t
+    {
+        Display, // printable ASCII for the terminal font; anything else becomes '?'
+        Search,  // lower case without accents, punctuation collapsed to single spaces
+        Path,    // directory name: accents stripped, characters SD file systems reject removed, trimmed
+    };
+
+    namespace detail
+    {
+        // ASCII spelling of U+00A0..U+017F, empty where there is none
+        inline constexpr std::string_view LATIN_ASCII[] = {
+            " ", "!", "c", "L", "", "Y", "|", "",                // U+00A0
+            "", "(C)", "a", "\"", "", "-", "(R)", "",            // U+00A8
+            "", "+-", "2", "3", "", "u", "", ".",                // U+00B0
+            "", "1", "o", "\"", "1/4", "1/2", "3/4", "?",        // U+00B8
+            "A", "A", "A", "A", "A", "A", "AE", "C",             // U+00C0
+            "E", "E", "E", "E", "I", "I", "I", "I",              // U+00C8
+            "D", "N", "O", "O", "O", "O", "O", "x",              // U+00D0
+            "O", "U", "U", "U", "U", "Y", "TH", "ss",            // U+00D8
+            "a", "a", "a", "a", "a", "a", "ae", "c",             // U+00E0
+            "e", "e", "e", "e", "i", "i", "i", "i",              // U+00E8
+            "d", "n", "o", "o", "o", "o", "o", "/",              // U+00F0
+            "o", "u", "u", "u", "u", "y", "th", "y",             // U+00F8
+            "A", "a", "A", "a", "A", "a", "C", "c",              // U+0100
+            "C", "c", "C", "c", "C", "c", "D", "d",              // U+0108
+            "D", "d", "E", "e", "E", "e", "E", "e",              // U+0110
+            "E", "e", "E", "e", "G", "g", "G", "g",              // U+0118
+            "G", "g", "G", "g", "H", "h", "H", "h",              // U+0120
+            "I", "i", "I", "i", "I", "i", "I", "i",              // U+0128
+            "I", "i", "IJ", "ij", "J", "j", "K", "k",            // U+0130
+            "k", "L", "l", "L", "l", "L", "l", "L",              // U+0138
+            "l", "L", "l", "N", "n", "N", "n", "N",              // U+0140
+            "n", "'n", "N", "n", "O", "o", "O", "o",             // U+0148
+            "O", "o", "OE", "oe", "R", "r", "R", "r",            // U+0150
+            "R", "r", "S", "s", "S", "s", "S", "s",              // U+0158
+            "S", "s", "T", "t", "T", "t", "T", "t",              // U+0160
+            "U", "u", "U", "u", "U", "u", "U", "u",              // U+0168
+            "U", "u", "U", "u", "W", "w", "Y", "y",              // U+0170
+            "Y", "Z", "z", "Z", "z", "Z", "z", "s",              // U+0178
+        };
+        inline constexpr uint32_t LATIN_FIRST = 0xA0;
+
+        struct Transliteration
+        {
+            uint32_t codepoint;
+            std::string_view ascii;
+        };
+
+        // Punctuation that turns up in figure names, sorted by code point
+        inline constexpr Transliteration PUNCTUATION_ASCII[] = {
+            {0x2010, "-"}, {0x2011, "-"}, {0x2012, "-"}, {0x2013, "-"}, {0x2014, "-"}, {0x2018, "'"},
+            {0x2019, "'"}, {0x201C, "\""}, {0x201D, "\""}, {0x2022, "-"}, {0x2026, "..."}, {0x2122, "TM"},
+            {0x3000, " "},
+        };
+
+        // ASCII for a code point, empty if there is none. Full-width forms map onto
+        // the ASCII they stand for, using one byte of scratch.
+        [[nodiscard]] inline std::string_view asciiFor(uint32_t cp, char &scratch) noexcept
+        {
+            if (cp >= LATIN_FIRST && cp < LATIN_FIRST + std::size(LATIN_ASCII))
+                return LATIN_ASCII[cp - LATIN_FIRST];
+            if (cp >= 0xFF01 && cp <= 0xFF5E)
+            {
+                scratch = static_cast<char>(cp - 0xFEE0);
+                return {&scratch, 1};
+            }
+            for (const auto &entry : PUNCTUATION_ASCII)
+            {
+                if (entry.codepoint == cp)
+                    return entry.ascii;
+                if (entry.codepoint > cp)
+                    break;
+            }
+            return {};
+        }
+
+        // Length of the well-formed UTF-8 sequence at s (RFC 3629: no overlongs, surrogates
+        // or code points past U+10FFFF), 0 if it is not one
+        [[nodiscard]] inline size_t decodeUtf8(const uint8_t *s, size_t n, uint32_t &cp) noexcept
+        {
+            const uint8_t c = s[0];
+            if (c < 0x80)
+            {
+                cp = c;
+                return 1;
+            }
+
+            size_t len = 0;
+            uint8_t lo = 0x80, hi = 0xBF; // allowed range of the second byte
+            if (c >= 0xC2 && c <= 0xDF)
+                len = 2;
+            else if (c >= 0xE0 && c <= 0xEF)
+            {
+                len = 3;
+                if (c == 0xE0)
+                    lo = 0xA0;
+                else if (c == 0xED)
+                    hi = 0x9F;
+            }
+            else if (c >= 0xF0 && c <= 0xF4)
+            {
+                len = 4;
+                if (c == 0xF0)
+                    lo = 0x90;
+                else if (c == 0xF4)
+                    hi = 0x8F;
+            }
+            else
+                return 0;
+
+            if (n < len || s[1] < lo || s[1] > hi)
+                return 0;
+            cp = c & (0xFF >> (len + 1));
+            for (size_t k = 1; k < len; ++k)
+            {
+                if ((s[k] & 0xC0) != 0x80)
+                    return 0;
+                cp = cp << 6 | (s[k] & 0x3F);
+            }
+            return len;
+        }
+
+        // Characters FAT/exFAT reject, plus the punctuation names always had stripped
+        [[nodiscard]] constexpr bool unsafeInPath(char c) noexcept
+        {
+            switch (c)
+            {
+            case '!':
+            case '?':
+            case '.':
+            case ',':
+            case '\'':
+            case '\\':
+            case ':':
+            case '*':
+            case '"':
+            case '<':
+            case '>':
+            case '|':
+                return true;
+            default:
+                return static_cast<unsigned char>(c) < 0x20 || c == 0x7F;
+            }
+        }
+    } // namespace detail
+
+    // Length of the ASCII run at the start of text, 16 bytes per step where SIMD is available
+    [[nodiscard]] inline size_t asciiPrefix(std::string_view text) noexcept
+    {
+        const auto *s = reinterpret_cast<const uint8_t *>(text.data());
+        const size_t n = text.size();
+        size_t i = 0;
+#if defined(AMIIBO_TEXTNORM_NEON)
+        for (; i + 16 <= n; i += 16)
+            if (vmaxvq_u8(vld1q_u8(s + i)) >= 0x80)
+                break;
+#elif defined(AMIIBO_TEXTNORM_SSE2)
+        for (; i + 16 <= n; i += 16)
+        {
+            const int high = _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i)));
+            if (high)
+                return i + static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(high)));
+        }
+#else
+        for (; i + 8 <= n; i += 8)
+        {
+            uint64_t word;
+            std::memcpy(&word, s + i, sizeof(word));
+            if (word & 0x8080808080808080ULL)
+                break;
+        }
+#endif
+        while (i < n && s[i] < 0x80)
+            ++i;
+        return i;
+    }
+
+    [[nodiscard]] inline bool isAscii(std::string_view text) noexcept { return asciiPrefix(text) == text.size(); }
+
+    // Well-formed UTF-8 (RFC 3629). ASCII runs are skipped a vector at a time.
+    [[nodiscard]] inline bool validUtf8(std::string_view text) noexcept
+    {
+        const auto *s = reinterpret_cast<const uint8_t *>(text.data());
+        size_t i = 0;
+        for (;;)
+        {
+            i += asciiPrefix(text.substr(i));
+            if (i >= text.size())
+                return true;
+            uint32_t cp = 0;
+            const size_t len = detail::decodeUtf8(s + i, text.size() - i, cp);
+            if (len == 0)
+                return false;
+            i += len;
+        }
+    }
+
+    // One pass over text producing the requested form. Malformed UTF-8 is shown as '?' and
+    // otherwise dropped; code points without an ASCII spelling (CJK and the like) are kept
+    // for Search and Path and shown as '?'.
+    inline void foldText(std::string_view text, TextForm form, std::string &out)
+    {
+        out.clear();
+        out.reserve(text.size());
+        bool separated = true; // Search: last output was a separator (or nothing yet)
+
+        const auto put = [&](char c)
+        {
+            switch (form)
+            {
+            case TextForm::Display:
+                out += (c >= 0x20 && c < 0x7F) ? c : '?';
+                break;
+            case TextForm::Search:
+                if ((c >= '0' && c <= '9') || (c >= 'a' && c <= 'z'))
+                    out += c;
+                else if (c >= 'A' && c <= 'Z')
+                    out += static_cast<char>(c - 'A' + 'a');
+                else
+                {
+                    if (!separated)
+                        out += ' ';
+                    separated = true;
+                    break;
+                }
+                separated = false;
+                break;
+            case TextForm::Path:
+                if (c == '/')
+                    out += '_';
+                else if (!detail::unsafeInPath(c))
+                    out += c;
+                break;
+            }
+        };
+
+        const auto *s = reinterpret_cast<const uint8_t *>(text.data());
+        size_t i = 0;
+        while (i < text.size())
+        {
+            for (size_t end = i + asciiPrefix(text.substr(i)); i < end; ++i)
+                put(text[i]);
+            if (i >= text.size())
+                break;
+
+            uint32_t cp = 0;
+            const size_t len = detail::decodeUtf8(s + i, text.size() - i, cp);
+            if (len == 0)
+            {
+                if (form == TextForm::Display)
+                    out += '?';
+                ++i;
+                continue;
+            }
+
+            char scratch = 0;
+            if (const std::string_view ascii = detail::asciiFor(cp, scratch); !ascii.empty())
+            {
+                for (const char c : ascii)
+                    put(c);
+            }
+            else if (form == TextForm::Display)
+                out += '?';
+            else
+            {
+                out.append(text.data() + i, len);
+                separated = false;
+            }
+            i += len;
+        }
+
+        if (form == TextForm::Search && !out.empty() && out.back() == ' ')
+            out.pop_back();
+        if (form == TextForm::Path) // FAT drops trailing spaces, which would break lookups
+        {
+            const size_t first = out.find_first_not_of(' ');
+            out.erase(0, std::min(first, out.size()));
+            out.erase(out.find_last_not_of(' ') + 1);
+        }
+    }
+
+    [[nodiscard]] inline std::string foldText(std::string_view text, TextForm form)
+    {
+        std::string out;
+        foldText(text, form, out);
+        return out;
+    }
+} // namespace UTIL
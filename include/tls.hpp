@@ -0,0 +1,181 @@
+#pragma once
+
+#include <array>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include <curl/curl.h>
+
+#ifdef __SWITCH__
+#include <mbedtls/ssl.h>
+#include <mbedtls/x509_crt.h>
+#endif
+
+namespace UTIL
+{
+    inline constexpr std::string_view TLS_CA_BUNDLE_PATH = "sdmc:/config/AmiiboGenerator/cacert.pem";
+
+    struct TlsOptions
+    {
+        bool verify = true;                                     // check server certificates against caBundle
+        std::string caBundle = std::string(TLS_CA_BUNDLE_PATH); // PEM file, e.g. curl's cacert.pem
+    };
+
+    // State every curl handle shares: the CA bundle, read from the SD card once and handed
+    // to curl from memory, and a share handle holding TLS sessions and DNS answers, so a
+    // new connection to a host seen before resumes its session instead of a full handshake.
+    // With curl's mbedTLS backend (the Switch portlib) the bundle is also parsed only once:
+    // every handshake gets the same certificate chain instead of parsing the PEM text again.
+    class TlsContext
+    {
+        bool verify_ = true;
+        std::string caPath_; // named to curl when the bundle is unusable, so its error says where
+        std::string bundle_; // PEM text, empty when peers are not verified or there is none
+        size_t certificates_ = 0;
+        CURLSH *share_ = nullptr;
+        std::array<std::mutex, CURL_LOCK_DATA_LAST> locks_;
+#ifdef __SWITCH__
+        mbedtls_x509_crt chain_;
+        bool chainReady_ = false;
+
+        // CURLOPT_SSL_CTX_FUNCTION; runs after curl set up the handshake, so this chain wins
+        static CURLcode installChain(CURL *, void *config, void *self)
+        {
+            mbedtls_ssl_conf_ca_chain(static_cast<mbedtls_ssl_config *>(config), &static_cast<TlsContext *>(self)->chain_, nullptr);
+            return CURLE_OK;
+        }
+
+        // The callback's argument is backend-specific; only hand it over when curl says mbedTLS
+        [[nodiscard]] static bool curlUsesMbedTls() noexcept
+        {
+            const curl_version_info_data *info = curl_version_info(CURLVERSION_NOW);
+            return info && info->ssl_version && std::string_view(info->ssl_version).substr(0, 7) == "mbedTLS";
+        }
+
+        void parseChain()
+        {
+            mbedtls_x509_crt_free(&chain_);
+            mbedtls_x509_crt_init(&chain_);
+            // PEM input is parsed with its terminating NUL; a negative result means nothing was
+            // usable, a positive one counts certificates that were skipped
+            chainReady_ = curlUsesMbedTls() &&
+                          mbedtls_x509_crt_parse(&chain_, reinterpret_cast<const unsigned char *>(bundle_.c_str()), bundle_.size() + 1) >= 0;
+        }
+#endif
+
+        static void lock(CURL *, curl_lock_data data, curl_lock_access, void *self)
+        {
+            static_cast<TlsContext *>(self)->locks_[data].lock();
+        }
+
+        static void unlock(CURL *, curl_lock_data data, void *self)
+        {
+            static_cast<TlsContext *>(self)->locks_[data].unlock();
+        }
+
+    public:
+        TlsContext() : share_(curl_share_init())
+        {
+#ifdef __SWITCH__
+            mbedtls_x509_crt_init(&chain_);
+#endif
+            if (!share_)
+                return;
+            // Handles run on several threads (workers, the download loop), so curl has to lock
+            curl_share_setopt(share_, CURLSHOPT_LOCKFUNC, lock);
+            curl_share_setopt(share_, CURLSHOPT_UNLOCKFUNC, unlock);
+            curl_share_setopt(share_, CURLSHOPT_USERDATA, this);
+            curl_share_setopt(share_, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+            curl_share_setopt(share_, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+        }
+
+        // Only once no handle uses the share any more, i.e. at exit
+        ~TlsContext()
+        {
+            if (share_)
+                curl_share_cleanup(share_);
+#ifdef __SWITCH__
+            mbedtls_x509_crt_free(&chain_);
+#endif
+        }
+
+        TlsContext(const TlsContext &) = delete;
+        TlsContext &operator=(const TlsContext &) = delete;
+
+        // Call before the first transfer. False if verification was asked for but the
+        // bundle is missing or holds no certificate. Verification stays on regardless, so
+        // every HTTPS transfer then fails (CURLE_SSL_CACERT_BADFILE or a verification error);
+        // only options.verify = false turns the checks off.
+        bool configure(const TlsOptions &options)
+        {
+            bundle_.clear();
+            certificates_ = 0;
+            verify_ = options.verify;
+            caPath_ = options.caBundle;
+            if (!options.verify)
+                return true;
+
+            std::ifstream file(options.caBundle, std::ios::binary);
+            if (!file)
+                return false;
+            std::string text{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+            constexpr std::string_view BEGIN = "-----BEGIN CERTIFICATE-----";
+            for (size_t pos = text.find(BEGIN); pos != std::string::npos; pos = text.find(BEGIN, pos + BEGIN.size()))
+                ++certificates_;
+            if (certificates_ > 0)
+                bundle_ = std::move(text);
+#ifdef __SWITCH__
+            if (!bundle_.empty())
+                parseChain();
+#endif
+            return certificates_ > 0;
+        }
+
+        [[nodiscard]] bool verifying() const noexcept { return verify_; }
+        [[nodiscard]] size_t certificates() const noexcept { return certificates_; }
+
+        // TLS options for one handle
+        void apply(CURL *curl) const noexcept
+        {
+            if (share_)
+                curl_easy_setopt(curl, CURLOPT_SHARE, share_);
+            if (!verify_)
+            {
+                curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
+                curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0L);
+                return;
+            }
+            curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 1L);
+            curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 2L);
+            if (bundle_.empty())
+            {
+                // Fail closed: curl cannot load this either and refuses the handshake
+                curl_easy_setopt(curl, CURLOPT_CAINFO, caPath_.c_str());
+                return;
+            }
+#ifdef __SWITCH__
+            if (chainReady_)
+            {
+                // No file for curl to parse; the handshake gets the parsed chain instead
+                curl_easy_setopt(curl, CURLOPT_CAINFO, nullptr);
+                curl_easy_setopt(curl, CURLOPT_CAPATH, nullptr);
+                curl_easy_setopt(curl, CURLOPT_SSL_CTX_FUNCTION, installChain);
+                curl_easy_setopt(curl, CURLOPT_SSL_CTX_DATA, const_cast<TlsContext *>(this));
+                return;
+            }
+#endif
+            // No copy: the bundle outlives every handle
+            curl_blob blob{const_cast<char *>(bundle_.data()), bundle_.size(), CURL_BLOB_NOCOPY};
+            curl_easy_setopt(curl, CURLOPT_CAINFO_BLOB, &blob);
+        }
+    };
+
+    [[nodiscard]] inline TlsContext &tls()
+    {
+        static TlsContext context;
+        return context;
+    }
+} // namespace UTIL
@@ -0,0 +1,244 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace UTIL
+{
+    inline constexpr std::string_view TRACE_PATH = "sdmc:/emuiibo/trace.json";
+    inline constexpr size_t TRACE_THREAD_CAPACITY = 8192; // events per thread between dumps; later ones are dropped
+
+    // One recorded span. Names and categories must be string literals, only the pointers
+    // are stored.
+    struct TraceEvent
+    {
+        const char *name;
+        const char *category;
+        uint64_t begin;    // ns since the tracer started
+        uint64_t duration; // ns, complete events only
+        uint64_t id;       // async events only
+        int64_t arg;       // shown as args.n, -1 for none
+        char phase;        // 'X' complete, 'b' / 'e' async begin / end
+    };
+
+    // In-memory trace in Chrome's trace event format. Every thread appends to its own ring
+    // without locks; dumpChromeTrace() drains the rings from any thread. While disabled a
+    // trace point costs one relaxed load and a branch, and no ring is allocated.
+    class Tracer
+    {
+        // Single producer (the owning thread), single consumer (a dump)
+        struct Ring
+        {
+            std::unique_ptr<TraceEvent[]> events; // on the first event, so naming a thread costs nothing
+            std::atomic<size_t> head{0}, tail{0};
+            std::atomic<uint64_t> dropped{0};
+            uint32_t tid = 0;
+            std::string name;
+        };
+
+        std::atomic<bool> enabled_{false};
+        std::atomic<uint64_t> nextId_{1};
+        std::mutex mutex_; // rings_ and the consumer side of every ring
+        std::vector<std::shared_ptr<Ring>> rings_;
+        const std::chrono::steady_clock::time_point start_ = std::chrono::steady_clock::now();
+
+        [[nodiscard]] Ring &ring()
+        {
+            thread_local std::shared_ptr<Ring> ring;
+            if (!ring)
+            {
+                ring = std::make_shared<Ring>();
+                std::lock_guard<std::mutex> lock(mutex_);
+                ring->tid = static_cast<uint32_t>(rings_.size() + 1);
+                rings_.push_back(ring);
+            }
+            return *ring;
+        }
+
+        static void appendEscaped(std::string &out, std::string_view text)
+        {
+            for (const char c : text)
+            {
+                if (c == '"' || c == '\\')
+                    out += '\\';
+                if (static_cast<unsigned char>(c) >= 0x20)
+                    out += c;
+            }
+        }
+
+    public:
+        [[nodiscard]] bool enabled() const noexcept { return enabled_.load(std::memory_order_relaxed); }
+        void setEnabled(bool enabled) noexcept { enabled_.store(enabled, std::memory_order_relaxed); }
+
+        [[nodiscard]] uint64_t now() const noexcept
+        {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count());
+        }
+
+        // Ids pairing async begin and end events
+        [[nodiscard]] uint64_t newId() noexcept { return nextId_.fetch_add(1, std::memory_order_relaxed); }
+
+        void record(const TraceEvent &event)
+        {
+            Ring &r = ring();
+            if (!r.events)
+                r.events.reset(new TraceEvent[TRACE_THREAD_CAPACITY]);
+            const size_t head = r.head.load(std::memory_order_relaxed);
+            if (head - r.tail.load(std::memory_order_acquire) >= TRACE_THREAD_CAPACITY)
+            {
+                r.dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            r.events[head % TRACE_THREAD_CAPACITY] = event;
+            r.head.store(head + 1, std::memory_order_release);
+        }
+
+        // Label for the calling thread in the viewer; any time, traced or not
+        void nameThread(std::string name)
+        {
+            Ring &r = ring();
+            std::lock_guard<std::mutex> lock(mutex_);
+            r.name = std::move(name);
+        }
+
+        // Takes every event recorded so far out of the rings as a Chrome trace JSON document
+        // (chrome://tracing, ui.perfetto.dev). Events still being recorded show up next time.
+        [[nodiscard]] std::string drainChromeTrace(size_t *eventCount = nullptr, uint64_t *dropped = nullptr)
+        {
+            std::string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+            size_t count = 0;
+            uint64_t lost = 0;
+            bool first = true;
+            char buffer[160];
+            const auto separator = [&]
+            {
+                if (!first)
+                    out += ",\n";
+                first = false;
+            };
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const auto &ring : rings_)
+            {
+                if (!ring->name.empty())
+                {
+                    separator();
+                    std::snprintf(buffer, sizeof(buffer), "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"", ring->tid);
+                    out += buffer;
+                    appendEscaped(out, ring->name);
+                    out += "\"}}";
+                }
+
+                const size_t head = ring->head.load(std::memory_order_acquire);
+                for (size_t i = ring->tail.load(std::memory_order_relaxed); i < head; ++i, ++count)
+                {
+                    const TraceEvent &e = ring->events[i % TRACE_THREAD_CAPACITY];
+                    separator();
+                    out += "{\"name\":\"";
+                    appendEscaped(out, e.name);
+                    out += "\",\"cat\":\"";
+                    appendEscaped(out, e.category);
+                    // Microseconds with ns precision, as the format expects
+                    std::snprintf(buffer, sizeof(buffer), "\",\"ph\":\"%c\",\"pid\":1,\"tid\":%u,\"ts\":%llu.%03u", e.phase, ring->tid,
+                                  static_cast<unsigned long long>(e.begin / 1000), static_cast<unsigned>(e.begin % 1000));
+                    out += buffer;
+                    if (e.phase == 'X')
+                    {
+                        std::snprintf(buffer, sizeof(buffer), ",\"dur\":%llu.%03u", static_cast<unsigned long long>(e.duration / 1000),
+                                      static_cast<unsigned>(e.duration % 1000));
+                        out += buffer;
+                    }
+                    else
+                    {
+                        std::snprintf(buffer, sizeof(buffer), ",\"id\":\"0x%llx\"", static_cast<unsigned long long>(e.id));
+                        out += buffer;
+                    }
+                    if (e.arg >= 0)
+                    {
+                        std::snprintf(buffer, sizeof(buffer), ",\"args\":{\"n\":%lld}", static_cast<long long>(e.arg));
+                        out += buffer;
+                    }
+                    out += '}';
+                }
+                ring->tail.store(head, std::memory_order_release);
+                lost += ring->dropped.exchange(0, std::memory_order_relaxed);
+            }
+            out += "\n]}\n";
+            if (eventCount)
+                *eventCount = count;
+            if (dropped)
+                *dropped = lost;
+            return out;
+        }
+
+        // drainChromeTrace() into a file; false if it cannot be written
+        bool dumpChromeTrace(const std::string &path, size_t *eventCount = nullptr, uint64_t *dropped = nullptr)
+        {
+            const std::string text = drainChromeTrace(eventCount, dropped);
+            std::FILE *file = std::fopen(path.c_str(), "wb");
+            if (!file)
+                return false;
+            const bool ok = std::fwrite(text.data(), 1, text.size(), file) == text.size();
+            return std::fclose(file) == 0 && ok;
+        }
+    };
+
+    [[nodiscard]] inline Tracer &tracer()
+    {
+        static Tracer instance;
+        return instance;
+    }
+
+    // Times the enclosing block as one complete event
+    class TraceScope
+    {
+        const char *name_ = nullptr;
+        const char *category_ = nullptr;
+        int64_t arg_ = -1;
+        uint64_t begin_ = 0;
+
+    public:
+        TraceScope(const char *name, const char *category, int64_t arg = -1) noexcept
+        {
+            if (!tracer().enabled())
+                return;
+            name_ = name;
+            category_ = category;
+            arg_ = arg;
+            begin_ = tracer().now();
+        }
+
+        ~TraceScope()
+        {
+            if (name_)
+                tracer().record({name_, category_, begin_, tracer().now() - begin_, 0, arg_, 'X'});
+        }
+
+        TraceScope(const TraceScope &) = delete;
+        TraceScope &operator=(const TraceScope &) = delete;
+    };
+
+    // Spans that start and end on different threads or callbacks, e.g. a queued download.
+    // Returns the id to end it with, 0 while tracing is disabled.
+    [[nodiscard]] inline uint64_t traceAsyncBegin(const char *name, const char *category, int64_t arg = -1)
+    {
+        if (!tracer().enabled())
+            return 0;
+        const uint64_t id = tracer().newId();
+        tracer().record({name, category, tracer().now(), 0, id, arg, 'b'});
+        return id;
+    }
+
+    inline void traceAsyncEnd(uint64_t id, const char *name, const char *category)
+    {
+        if (id != 0)
+            tracer().record({name, category, tracer().now(), 0, id, -1, 'e'});
+    }
+} // namespace UTIL
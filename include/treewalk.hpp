@@ -0,0 +1,191 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+#ifdef __SWITCH__
+#include <switch.h>
+#endif
+
+#include "scheduler.hpp"
+
+namespace UTIL
+{
+    enum class WalkType : uint8_t
+    {
+        File,
+        Directory,
+        Other,
+    };
+
+    struct WalkEntry
+    {
+        std::string name;
+        uint64_t size = 0; // files only, and only when sizes were asked for
+        WalkType type = WalkType::Other;
+    };
+
+    // One listed directory. path is relative to the walk root ("" for the root itself,
+    // no trailing slash), depth 0 is the root.
+    struct WalkDirectory
+    {
+        std::string path;
+        int depth = 0;
+        std::vector<WalkEntry> entries;
+    };
+
+    // Decides whether a subdirectory gets listed; called from worker threads, possibly
+    // several at once. parent is the listed directory's relative path.
+    using WalkFilter = std::function<bool(std::string_view parent, const WalkEntry &directory, int depth)>;
+
+    namespace detail
+    {
+        [[nodiscard]] inline std::string joinWalkPath(std::string_view parent, std::string_view name)
+        {
+            std::string path(parent);
+            if (!path.empty() && path.back() != '/')
+                path += '/';
+            path += name;
+            return path;
+        }
+
+#ifdef __SWITCH__
+        // The SD card's own directory read reports type and size with every entry, so
+        // nothing is stat'ed. False for paths outside sdmc:/ or if the call fails.
+        [[nodiscard]] inline bool listSdDirectory(const std::string &path, bool sizes, std::vector<WalkEntry> &out)
+        {
+            constexpr std::string_view DEVICE = "sdmc:";
+            FsFileSystem *fs = path.compare(0, DEVICE.size(), DEVICE) == 0 ? fsdevGetDeviceFileSystem("sdmc") : nullptr;
+            if (!fs || path.size() - DEVICE.size() >= FS_MAX_PATH)
+                return false;
+
+            char fsPath[FS_MAX_PATH];
+            std::snprintf(fsPath, sizeof(fsPath), "%s", path.c_str() + DEVICE.size());
+            FsDir dir;
+            u32 mode = FsDirOpenMode_ReadDirs | FsDirOpenMode_ReadFiles;
+            if (!sizes)
+                mode |= FsDirOpenMode_NoFileSize;
+            if (R_FAILED(fsFsOpenDirectory(fs, fsPath, mode, &dir)))
+                return false;
+
+            FsDirectoryEntry batch[32];
+            s64 count = 0;
+            while (R_SUCCEEDED(fsDirRead(&dir, &count, std::size(batch), batch)) && count > 0)
+            {
+                for (s64 i = 0; i < count; ++i)
+                {
+                    const bool isDir = batch[i].type == FsDirEntryType_Dir;
+                    out.push_back({batch[i].name, isDir ? 0 : static_cast<uint64_t>(batch[i].file_size),
+                                   isDir ? WalkType::Directory : WalkType::File});
+                }
+            }
+            fsDirClose(&dir);
+            return true;
+        }
+#endif
+
+        // readdir's d_type where the file system fills it in; stat only for sizes or an
+        // unknown type
+        [[nodiscard]] inline bool listDirectory(const std::string &path, bool sizes, std::vector<WalkEntry> &out)
+        {
+#ifdef __SWITCH__
+            if (listSdDirectory(path, sizes, out))
+                return true;
+            out.clear();
+#endif
+            DIR *dir = opendir(path.c_str());
+            if (!dir)
+                return false;
+            while (const dirent *entry = readdir(dir))
+            {
+                const std::string_view name = entry->d_name;
+                if (name == "." || name == "..")
+                    continue;
+
+                WalkEntry item{std::string(name)};
+#ifdef DT_DIR
+                if (entry->d_type == DT_DIR)
+                    item.type = WalkType::Directory;
+                else if (entry->d_type == DT_REG)
+                    item.type = WalkType::File;
+                const bool known = entry->d_type != DT_UNKNOWN;
+#else
+                const bool known = false;
+#endif
+                if (!known || (sizes && item.type == WalkType::File))
+                {
+                    struct stat st{};
+                    if (stat(joinWalkPath(path, name).c_str(), &st) == 0)
+                    {
+                        item.type = S_ISDIR(st.st_mode) ? WalkType::Directory : S_ISREG(st.st_mode) ? WalkType::File : WalkType::Other;
+                        item.size = item.type == WalkType::File ? static_cast<uint64_t>(st.st_size) : 0;
+                    }
+                }
+                out.push_back(std::move(item));
+            }
+            closedir(dir);
+            return true;
+        }
+    } // namespace detail
+
+    // Lists root and every subdirectory the filter lets through, one scheduler task per
+    // directory, so sibling series are read in parallel. Blocks until done; call it from
+    // the UI thread, not from a scheduler task. Directories that cannot be opened are left
+    // out. The result is ordered by path.
+    [[nodiscard]] inline std::vector<WalkDirectory> walkTree(Scheduler &scheduler, std::string_view root, const WalkFilter &descend = {},
+                                                             bool sizes = false, TaskPriority priority = TaskPriority::Prefetch)
+    {
+        struct State
+        {
+            std::mutex mutex;
+            std::condition_variable done;
+            size_t pending = 0;
+            std::vector<WalkDirectory> results;
+        } state;
+
+        const std::string rootPath(root);
+        std::function<void(std::string, int)> visit = [&](std::string path, int depth)
+        {
+            WalkDirectory listed{std::move(path), depth, {}};
+            std::vector<std::string> children;
+            const bool opened = detail::listDirectory(detail::joinWalkPath(rootPath, listed.path), sizes, listed.entries);
+            if (opened)
+            {
+                for (const auto &entry : listed.entries)
+                    if (entry.type == WalkType::Directory && (!descend || descend(listed.path, entry, depth + 1)))
+                        children.push_back(detail::joinWalkPath(listed.path, entry.name));
+            }
+
+            std::lock_guard<std::mutex> lock(state.mutex);
+            state.pending += children.size();
+            for (auto &child : children)
+                scheduler.submit(priority, [&visit, child = std::move(child), depth]() mutable
+                                 { visit(std::move(child), depth + 1); });
+            if (opened)
+                state.results.push_back(std::move(listed));
+            if (--state.pending == 0)
+                state.done.notify_all();
+        };
+
+        state.pending = 1;
+        visit(std::string(), 0);
+        {
+            std::unique_lock<std::mutex> lock(state.mutex);
+            state.done.wait(lock, [&] { return state.pending == 0; });
+        }
+
+        std::sort(state.results.begin(), state.results.end(),
+                  [](const WalkDirectory &a, const WalkDirectory &b) { return a.path < b.path; });
+        return std::move(state.results);
+    }
+} // namespace UTIL
@@ -2,52 +2,77 @@
 
 #include <filesystem>
 #include <cstdio>
-#include <cstdarg>
+#include <cerrno>
 #include <string>
 #include <string_view>
 #include <memory>
 #include <stdexcept>
 #include <fstream>
 #include <utility>
-
+#include <algorithm>
+#include <functional>
+#include <vector>
+#include <array>
+#include <chrono>
+#include <random>
+#include <thread>
+
+#ifdef __SWITCH__
 #include <switch.h>
+#endif
 #include <curl/curl.h>
 
+#include "terminal.hpp"
+#include "logger.hpp"
 #include "libs/stb_image.h"
 #include "libs/stb_image_write.h"
 #include "libs/stb_image_resize2.h"
+#include "palette.hpp"
+#include "alphacrop.hpp"
+#include "boxresize.hpp"
+#include "progress.hpp"
+#include "allocprof.hpp"
+#include "tls.hpp"
+#include "trace.hpp"
 
 namespace UTIL
 {
     // Constants
     inline constexpr std::string_view EMUIIBO_PATH = "sdmc:/emuiibo/";
     inline constexpr std::string_view AMIIBO_DB_PATH = "sdmc:/emuiibo/amiibos.json";
+    inline constexpr std::string_view AMIIBO_FIGURES_PATH = "sdmc:/emuiibo/amiibo/";
     inline constexpr std::string_view AMIIBO_API_URL = "https://www.amiiboapi.org/api/amiibo/";
     inline constexpr int TARGET_IMAGE_HEIGHT = 150;
+    inline constexpr int MAX_IMAGE_HEIGHT = 1024;
     inline constexpr long CURL_TIMEOUT_SECONDS = 120L;
 
-    // Helper function to print error and update console
-    inline void printError(const char *format, ...)
+    namespace detail
+    {
+        template <typename... Args>
+        inline void logAndShow(LogLevel level, const char *format, const Args &...args)
+        {
+            logger().log(level, format, args...);
+            // The UI thread shows its own messages at once, e.g. right before it sleeps
+            if (auto *terminal = UI::activeTerminal(); terminal && terminal->onOwnerThread())
+            {
+                logger().flush();
+                UI::present();
+            }
+        }
+    } // namespace detail
+
+    // printf-style; the format must be a literal. Formatting and console output happen on the
+    // logger's flusher thread, so worker threads never wait on the console.
+    template <typename... Args>
+    inline void printError(const char *format, const Args &...args)
     {
-        char buffer[1024];
-        va_list args;
-        va_start(args, format);
-        vsnprintf(buffer, sizeof(buffer), format, args);
-        va_end(args);
-        std::fputs(buffer, stderr);
-        consoleUpdate(nullptr);
+        detail::logAndShow(LogLevel::Error, format, args...);
     }
 
-    // Helper function to print message and update console
-    inline void printMessage(const char *format, ...)
+    template <typename... Args>
+    inline void printMessage(const char *format, const Args &...args)
     {
-        char buffer[1024];
-        va_list args;
-        va_start(args, format);
-        vsnprintf(buffer, sizeof(buffer), format, args);
-        va_end(args);
-        std::fputs(buffer, stdout);
-        consoleUpdate(nullptr);
+        detail::logAndShow(LogLevel::Info, format, args...);
     }
 
     // Callback for curl file writing
@@ -61,6 +86,25 @@ namespace UTIL
         return bytes;
     }
 
+    // Callback for curl in-memory downloads
+    inline size_t memoryWriteCallback(void *ptr, size_t size, size_t nmemb, void *userdata) noexcept
+    {
+        auto *buffer = static_cast<std::vector<unsigned char> *>(userdata);
+        if (!buffer)
+            return 0;
+        const size_t bytes = size * nmemb;
+        try
+        {
+            const auto *data = static_cast<const unsigned char *>(ptr);
+            buffer->insert(buffer->end(), data, data + bytes);
+        }
+        catch (...)
+        {
+            return 0;
+        }
+        return bytes;
+    }
+
     // RAII wrapper for CURL handles
     class CurlHandle
     {
@@ -92,71 +136,111 @@ namespace UTIL
         [[nodiscard]] explicit operator bool() const noexcept { return handle_ != nullptr; }
     };
 
+    // Options shared by every transfer; url must outlive the handle's use
+    inline void configureCurl(CURL *curl, const std::string &url) noexcept
+    {
+        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+        curl_easy_setopt(curl, CURLOPT_TIMEOUT, CURL_TIMEOUT_SECONDS);
+        curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+        tls().apply(curl);
+        curl_easy_setopt(curl, CURLOPT_USERAGENT, "AmiiboGenerator/2.2");
+        curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+    }
+
+    // Result checks shared by blocking and multi transfers; the file is removed on failure.
+    // Returns 0 on success, the curl error code or -1 like downloadFile.
+    [[nodiscard]] inline int finishDownload(CURL *curl, CURLcode res, const std::string &path)
+    {
+        std::error_code ec;
+        if (res != CURLE_OK)
+        {
+            report(ProgressStage::Download, ProgressCode::NetworkError, res);
+            std::filesystem::remove(path, ec);
+            return static_cast<int>(res);
+        }
+
+        long http_code = 0;
+        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_code);
+        if (http_code != 200)
+        {
+            report(ProgressStage::Download, ProgressCode::HttpError, static_cast<int32_t>(http_code));
+            std::filesystem::remove(path, ec);
+            return -1;
+        }
+
+        curl_off_t download_size = 0;
+        curl_easy_getinfo(curl, CURLINFO_SIZE_DOWNLOAD_T, &download_size);
+        const auto bytes = static_cast<uint64_t>(download_size);
+        if (download_size < 100)
+        {
+            report(ProgressStage::Download, ProgressCode::TooSmall, 0, bytes);
+            std::filesystem::remove(path, ec);
+            return -1;
+        }
+
+        report(ProgressStage::Download, ProgressCode::Ok, 0, bytes);
+        return 0;
+    }
+
     // Download file with proper error handling
     [[nodiscard]] inline int downloadFile(std::string_view url, std::string_view path)
     {
         if (url.empty() || path.empty())
         {
-            printError("Error: empty URL or path provided to downloadFile\n");
+            report(ProgressStage::Download, ProgressCode::InvalidData);
             return -1;
         }
 
         CurlHandle curl;
         if (!curl)
         {
-            printError("Error: Failed to initialize CURL\n");
+            report(ProgressStage::Download, ProgressCode::NetworkError, CURLE_FAILED_INIT);
             return -1;
         }
 
         std::ofstream ofs(std::string(path), std::ios::binary);
         if (!ofs)
         {
-            printError("Error: Failed to open file for writing: %.*s\n", static_cast<int>(path.size()), path.data());
+            report(ProgressStage::Download, ProgressCode::IoError, errno);
             return -1;
         }
 
+        const TraceScope trace("download", "net");
+        const AllocPhaseScope phase(AllocPhase::Network);
+
         // Configure CURL options
-        curl_easy_setopt(curl.get(), CURLOPT_URL, std::string(url).c_str());
+        const std::string urlStr(url);
+        configureCurl(curl.get(), urlStr);
         curl_easy_setopt(curl.get(), CURLOPT_WRITEFUNCTION, writeCallback);
         curl_easy_setopt(curl.get(), CURLOPT_WRITEDATA, &ofs);
-        curl_easy_setopt(curl.get(), CURLOPT_TIMEOUT, CURL_TIMEOUT_SECONDS);
-        curl_easy_setopt(curl.get(), CURLOPT_FOLLOWLOCATION, 1L);
-        curl_easy_setopt(curl.get(), CURLOPT_SSL_VERIFYPEER, 0L);
-        curl_easy_setopt(curl.get(), CURLOPT_SSL_VERIFYHOST, 0L);
-        curl_easy_setopt(curl.get(), CURLOPT_USERAGENT, "AmiiboGenerator/2.2");
 
         const CURLcode res = curl_easy_perform(curl.get());
         ofs.close();
+        return finishDownload(curl.get(), res, std::string(path));
+    }
 
-        const std::string pathStr(path);
-        if (res != CURLE_OK)
-        {
-            printError("CURL error: %s\n", curl_easy_strerror(res));
-            std::filesystem::remove(pathStr);
-            return static_cast<int>(res);
-        }
+    // Download into memory without touching the console, safe to call from worker threads
+    [[nodiscard]] inline bool downloadToMemory(std::string_view url, std::vector<unsigned char> &out)
+    {
+        out.clear();
+        if (url.empty())
+            return false;
 
-        long http_code = 0;
-        curl_easy_getinfo(curl.get(), CURLINFO_RESPONSE_CODE, &http_code);
-        if (http_code != 200)
-        {
-            printError("HTTP error: %ld\n", http_code);
-            std::filesystem::remove(pathStr);
-            return -1;
-        }
+        CurlHandle curl;
+        if (!curl)
+            return false;
 
-        double download_size = 0;
-        curl_easy_getinfo(curl.get(), CURLINFO_SIZE_DOWNLOAD, &download_size);
-        printMessage("Downloaded: %.0f bytes\n", download_size);
+        const std::string urlStr(url);
+        configureCurl(curl.get(), urlStr);
+        curl_easy_setopt(curl.get(), CURLOPT_WRITEFUNCTION, memoryWriteCallback);
+        curl_easy_setopt(curl.get(), CURLOPT_WRITEDATA, &out);
 
-        if (download_size < 100)
-        {
-            printError("Downloaded file too small: %.0f bytes\n", download_size);
-            std::filesystem::remove(pathStr);
-            return -1;
-        }
+        if (curl_easy_perform(curl.get()) != CURLE_OK)
+            return false;
 
-        return 0;
+        long http_code = 0;
+        curl_easy_getinfo(curl.get(), CURLINFO_RESPONSE_CODE, &http_code);
+        return http_code == 200 && !out.empty();
     }
 
     [[nodiscard]] inline bool downloadAmiiboDatabase()
@@ -242,12 +326,37 @@ namespace UTIL
         }
     }
 
-    // Random number in range [nMin, nMax]
-    [[nodiscard]] inline int RandU(int nMin, int nMax) noexcept
+    namespace detail
+    {
+        // One generator per thread, so parallel figure tasks neither race nor share a sequence.
+        // Seeded from the system's entropy source, the clock and the thread id.
+        [[nodiscard]] inline std::mt19937 &randomEngine()
+        {
+            thread_local std::mt19937 engine = []
+            {
+                std::array<uint32_t, 6> seed{};
+#ifdef __SWITCH__
+                randomGet(seed.data(), 4 * sizeof(uint32_t));
+#else
+                std::random_device device;
+                for (size_t i = 0; i < 4; ++i)
+                    seed[i] = device();
+#endif
+                seed[4] = static_cast<uint32_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+                seed[5] = static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+                std::seed_seq sequence(seed.begin(), seed.end());
+                return std::mt19937(sequence);
+            }();
+            return engine;
+        }
+    } // namespace detail
+
+    // Random number in range [nMin, nMax]; safe to call from any thread
+    [[nodiscard]] inline int RandU(int nMin, int nMax)
     {
         if (nMin > nMax)
             std::swap(nMin, nMax);
-        return nMin + (std::rand() % (nMax - nMin + 1));
+        return std::uniform_int_distribution<int>(nMin, nMax)(detail::randomEngine());
     }
 
     // Endian swap for 16-bit values
@@ -301,60 +410,190 @@ namespace UTIL
         [[nodiscard]] int channels() const noexcept { return channels_; }
     };
 
-    [[nodiscard]] inline bool loadAndResizeImageInRatio(std::string_view imagePath)
+    // Resize filter tiers, fastest first
+    enum class ResizeQuality
+    {
+        Fast,   // integer box filter
+        Linear, // stb_image_resize on gamma-encoded values
+        High,   // stb_image_resize in linear light (sRGB-correct)
+    };
+
+    inline constexpr int RESIZE_QUALITY_COUNT = 3;
+    inline constexpr std::string_view RESIZE_QUALITY_NAMES[] = {"fast", "linear", "high"};
+
+    // Per-batch image output settings
+    struct ImageOptions
+    {
+        ResizeQuality quality = ResizeQuality::Linear;
+
+        bool paletted = false;       // 8-bit indexed PNG instead of 32-bit RGBA
+        bool cropTransparent = true; // trim fully transparent margins before resizing
+        int cropPadding = 2;         // margin kept around the figure, in output pixels
+
+        // Output heights; the first one is written to the given path, the rest next to it
+        std::vector<int> heights{TARGET_IMAGE_HEIGHT};
+    };
+
+    // "dir/amiibo.png" -> "dir/amiibo_64.png" for the secondary thumbnail sizes
+    [[nodiscard]] inline std::string thumbnailPath(std::string_view imagePath, int height)
+    {
+        const auto dot = imagePath.rfind('.');
+        const auto slash = imagePath.find_last_of('/');
+        const auto stemEnd = (dot == std::string_view::npos || (slash != std::string_view::npos && dot < slash))
+                                 ? imagePath.size()
+                                 : dot;
+        return std::string(imagePath.substr(0, stemEnd)) + "_" + std::to_string(height) +
+               std::string(imagePath.substr(stemEnd));
+    }
+
+    [[nodiscard]] inline bool resizeImage(const unsigned char *src, int srcWidth, int srcHeight, int srcStride,
+                                          unsigned char *dst, int dstWidth, int dstHeight, int channels,
+                                          ResizeQuality quality)
+    {
+        const auto layout = static_cast<stbir_pixel_layout>(channels);
+        switch (quality)
+        {
+        case ResizeQuality::Fast:
+            return resizeBoxUint8(src, srcWidth, srcHeight, srcStride, dst, dstWidth, dstHeight, channels);
+        case ResizeQuality::High:
+            return stbir_resize_uint8_srgb(src, srcWidth, srcHeight, srcStride,
+                                           dst, dstWidth, dstHeight, 0, layout) != nullptr;
+        case ResizeQuality::Linear:
+        default:
+            return stbir_resize_uint8_linear(src, srcWidth, srcHeight, srcStride,
+                                             dst, dstWidth, dstHeight, 0, layout) != nullptr;
+        }
+    }
+
+    // stbi_write_*_to_func sink collecting into a std::vector<uint8_t>
+    inline void appendPngBytes(void *context, void *data, int size)
+    {
+        auto *out = static_cast<std::vector<uint8_t> *>(context);
+        const auto *bytes = static_cast<const uint8_t *>(data);
+        out->insert(out->end(), bytes, bytes + size);
+    }
+
+    [[nodiscard]] inline bool writeThumbnail(std::string_view path, const unsigned char *pixels,
+                                             int width, int height, int channels, bool paletted)
+    {
+        const int pixelCount = width * height;
+
+        // Convert RGB to RGBA if needed
+        std::unique_ptr<unsigned char[]> rgba;
+        if (channels == 3)
+        {
+            rgba = std::make_unique<unsigned char[]>(pixelCount * 4);
+            for (int i = 0; i < pixelCount; ++i)
+            {
+                rgba[i * 4 + 0] = pixels[i * 3 + 0];
+                rgba[i * 4 + 1] = pixels[i * 3 + 1];
+                rgba[i * 4 + 2] = pixels[i * 3 + 2];
+                rgba[i * 4 + 3] = 255;
+            }
+            pixels = rgba.get();
+            channels = 4;
+        }
+
+        // Encoded in memory first, so the trace tells encoding and SD writes apart
+        std::vector<uint8_t> png;
+        {
+            const TraceScope trace("encode", "image", height);
+            if (paletted && channels == 4)
+                png = encodePalettedPng(quantizeRgba(pixels, width, height));
+            else
+                stbi_write_png_to_func(appendPngBytes, &png, width, height, channels, pixels, width * channels);
+        }
+        const TraceScope trace("write", "sd", height);
+        return writePngFile(path, png);
+    }
+
+    // Decode once, then build every requested size largest-first, each level resized from
+    // the previous one so extra sizes only cost a resize of an already small image.
+    [[nodiscard]] inline bool loadAndResizeImageInRatio(std::string_view imagePath, const ImageOptions &options = {})
     {
         if (imagePath.empty())
         {
-            printError("Error: empty image path\n");
+            report(ProgressStage::Decode, ProgressCode::InvalidData);
             return false;
         }
 
+        std::vector<int> levels;
+        for (const int h : options.heights)
+            if (h > 0 && std::find(levels.begin(), levels.end(), h) == levels.end())
+                levels.push_back(h);
+        if (levels.empty())
+            levels.push_back(TARGET_IMAGE_HEIGHT);
+        const int primaryHeight = levels.front();
+        std::sort(levels.begin(), levels.end(), std::greater<int>());
+
+        const TraceScope trace("image", "image");
+        const AllocPhaseScope phase(AllocPhase::Image);
         try
         {
-            ImageData img(imagePath);
-            const int newWidth = (TARGET_IMAGE_HEIGHT * img.width()) / img.height();
-            if (newWidth <= 0)
+            const ImageData img = [&]
             {
-                printError("Error: Invalid image dimensions for resizing\n");
-                return false;
+                const TraceScope decodeTrace("decode", "image");
+                return ImageData(imagePath);
+            }();
+            const int channels = img.channels();
+
+            // Resize straight out of the cropped window, no copy needed
+            CropRect src{0, 0, img.width(), img.height()};
+            if (options.cropTransparent)
+            {
+                const TraceScope cropTrace("crop", "image");
+                if (const auto bounds = findOpaqueBounds(img.get(), img.width(), img.height(), channels))
+                {
+                    const int padding = (std::max(options.cropPadding, 0) * bounds->height() + levels.front() - 1) / levels.front();
+                    src = padCropRect(*bounds, padding, img.width(), img.height());
+                }
             }
 
-            const int pixelCount = newWidth * TARGET_IMAGE_HEIGHT;
-            auto resized = std::make_unique<unsigned char[]>(pixelCount * img.channels());
+            const unsigned char *levelPixels = img.get() + (static_cast<size_t>(src.top) * img.width() + src.left) * channels;
+            int levelWidth = src.width(), levelHeight = src.height();
+            int levelStride = img.width() * channels;
+            std::unique_ptr<unsigned char[]> previous;
 
-            stbir_resize_uint8_linear(
-                img.get(), img.width(), img.height(), 0,
-                resized.get(), newWidth, TARGET_IMAGE_HEIGHT, 0,
-                static_cast<stbir_pixel_layout>(img.channels()));
+            bool ok = true;
+            for (const int height : levels)
+            {
+                const int width = (height * src.width()) / src.height();
+                if (width <= 0)
+                {
+                    report(ProgressStage::Resize, ProgressCode::ImageError, height);
+                    return false;
+                }
 
-            // Convert RGB to RGBA if needed
-            std::unique_ptr<unsigned char[]> finalData;
-            int finalChannels = img.channels();
+                auto resized = std::make_unique<unsigned char[]>(static_cast<size_t>(width) * height * channels);
+                {
+                    const TraceScope resizeTrace("resize", "image", height);
+                    if (!resizeImage(levelPixels, levelWidth, levelHeight, levelStride,
+                                     resized.get(), width, height, channels, options.quality))
+                    {
+                        report(ProgressStage::Resize, ProgressCode::ImageError, height);
+                        return false;
+                    }
+                }
 
-            if (img.channels() == 3)
-            {
-                finalData = std::make_unique<unsigned char[]>(pixelCount * 4);
-                for (int i = 0; i < pixelCount; ++i)
+                const std::string path = height == primaryHeight ? std::string(imagePath) : thumbnailPath(imagePath, height);
+                if (!writeThumbnail(path, resized.get(), width, height, channels, options.paletted))
                 {
-                    finalData[i * 4 + 0] = resized[i * 3 + 0];
-                    finalData[i * 4 + 1] = resized[i * 3 + 1];
-                    finalData[i * 4 + 2] = resized[i * 3 + 2];
-                    finalData[i * 4 + 3] = 255;
+                    report(ProgressStage::Write, ProgressCode::ImageError, height);
+                    ok = false;
                 }
-                finalChannels = 4;
-            }
-            else
-            {
-                finalData = std::move(resized);
-            }
 
-            const std::string pathStr(imagePath);
-            return stbi_write_png(pathStr.c_str(), newWidth, TARGET_IMAGE_HEIGHT,
-                                  finalChannels, finalData.get(), newWidth * finalChannels) != 0;
+                previous = std::move(resized);
+                levelPixels = previous.get();
+                levelWidth = width;
+                levelHeight = height;
+                levelStride = width * channels;
+            }
+            return ok;
         }
         catch (const std::exception &e)
         {
-            printError("Error loading/resizing image: %s\n", e.what());
+            printError("Image error: %s\n", e.what());
+            report(ProgressStage::Decode, ProgressCode::ImageError);
             return false;
         }
     }
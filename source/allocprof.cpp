@@ -0,0 +1,89 @@
+// Global operator new/delete replacements for the allocation profiler (make ALLOC_PROFILE=1).
+// Replacements must live in exactly one translation unit, so not in allocprof.hpp.
+#ifdef AMIIBO_ALLOC_PROFILE
+
+#include <cstdio>
+#include <new>
+
+#include "allocprof.hpp"
+
+void *operator new(std::size_t size)
+{
+    if (void *p = UTIL::trackedMalloc(size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    return UTIL::trackedMalloc(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+    return UTIL::trackedMalloc(size);
+}
+
+void operator delete(void *p) noexcept
+{
+    UTIL::trackedFree(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+    UTIL::trackedFree(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+    UTIL::trackedFree(p);
+}
+
+void operator delete[](void *p, std::size_t) noexcept
+{
+    UTIL::trackedFree(p);
+}
+
+void operator delete(void *p, const std::nothrow_t &) noexcept
+{
+    UTIL::trackedFree(p);
+}
+
+void operator delete[](void *p, const std::nothrow_t &) noexcept
+{
+    UTIL::trackedFree(p);
+}
+
+namespace
+{
+    // Constructed before every other static object, so destroyed after all of them and
+    // after the atexit handlers: whatever is still live then was never freed. Logs it per
+    // phase; nothing is printed when the totals balance.
+    struct ExitBalanceCheck
+    {
+        ~ExitBalanceCheck()
+        {
+            const UTIL::AllocStats totals = UTIL::allocTotals();
+            if (totals.live == 0 && totals.allocations == totals.frees)
+                return;
+            std::fprintf(stderr, "alloc profile: %lld bytes in %llu blocks still live at exit\n",
+                         static_cast<long long>(totals.live), static_cast<unsigned long long>(totals.allocations - totals.frees));
+            for (int i = 0; i < UTIL::ALLOC_PHASE_COUNT; ++i)
+            {
+                const UTIL::AllocStats stats = UTIL::allocStats(static_cast<UTIL::AllocPhase>(i));
+                if (stats.live != 0 || stats.allocations != stats.frees)
+                    std::fprintf(stderr, "  %-8.*s %lld bytes in %llu blocks\n", static_cast<int>(UTIL::ALLOC_PHASE_NAMES[i].size()),
+                                 UTIL::ALLOC_PHASE_NAMES[i].data(), static_cast<long long>(stats.live), static_cast<unsigned long long>(stats.allocations - stats.frees));
+            }
+        }
+    };
+
+    ExitBalanceCheck exitBalanceCheck __attribute__((init_priority(101)));
+} // namespace
+
+#endif
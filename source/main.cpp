@@ -1,21 +1,23 @@
 #include <fstream>
 #include <cstdlib>
-#include <ctime>
+#include <utility>
+#include <vector>
 
 #include <switch.h>
 
-#include "libs/json.hpp"
 #include "amiibomenu.hpp"
 #include "util.hpp"
-
-using json = nlohmann::json;
+#include "catalog.hpp"
+#include "config.hpp"
+#include "jsonindex.hpp"
+#include "terminal.hpp"
 
 namespace
 {
     void waitForExit(PadState &pad)
     {
         std::fputs("Press + to exit\n", stderr);
-        consoleUpdate(nullptr);
+        UI::present();
         while (appletMainLoop())
         {
             padUpdate(&pad);
@@ -28,27 +30,28 @@ namespace
 
 int main(int, char **)
 {
-    // Seed random number generator once
-    std::srand(static_cast<unsigned>(std::time(nullptr)));
-
-    consoleInit(nullptr);
+    UI::Terminal terminal;
+    UI::activeTerminal() = &terminal;
+    UI::redirectStdio();
+    terminal.startRendering();
+    UTIL::logger().setConsole(&terminal);
     std::puts("AmiiboGenerator Starting...");
-    consoleUpdate(nullptr);
+    UI::present();
 
     // Initialize sockets
     std::puts("Initializing sockets...");
-    consoleUpdate(nullptr);
+    UI::present();
     if (const Result rc = socketInitializeDefault(); R_FAILED(rc))
     {
         std::fprintf(stderr, "Error: Failed to initialize sockets (0x%x)\n", rc);
         std::fputs("Network features will not work\n", stderr);
-        consoleUpdate(nullptr);
+        UI::present();
         svcSleepThread(2000000000ULL);
     }
     else
     {
         std::puts("Sockets initialized successfully");
-        consoleUpdate(nullptr);
+        UI::present();
     }
 
     appletSetAutoSleepDisabled(true);
@@ -57,8 +60,24 @@ int main(int, char **)
     padConfigureInput(1, HidNpadStyleSet_NpadStandard);
     padInitializeDefault(&pad);
 
+    // Before the first download, which already needs the TLS settings
+    const UTIL::Config config = UTIL::loadConfig();
+    UTIL::logger().setLevel(config.log.level);
+    if (config.log.file && !UTIL::logger().setFile(std::string(UTIL::LOG_PATH)))
+        UTIL::printError("Warning: Failed to open log file\n");
+    if (!UTIL::tls().configure(config.tls))
+        UTIL::printError("Error: No CA certificates in %s - downloads will fail until a PEM bundle (e.g. curl's cacert.pem) "
+                         "is put there, or tls.verify is set to false\n",
+                         config.tls.caBundle);
+    else if (UTIL::tls().verifying())
+        std::printf("Verifying servers against %zu CA certificates\n", UTIL::tls().certificates());
+    else
+        UTIL::printError("Warning: tls.verify is off, servers are not verified\n");
+    UTIL::tracer().nameThread("main");
+    UTIL::tracer().setEnabled(config.trace.enabled);
+
     std::puts("Checking amiibo database...");
-    consoleUpdate(nullptr);
+    UI::present();
 
     if (!UTIL::checkAmiiboDatabase())
     {
@@ -68,29 +87,33 @@ int main(int, char **)
     else
     {
         std::puts("Opening database file...");
-        consoleUpdate(nullptr);
+        UI::present();
 
         const std::string dbPath(UTIL::AMIIBO_DB_PATH);
-        if (std::ifstream dbFile(dbPath); dbFile)
+        if (std::string dbText; UTIL::readTextFile(dbPath, dbText))
         {
             std::puts("Parsing database...");
-            consoleUpdate(nullptr);
+            UI::present();
 
-            json amiibodata;
-            dbFile >> amiibodata;
-            dbFile.close();
+            std::vector<UTIL::AmiiboRecord> amiibos;
+            bool loaded = false;
+            {
+                const UTIL::AllocPhaseScope phase(UTIL::AllocPhase::Load);
+                loaded = UTIL::loadCatalog(dbText, amiibos);
+                dbText = std::string();
+            }
 
-            if (!amiibodata.contains("amiibo"))
+            if (!loaded)
             {
                 std::fputs("Error: Invalid database format - missing 'amiibo' key\n", stderr);
                 waitForExit(pad);
             }
             else
             {
-                std::printf("Creating menu with %zu amiibos...\n", amiibodata["amiibo"].size());
-                consoleUpdate(nullptr);
+                std::printf("Creating menu with %zu amiibos...\n", amiibos.size());
+                UI::present();
 
-                AmiiboMenu menu(amiibodata);
+                AmiiboMenu menu(std::move(amiibos), config);
                 menu.mainLoop();
             }
         }
@@ -103,6 +126,8 @@ int main(int, char **)
 
     appletSetAutoSleepDisabled(false);
     socketExit();
-    consoleExit(nullptr);
+    UTIL::logger().flush();
+    UTIL::logger().setConsole(nullptr);
+    UI::activeTerminal() = nullptr;
     return 0;
 }
@@ -2,6 +2,19 @@
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #define STB_IMAGE_RESIZE2_IMPLEMENTATION
 
+#ifdef AMIIBO_ALLOC_PROFILE
+// Image buffers count towards the caller's phase like everything from operator new
+#include "allocprof.hpp"
+#define STBI_MALLOC(sz) UTIL::trackedMalloc(sz)
+#define STBI_REALLOC(p, newsz) UTIL::trackedRealloc(p, newsz)
+#define STBI_FREE(p) UTIL::trackedFree(p)
+#define STBIW_MALLOC(sz) UTIL::trackedMalloc(sz)
+#define STBIW_REALLOC(p, newsz) UTIL::trackedRealloc(p, newsz)
+#define STBIW_FREE(p) UTIL::trackedFree(p)
+#define STBIR_MALLOC(size, user_data) ((void)(user_data), UTIL::trackedMalloc(size))
+#define STBIR_FREE(ptr, user_data) ((void)(user_data), UTIL::trackedFree(ptr))
+#endif
+
 #include "libs/stb_image.h"
 #include "libs/stb_image_write.h"
 #include "libs/stb_image_resize2.h"
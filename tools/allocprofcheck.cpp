@@ -0,0 +1,146 @@
+// Host check for the allocation profiler: allocates and frees in every phase through
+// operator new, trackedRealloc and stb's allocator, on several threads, with blocks freed
+// on another thread and in another phase than they were allocated in. Afterwards every
+// phase and the totals must balance, and peaks must cover what was live at once.
+//
+// Usage: g++ -std=c++17 -O2 -DAMIIBO_ALLOC_PROFILE -Iinclude tools/allocprofcheck.cpp source/allocprof.cpp source/stb_impl.cpp -lpthread -o allocprofcheck
+//        ./allocprofcheck
+//
+// Exits non-zero if a phase does not balance.
+
+#ifndef AMIIBO_ALLOC_PROFILE
+#error "build with -DAMIIBO_ALLOC_PROFILE"
+#endif
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "allocprof.hpp"
+#include "libs/stb_image.h"
+
+// Defined in stb_impl.cpp, declared by stb_image_write.h only with the implementation
+extern "C" unsigned char *stbi_write_png_to_mem(const unsigned char *pixels, int stride_bytes, int x, int y, int n, int *out_len);
+
+namespace
+{
+    constexpr int THREADS = 4;
+
+    // Growing and shrinking buffers, as stb does while encoding
+    void reallocChain(size_t steps)
+    {
+        void *p = nullptr;
+        for (size_t i = 1; i <= steps; ++i)
+        {
+            p = UTIL::trackedRealloc(p, i * 97);
+            std::memset(p, static_cast<int>(i), i * 97);
+        }
+        for (size_t i = steps; i > 0; --i)
+            p = UTIL::trackedRealloc(p, i * 13);
+        UTIL::trackedFree(p);
+    }
+
+    // PNG encode to memory and decode again; stb mallocs, reallocs and frees internally
+    void pngRoundTrip(int size)
+    {
+        std::vector<unsigned char> pixels(static_cast<size_t>(size) * size * 4);
+        for (size_t i = 0; i < pixels.size(); ++i)
+            pixels[i] = static_cast<unsigned char>(i * 31 + i / 7);
+        int length = 0;
+        unsigned char *png = stbi_write_png_to_mem(pixels.data(), size * 4, size, size, 4, &length);
+        int w = 0, h = 0, channels = 0;
+        unsigned char *decoded = stbi_load_from_memory(png, length, &w, &h, &channels, 4);
+        UTIL::stbFree(png);
+        stbi_image_free(decoded);
+    }
+
+    void work(int thread)
+    {
+        {
+            UTIL::AllocPhaseScope phase(UTIL::AllocPhase::Load);
+            std::vector<std::string> names;
+            for (int i = 0; i < 2000; ++i)
+                names.push_back("a figure name long enough to allocate " + std::to_string(thread * 10000 + i));
+        }
+        {
+            UTIL::AllocPhaseScope phase(UTIL::AllocPhase::Network);
+            reallocChain(200);
+        }
+        {
+            UTIL::AllocPhaseScope phase(UTIL::AllocPhase::Image);
+            for (int i = 0; i < 5; ++i)
+                pngRoundTrip(64 + 32 * i);
+        }
+        {
+            // Nested: inner allocations go to Generate, the rest back to Render
+            UTIL::AllocPhaseScope render(UTIL::AllocPhase::Render);
+            auto outer = std::make_unique<char[]>(4096);
+            {
+                UTIL::AllocPhaseScope generate(UTIL::AllocPhase::Generate);
+                auto inner = std::make_unique<char[]>(8192);
+                reallocChain(20);
+            }
+            auto after = std::make_unique<char[]>(1024);
+        }
+    }
+} // namespace
+
+int main()
+{
+    UTIL::AllocStats before[UTIL::ALLOC_PHASE_COUNT];
+    for (int i = 0; i < UTIL::ALLOC_PHASE_COUNT; ++i)
+        before[i] = UTIL::allocStats(static_cast<UTIL::AllocPhase>(i));
+    const UTIL::AllocStats totalsBefore = UTIL::allocTotals();
+
+    {
+        // Allocated in Sort on this thread, freed on the workers in other phases
+        std::vector<std::unique_ptr<std::vector<int>>> handedOver(THREADS);
+        {
+            UTIL::AllocPhaseScope phase(UTIL::AllocPhase::Sort);
+            for (auto &block : handedOver)
+                block = std::make_unique<std::vector<int>>(100000);
+        }
+        std::vector<std::thread> threads;
+        for (int t = 0; t < THREADS; ++t)
+            threads.emplace_back([&, t]
+                                 {
+                                     work(t);
+                                     UTIL::AllocPhaseScope phase(UTIL::AllocPhase::Image);
+                                     handedOver[t].reset(); });
+        for (std::thread &thread : threads)
+            thread.join();
+    }
+
+    bool ok = true;
+    const auto check = [&](const char *name, const UTIL::AllocStats &was, const UTIL::AllocStats &now, bool used)
+    {
+        const uint64_t allocations = now.allocations - was.allocations, frees = now.frees - was.frees;
+        const int64_t live = now.live - was.live;
+        const bool balanced = allocations == frees && live == 0 && (!used || allocations > 0);
+        std::printf("%-8s %8llu allocations %8llu frees %12llu bytes, live %+lld, peak %lld%s\n", name,
+                    static_cast<unsigned long long>(allocations), static_cast<unsigned long long>(frees),
+                    static_cast<unsigned long long>(now.bytes - was.bytes), static_cast<long long>(live),
+                    static_cast<long long>(now.peak), balanced ? "" : "  UNBALANCED");
+        ok &= balanced;
+    };
+    for (int i = 0; i < UTIL::ALLOC_PHASE_COUNT; ++i)
+    {
+        const auto phase = static_cast<UTIL::AllocPhase>(i);
+        check(UTIL::ALLOC_PHASE_NAMES[i].data(), before[i], UTIL::allocStats(phase), phase != UTIL::AllocPhase::Other);
+    }
+    const UTIL::AllocStats totals = UTIL::allocTotals();
+    check("total", totalsBefore, totals, true);
+
+    // The Sort blocks were all live together before the workers freed them
+    const int64_t handedOverBytes = THREADS * 100000 * static_cast<int64_t>(sizeof(int));
+    if (UTIL::allocStats(UTIL::AllocPhase::Sort).peak < handedOverBytes || totals.peak < handedOverBytes)
+    {
+        std::fprintf(stderr, "peak below the %lld bytes live at once in sort\n", static_cast<long long>(handedOverBytes));
+        ok = false;
+    }
+    std::puts(ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,138 @@
+// Sample images for the host image benchmarks: PNG files named on the command line, or
+// synthetic figure renders roughly like AmiiboAPI's (a shaded, textured body with soft
+// edges and small details on a transparent background, a few hundred pixels tall).
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "libs/stb_image.h"
+
+namespace BENCH
+{
+    struct Image
+    {
+        std::string name;
+        int width = 0, height = 0;
+        std::vector<uint8_t> rgba;
+    };
+
+    namespace detail
+    {
+        [[nodiscard]] inline uint32_t hash(uint32_t x) noexcept
+        {
+            x ^= x >> 16;
+            x *= 0x7FEB352Du;
+            x ^= x >> 15;
+            x *= 0x846CA68Bu;
+            return x ^ (x >> 16);
+        }
+
+        // Smooth value noise in [-1, 1]
+        [[nodiscard]] inline float noise(float x, float y, uint32_t seed) noexcept
+        {
+            const int xi = static_cast<int>(std::floor(x)), yi = static_cast<int>(std::floor(y));
+            const float fx = x - xi, fy = y - yi;
+            const auto at = [&](int dx, int dy)
+            { return static_cast<float>(hash(seed ^ hash(static_cast<uint32_t>(xi + dx) * 73856093u ^ static_cast<uint32_t>(yi + dy) * 19349663u)) & 0xFFFF) / 32767.5f - 1.0f; };
+            const float sx = fx * fx * (3 - 2 * fx), sy = fy * fy * (3 - 2 * fy);
+            const float top = at(0, 0) + (at(1, 0) - at(0, 0)) * sx, bottom = at(0, 1) + (at(1, 1) - at(0, 1)) * sx;
+            return top + (bottom - top) * sy;
+        }
+    } // namespace detail
+
+    [[nodiscard]] inline Image syntheticFigure(int width, int height, uint32_t seed)
+    {
+        struct Part
+        {
+            float cx, cy, rx, ry;
+            float color[3];
+        };
+        std::vector<Part> parts;
+        const auto random = [&](float lo, float hi)
+        { return lo + (hi - lo) * static_cast<float>((seed = detail::hash(seed + 0x9E3779B9u)) & 0xFFFF) / 65535.0f; };
+        const float w = static_cast<float>(width), h = static_cast<float>(height);
+        const auto color = [&](Part &part)
+        {
+            for (float &c : part.color)
+                c = random(30, 235);
+        };
+        Part body{w * 0.5f, h * 0.62f, w * random(0.22f, 0.32f), h * 0.24f, {}};
+        Part head{w * 0.5f, h * 0.3f, w * random(0.2f, 0.28f), h * random(0.16f, 0.2f), {}};
+        Part base{w * 0.5f, h * 0.9f, w * 0.36f, h * 0.05f, {}};
+        for (Part *part : {&body, &head, &base})
+        {
+            color(*part);
+            parts.push_back(*part);
+        }
+        for (int i = 0; i < 4; ++i) // limbs and accessories
+        {
+            Part limb{w * random(0.2f, 0.8f), h * random(0.35f, 0.8f), w * random(0.05f, 0.1f), h * random(0.08f, 0.15f), {}};
+            color(limb);
+            parts.push_back(limb);
+        }
+        for (const float side : {-1.0f, 1.0f}) // eyes
+            parts.push_back({head.cx + side * head.rx * 0.4f, head.cy, w * 0.025f, h * 0.03f, {20, 20, 30}});
+
+        Image image{"synthetic " + std::to_string(width) + "x" + std::to_string(height), width, height, {}};
+        image.rgba.assign(static_cast<size_t>(width) * height * 4, 0);
+        const uint32_t texture = seed;
+        for (int y = 0; y < height; ++y)
+            for (int x = 0; x < width; ++x)
+            {
+                uint8_t *px = &image.rgba[(static_cast<size_t>(y) * width + x) * 4];
+                float coverage = 0, rgb[3] = {0, 0, 0};
+                for (const Part &part : parts) // later parts paint over earlier ones
+                {
+                    const float dx = (x + 0.5f - part.cx) / part.rx, dy = (y + 0.5f - part.cy) / part.ry;
+                    const float d = std::sqrt(dx * dx + dy * dy);
+                    // about 1.5 px of soft edge
+                    const float a = std::clamp((1.0f - d) * std::min(part.rx, part.ry) / 1.5f, 0.0f, 1.0f);
+                    if (a <= 0)
+                        continue;
+                    const float light = 0.55f + 0.45f * std::clamp(1.0f - (dx + 0.6f) * (dx + 0.6f) * 0.3f - (dy + 0.6f) * (dy + 0.6f) * 0.3f, 0.0f, 1.0f);
+                    const float grain = 14.0f * detail::noise(x * 0.15f, y * 0.15f, texture) + 6.0f * detail::noise(x * 0.7f, y * 0.7f, texture + 1);
+                    for (int c = 0; c < 3; ++c)
+                        rgb[c] = rgb[c] * (1 - a) + std::clamp(part.color[c] * light + grain, 0.0f, 255.0f) * a;
+                    coverage = coverage + a * (1 - coverage);
+                }
+                if (coverage <= 0)
+                    continue;
+                for (int c = 0; c < 3; ++c)
+                    px[c] = static_cast<uint8_t>(std::lround(std::clamp(rgb[c], 0.0f, 255.0f)));
+                px[3] = static_cast<uint8_t>(std::lround(coverage * 255.0f));
+            }
+        return image;
+    }
+
+    // Files from argv[first..], or a synthetic set at typical AmiiboAPI sizes
+    [[nodiscard]] inline std::vector<Image> corpus(int argc, char **argv, int first = 1)
+    {
+        std::vector<Image> images;
+        for (int i = first; i < argc; ++i)
+        {
+            int w = 0, h = 0, channels = 0;
+            unsigned char *pixels = stbi_load(argv[i], &w, &h, &channels, 4);
+            if (!pixels)
+            {
+                std::fprintf(stderr, "cannot load %s\n", argv[i]);
+                continue;
+            }
+            images.push_back({argv[i], w, h, std::vector<uint8_t>(pixels, pixels + static_cast<size_t>(w) * h * 4)});
+            stbi_image_free(pixels);
+        }
+        if (images.empty())
+        {
+            const int sizes[][2] = {{256, 320}, {300, 400}, {400, 480}, {480, 640}, {512, 512}, {640, 800}};
+            uint32_t seed = 1;
+            for (const auto &size : sizes)
+                for (int k = 0; k < 2; ++k)
+                    images.push_back(syntheticFigure(size[0], size[1], seed++));
+        }
+        return images;
+    }
+} // namespace BENCH
@@ -0,0 +1,108 @@
+// Host check for CollectionCoverage: incremental setInstalled updates must match a full
+// recount, and firstMissing / firstMember must match a plain scan.
+//
+// Usage: g++ -std=c++17 -O2 -Iinclude tools/coveragecheck.cpp -o coveragecheck && ./coveragecheck
+//
+// Exits non-zero on the first mismatch.
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "coverage.hpp"
+
+namespace
+{
+    struct Layout
+    {
+        const char *name;
+        size_t records, series;
+        bool grouped; // records ordered by series, as AmiiboMenu::setCatalog does
+    };
+
+    bool check(const Layout &layout, std::mt19937 &rng)
+    {
+        std::vector<uint32_t> seriesOf(layout.records);
+        for (size_t i = 0; i < seriesOf.size(); ++i)
+            seriesOf[i] = static_cast<uint32_t>(rng() % layout.series);
+        if (layout.grouped)
+            std::sort(seriesOf.begin(), seriesOf.end());
+
+        UTIL::CollectionCoverage coverage(seriesOf, layout.series);
+        UTIL::CollectionCoverage recounted(seriesOf, layout.series);
+        std::vector<bool> installed(layout.records, false);
+
+        // Generate and erase in rounds, each a few random records or a whole series
+        for (int round = 0; round < 200; ++round)
+        {
+            const bool value = rng() % 3 != 0;
+            if (round % 10 == 0)
+            {
+                const uint32_t series = static_cast<uint32_t>(rng() % layout.series);
+                for (size_t i = 0; i < seriesOf.size(); ++i)
+                    if (seriesOf[i] == series)
+                    {
+                        coverage.setInstalled(i, value);
+                        recounted.setInstalled(i, value);
+                        installed[i] = value;
+                    }
+            }
+            else
+            {
+                for (int k = 0; k < 50; ++k)
+                {
+                    const size_t i = rng() % layout.records;
+                    coverage.setInstalled(i, value);
+                    recounted.setInstalled(i, value);
+                    installed[i] = value;
+                }
+            }
+            recounted.recount();
+
+            for (size_t s = 0; s < layout.series; ++s)
+            {
+                uint32_t have = 0;
+                size_t missing = layout.records, member = layout.records;
+                for (size_t i = 0; i < seriesOf.size(); ++i)
+                {
+                    if (seriesOf[i] != s)
+                        continue;
+                    have += installed[i] ? 1 : 0;
+                    member = std::min(member, i);
+                    if (!installed[i])
+                        missing = std::min(missing, i);
+                }
+                if (coverage.installedIn(s) != have || recounted.installedIn(s) != have ||
+                    coverage.firstMissing(s) != missing || coverage.firstMember(s) != member)
+                {
+                    std::fprintf(stderr, "%s: series %zu after round %d: incremental %u, recount %u, expected %u; "
+                                         "first missing %zu (expected %zu), first member %zu (expected %zu)\n",
+                                 layout.name, s, round, coverage.installedIn(s), recounted.installedIn(s), have,
+                                 coverage.firstMissing(s), missing, coverage.firstMember(s), member);
+                    return false;
+                }
+            }
+        }
+
+        std::printf("%s: %zu records in %zu series, series bitmaps %zu words (installed %zu)\n", layout.name,
+                    layout.records, layout.series, coverage.memberWords(), (layout.records + 63) / 64);
+        return true;
+    }
+} // namespace
+
+int main()
+{
+    const Layout layouts[] = {
+        {"grouped", 1000, 60, true},
+        {"scattered", 1000, 60, false},
+        {"one series", 130, 1, true},
+        {"empty series", 300, 500, true},
+        {"large grouped", 20000, 120, true},
+    };
+    std::mt19937 rng(93);
+    for (const Layout &layout : layouts)
+        if (!check(layout, rng))
+            return 1;
+    std::puts("ok");
+    return 0;
+}
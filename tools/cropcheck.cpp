@@ -0,0 +1,160 @@
+// Host check for findOpaqueBounds: on synthetic grey+alpha and RGBA images of many sizes
+// (opaque pixels near the edges, on either side of the 4- and 16-pixel vector steps,
+// single pixels, faint alpha, empty images, rows that start at odd addresses) the result
+// must match a plain scan of every pixel. Also times the crop of a typical figure image.
+//
+// Usage: g++ -std=c++17 -O2 -Iinclude tools/cropcheck.cpp -o cropcheck && ./cropcheck
+//
+// Exits non-zero on the first mismatch.
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "alphacrop.hpp"
+
+namespace
+{
+    [[nodiscard]] std::optional<UTIL::CropRect> plainBounds(const uint8_t *data, int width, int height, int channels)
+    {
+        UTIL::CropRect rect{width, height, 0, 0};
+        for (int y = 0; y < height; ++y)
+            for (int x = 0; x < width; ++x)
+                if (data[(static_cast<size_t>(y) * width + x) * channels + channels - 1])
+                {
+                    rect.left = std::min(rect.left, x);
+                    rect.top = std::min(rect.top, y);
+                    rect.right = std::max(rect.right, x + 1);
+                    rect.bottom = std::max(rect.bottom, y + 1);
+                }
+        if (rect.right == 0)
+            return std::nullopt;
+        return rect;
+    }
+
+    [[nodiscard]] bool equal(const std::optional<UTIL::CropRect> &a, const std::optional<UTIL::CropRect> &b)
+    {
+        if (!a || !b)
+            return !a && !b;
+        return a->left == b->left && a->top == b->top && a->right == b->right && a->bottom == b->bottom;
+    }
+
+    // Image buffer starting `offset` bytes into its allocation, so rows are misaligned
+    struct Image
+    {
+        std::vector<uint8_t> storage;
+        size_t offset;
+        int width, height, channels;
+
+        Image(int w, int h, int c, size_t off) : storage(static_cast<size_t>(w) * h * c + off), offset(off), width(w), height(h), channels(c) {}
+        uint8_t *data() { return storage.data() + offset; }
+        void set(int x, int y, uint8_t alpha)
+        {
+            uint8_t *px = data() + (static_cast<size_t>(y) * width + x) * channels;
+            for (int c = 0; c < channels - 1; ++c)
+                px[c] = 0xAB; // colour under transparent pixels must not count
+            px[channels - 1] = alpha;
+        }
+    };
+
+    bool check(Image &image, const char *what)
+    {
+        const auto expected = plainBounds(image.data(), image.width, image.height, image.channels);
+        const auto actual = UTIL::findOpaqueBounds(image.data(), image.width, image.height, image.channels);
+        if (equal(expected, actual))
+            return true;
+        const auto show = [](const std::optional<UTIL::CropRect> &r, char *out, size_t size)
+        {
+            if (r)
+                std::snprintf(out, size, "[%d,%d)-[%d,%d)", r->left, r->top, r->right, r->bottom);
+            else
+                std::snprintf(out, size, "none");
+            return out;
+        };
+        char a[64], b[64];
+        std::fprintf(stderr, "%s: %dx%d, %d channels, offset %zu: found %s, expected %s\n", what, image.width, image.height,
+                     image.channels, image.offset, show(actual, a, sizeof(a)), show(expected, b, sizeof(b)));
+        return false;
+    }
+} // namespace
+
+int main()
+{
+    std::mt19937 rng(77);
+    int images = 0;
+    for (const int channels : {2, 4})
+        for (int width = 1; width <= 70; ++width)
+            for (const int height : {1, 2, 3, 17})
+                for (size_t offset = 0; offset < 4; ++offset)
+                {
+                    // Empty, then every single pixel of the first and last row and column
+                    Image empty(width, height, channels, offset);
+                    if (!check(empty, "empty"))
+                        return 1;
+                    for (int x = 0; x < width; ++x)
+                        for (const int y : {0, height - 1})
+                        {
+                            Image single(width, height, channels, offset);
+                            single.set(x, y, 1);
+                            if (!check(single, "single pixel"))
+                                return 1;
+                            ++images;
+                        }
+                    for (int y = 0; y < height; ++y)
+                        for (const int x : {0, width - 1, width / 2})
+                        {
+                            Image single(width, height, channels, offset);
+                            single.set(x, y, 255);
+                            if (!check(single, "single pixel"))
+                                return 1;
+                            ++images;
+                        }
+                    // A few random sparse pixels
+                    for (int round = 0; round < 4; ++round)
+                    {
+                        Image sparse(width, height, channels, offset);
+                        for (int k = 1 + static_cast<int>(rng() % 4); k > 0; --k)
+                            sparse.set(static_cast<int>(rng() % width), static_cast<int>(rng() % height), static_cast<uint8_t>(1 + rng() % 255));
+                        if (!check(sparse, "sparse"))
+                            return 1;
+                        ++images;
+                    }
+                }
+
+    // Figure-like images: an opaque blob inside a transparent border of random size
+    for (int round = 0; round < 2000; ++round)
+    {
+        const int width = 16 + static_cast<int>(rng() % 400), height = 16 + static_cast<int>(rng() % 400);
+        Image image(width, height, 4, rng() % 4);
+        const int left = static_cast<int>(rng() % width), top = static_cast<int>(rng() % height);
+        const int right = left + 1 + static_cast<int>(rng() % (width - left)), bottom = top + 1 + static_cast<int>(rng() % (height - top));
+        for (int y = top; y < bottom; ++y)
+            for (int x = left; x < right; ++x)
+                if (rng() % 8 != 0 || x == left || x == right - 1 || y == top || y == bottom - 1)
+                    image.set(x, y, static_cast<uint8_t>(rng() % 2 ? 255 : 1 + rng() % 254));
+        if (!check(image, "figure"))
+            return 1;
+        ++images;
+    }
+    std::printf("%d images match a plain scan\n", images);
+
+    // Typical AmiiboAPI image: 240x320 with the figure in the middle
+    Image figure(240, 320, 4, 0);
+    for (int y = 24; y < 300; ++y)
+        for (int x = 35 + (y % 7); x < 205 - (y % 5); ++x)
+            figure.set(x, y, 255);
+    constexpr int RUNS = 2000;
+    int sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int run = 0; run < RUNS; ++run)
+        sink += UTIL::findOpaqueBounds(figure.data(), 240, 320, 4)->width();
+    const double fast = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / RUNS;
+    start = std::chrono::steady_clock::now();
+    for (int run = 0; run < RUNS; ++run)
+        sink += plainBounds(figure.data(), 240, 320, 4)->width();
+    const double plain = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / RUNS;
+    std::printf("240x320 figure: findOpaqueBounds %.1f us, full scan %.1f us (checksum %d)\n", fast, plain, sink);
+    std::puts("ok");
+    return 0;
+}
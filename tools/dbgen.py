@@ -0,0 +1,334 @@
+#!/usr/bin/env python3
+"""Synthetic AmiiboAPI databases and images for scale and stress testing on the host.
+
+Usage: tools/dbgen.py generate [options] [-o amiibos.json]
+       tools/dbgen.py serve [options] [--db amiibos.json]
+
+generate writes an AmiiboAPI-shaped database ({"amiibo": [...]}) of any size.
+Series and characters follow a long-tailed distribution like the real dump,
+head/tail IDs are valid 8-digit hex, and configurable fractions of the records
+have non-ASCII names, are duplicates or are malformed. The same seed always
+gives the same file.
+
+serve runs a stand-in for amiiboapi.org and the image host. It serves the
+database at /api/amiibo/ and a synthetic RGBA PNG for every image URL the
+generator writes, /images/icon_<head>-<tail>.png, with a transparent border
+for the crop. Without --db it serves a database generated from the same
+options. Copy the database to sdmc:/emuiibo/amiibos.json with --image-base
+pointing at this server to fetch the images from it on the console. With
+--cert and --key it speaks HTTPS instead, e.g. for tools/tlsbench.cpp, and
+/stats reports how many requests came over full and resumed TLS handshakes.
+"""
+
+import argparse
+import hashlib
+import http.server
+import json
+import random
+import socketserver
+import ssl
+import struct
+import sys
+import threading
+import time
+import zlib
+
+SERIES = [
+    "Super Smash Bros.", "Super Mario Bros.", "Animal Crossing", "Splatoon", "The Legend of Zelda",
+    "Pokemon", "Kirby", "Fire Emblem", "Metroid", "Monster Hunter", "Yoshi's Woolly World",
+    "Chibi-Robo!", "Mario Sports Superstars", "Skylanders", "Shovel Knight", "Diablo",
+    "8-bit Mario", "Power Up Band", "Xenoblade Chronicles 3", "Street Fighter 6",
+]
+GAME_SERIES = [
+    "Super Mario", "The Legend of Zelda", "Animal Crossing", "Pokemon", "Kirby", "Fire Emblem",
+    "Metroid", "Splatoon", "Xenoblade", "Donkey Kong", "Yoshi's Woolly World", "Star Fox",
+    "Pikmin", "F-Zero", "Punch Out", "Wii Fit", "Mega Man", "Sonic", "Pac-man", "Street Fighter",
+]
+CHARACTERS = [
+    "Mario", "Luigi", "Peach", "Bowser", "Yoshi", "Toad", "Wario", "Link", "Zelda", "Ganondorf",
+    "Isabelle", "Tom Nook", "K.K.", "Pikachu", "Jigglypuff", "Kirby", "Meta Knight", "Marth",
+    "Ike", "Samus", "Inkling", "Octoling", "Shulk", "Donkey Kong", "Fox", "Olimar", "Captain Falcon",
+]
+SUFFIXES = [
+    "", "", "", "", " - Gold Edition", " - Silver Edition", " (Smash)", " - Wedding", " - Cat Costume",
+    " - Winter", " & Friends", " [Limited]", " - \"Special\"",
+]
+UNICODE_NAMES = [
+    "Pokémon Trainer", "Dédédé", "Zoë", "Ça va", "Bärbel", "Ñandú", "Æsir", "Crème Brûlée",
+    "ピカチュウ", "マリオ", "링크", "Ōkami", "Łucja", "Śnieg", "Ünal", "Γιάννης",
+    "Pokémon", "Star ★", "Heart ♥", "Party 🎉", "Ghost 👻",
+]
+TYPES = [("Figure", 0x00, 70), ("Card", 0x01, 25), ("Yarn", 0x02, 2), ("Band", 0x03, 3)]
+MALFORMED_KINDS = [
+    "missing_id", "short_head", "non_hex_tail", "null_name", "numeric_name", "bad_release",
+    "empty_object", "not_object", "array_field", "unknown_keys",
+]
+DEFAULT_IMAGE_BASE = "http://127.0.0.1:8080/images/"
+
+
+def zipf_weights(count, exponent):
+    return [1.0 / (rank + 1) ** exponent for rank in range(count)]
+
+
+def series_names(count):
+    """The known series first, then numbered ones for databases larger than reality."""
+    names = list(SERIES[:count])
+    for i in range(len(names), count):
+        names.append("Synthetic Series %d" % (i - len(SERIES) + 1))
+    return names
+
+
+def release(rng):
+    dates = {}
+    for region in ("au", "eu", "jp", "na"):
+        if rng.random() < 0.15:
+            dates[region] = None
+        else:
+            dates[region] = "%04d-%02d-%02d" % (rng.randint(2014, 2025), rng.randint(1, 12), rng.randint(1, 28))
+    return dates
+
+
+def figure_name(rng, character, unicode_rate):
+    if rng.random() < unicode_rate:
+        return rng.choice(UNICODE_NAMES) + rng.choice(SUFFIXES)
+    return character + rng.choice(SUFFIXES)
+
+
+def malformed(rng, record):
+    kind = rng.choice(MALFORMED_KINDS)
+    bad = dict(record)
+    if kind == "missing_id":
+        del bad[rng.choice(("head", "tail"))]
+    elif kind == "short_head":
+        bad["head"] = bad["head"][:5]
+    elif kind == "non_hex_tail":
+        bad["tail"] = "zz" + bad["tail"][2:]
+    elif kind == "null_name":
+        bad["name"] = None
+    elif kind == "numeric_name":
+        bad["name"] = rng.randint(0, 99999)
+    elif kind == "bad_release":
+        bad["release"] = "2020-01-01"
+    elif kind == "empty_object":
+        bad = {}
+    elif kind == "not_object":
+        bad = rng.choice(["amiibo", 42, None, ["head", "tail"]])
+    elif kind == "array_field":
+        bad["amiiboSeries"] = [bad["amiiboSeries"]]
+    else:
+        bad["unknownKey"] = {"nested": [1, 2, {"deeper": "value \\ with \"escapes\""}]}
+    return bad
+
+
+def generate(count, seed=1, series=60, unicode_rate=0.05, duplicate_rate=0.01, malformed_rate=0.005,
+             image_base=DEFAULT_IMAGE_BASE):
+    """A list of count AmiiboAPI records."""
+    rng = random.Random(seed)
+    names = series_names(max(1, series))
+    series_weights = zipf_weights(len(names), 1.1)
+    type_weights = [t[2] for t in TYPES]
+    character_weights = zipf_weights(len(CHARACTERS), 0.8)
+    used = set()
+    records = []
+    valid = []  # indices of well-formed records, the ones duplicates copy
+    while len(records) < count:
+        if valid and rng.random() < duplicate_rate:
+            # Exact copies and same-ID-different-name entries both happen upstream
+            copy = dict(records[rng.choice(valid)])
+            if rng.random() < 0.5:
+                copy["name"] += " (variant)"
+            records.append(copy)
+            continue
+
+        series_index = rng.choices(range(len(names)), series_weights)[0]
+        character_index = rng.choices(range(len(CHARACTERS)), character_weights)[0]
+        type_name, type_id, _ = rng.choices(TYPES, type_weights)[0]
+        while True:
+            # head: game and character (4), variant (2), type (2); tail: model (4), series (2), 02
+            head = "%04x%02x%02x" % (rng.randrange(0x10000), rng.randrange(0x100), type_id)
+            tail = "%04x%02x02" % (rng.randrange(0x10000), series_index % 0x100)
+            if (head, tail) not in used:
+                used.add((head, tail))
+                break
+        record = {
+            "amiiboSeries": names[series_index],
+            "character": CHARACTERS[character_index],
+            "gameSeries": GAME_SERIES[character_index % len(GAME_SERIES)],
+            "head": head,
+            "image": "%sicon_%s-%s.png" % (image_base, head, tail),
+            "name": figure_name(rng, CHARACTERS[character_index], unicode_rate),
+            "release": release(rng),
+            "tail": tail,
+            "type": type_name,
+        }
+        if rng.random() < malformed_rate:
+            record = malformed(rng, record)
+        else:
+            valid.append(len(records))
+        records.append(record)
+    return records
+
+
+def dump_database(records, ascii_only=False, compact=False):
+    if compact:
+        return json.dumps({"amiibo": records}, ensure_ascii=ascii_only, separators=(",", ":"))
+    return json.dumps({"amiibo": records}, ensure_ascii=ascii_only, indent=4, sort_keys=True)
+
+
+def png_chunk(tag, data):
+    return struct.pack(">I", len(data)) + tag + data + struct.pack(">I", zlib.crc32(tag + data) & 0xFFFFFFFF)
+
+
+def synthetic_png(key, size):
+    """An RGBA disc on a transparent background, colored and placed from key."""
+    digest = hashlib.sha1(key.encode()).digest()
+    r, g, b = digest[0], digest[1], digest[2]
+    margin = size // 8 + digest[3] % (size // 8 + 1)
+    center = size / 2.0
+    radius = center - margin
+    inside = bytes((r, g, b, 255))
+    edge = bytes((r // 2, g // 2, b // 2, 160))
+    outside = bytes(4)
+    rows = []
+    for y in range(size):
+        row = bytearray(b"\0")  # filter type: none
+        dy = y + 0.5 - center
+        for x in range(size):
+            dx = x + 0.5 - center
+            distance = (dx * dx + dy * dy) ** 0.5
+            row += inside if distance < radius - 1 else edge if distance < radius else outside
+        rows.append(bytes(row))
+    header = struct.pack(">IIBBBBB", size, size, 8, 6, 0, 0, 0)
+    return (b"\x89PNG\r\n\x1a\n" + png_chunk(b"IHDR", header) +
+            png_chunk(b"IDAT", zlib.compress(b"".join(rows), 6)) + png_chunk(b"IEND", b""))
+
+
+class StandIn(http.server.BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"  # keep-alive, like the real servers
+    database = b""
+    image_size = 256
+    delay = 0.0
+    fail_rate = 0.0
+    images = {}
+    images_lock = threading.Lock()
+    rng = random.Random(0)
+    handshakes = {"full": 0, "resumed": 0}  # per request, HTTPS only
+    handshakes_lock = threading.Lock()
+
+    def send_body(self, status, content_type, body):
+        self.send_response(status)
+        self.send_header("Content-Type", content_type)
+        self.send_header("Content-Length", str(len(body)))
+        self.end_headers()
+        self.wfile.write(body)
+
+    def do_GET(self):
+        if self.delay:
+            time.sleep(self.delay)
+        path = self.path.split("?", 1)[0]
+        if path == "/stats":
+            with self.handshakes_lock:
+                body = json.dumps(self.handshakes).encode("utf-8")
+            self.send_body(200, "application/json", body)
+            return
+        if hasattr(self.connection, "session_reused"):
+            with self.handshakes_lock:
+                self.handshakes["resumed" if self.connection.session_reused else "full"] += 1
+        if self.fail_rate and self.rng.random() < self.fail_rate:
+            self.send_body(503, "text/plain", b"synthetic failure\n")
+        elif path.rstrip("/") == "/api/amiibo":
+            self.send_body(200, "application/json", self.database)
+        elif path.startswith("/images/icon_") and path.endswith(".png"):
+            key = path[len("/images/icon_"):-len(".png")]
+            with self.images_lock:
+                png = self.images.get(key)
+            if png is None:
+                png = synthetic_png(key, self.image_size)
+                with self.images_lock:
+                    self.images[key] = png
+            self.send_body(200, "image/png", png)
+        else:
+            self.send_body(404, "text/plain", b"not found\n")
+
+    def log_message(self, fmt, *args):
+        if self.server.verbose:
+            super().log_message(fmt, *args)
+
+
+class Server(socketserver.ThreadingMixIn, http.server.HTTPServer):
+    daemon_threads = True
+    verbose = False
+
+
+def add_generate_options(parser):
+    parser.add_argument("--count", type=int, default=10000, help="records (default 10000)")
+    parser.add_argument("--seed", type=int, default=1)
+    parser.add_argument("--series", type=int, default=60, help="distinct amiibo series (default 60)")
+    parser.add_argument("--unicode-rate", type=float, default=0.05, help="fraction of non-ASCII names")
+    parser.add_argument("--duplicate-rate", type=float, default=0.01, help="fraction of repeated records")
+    parser.add_argument("--malformed-rate", type=float, default=0.005, help="fraction of broken records")
+    parser.add_argument("--image-base", default=DEFAULT_IMAGE_BASE, help="prefix of the image URLs")
+    parser.add_argument("--ascii", action="store_true", help="escape non-ASCII as \\uXXXX")
+    parser.add_argument("--compact", action="store_true", help="no indentation")
+
+
+def database_from(args):
+    records = generate(args.count, args.seed, args.series, args.unicode_rate, args.duplicate_rate,
+                       args.malformed_rate, args.image_base)
+    return dump_database(records, args.ascii, args.compact)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n", 1)[0])
+    commands = parser.add_subparsers(dest="command", required=True)
+    gen = commands.add_parser("generate", help="write a database")
+    add_generate_options(gen)
+    gen.add_argument("-o", "--output", help="file to write (default stdout)")
+    serve = commands.add_parser("serve", help="serve a database and its images")
+    add_generate_options(serve)
+    serve.add_argument("--db", help="database file to serve instead of a generated one")
+    serve.add_argument("--host", default="127.0.0.1")
+    serve.add_argument("--port", type=int, default=8080)
+    serve.add_argument("--image-size", type=int, default=256, help="edge of the square images (default 256)")
+    serve.add_argument("--delay-ms", type=float, default=0, help="latency added to every response")
+    serve.add_argument("--fail-rate", type=float, default=0, help="fraction of requests answered with 503")
+    serve.add_argument("--cert", help="PEM certificate chain; serve HTTPS with --key")
+    serve.add_argument("--key", help="PEM private key of --cert")
+    serve.add_argument("--verbose", action="store_true", help="log every request")
+    args = parser.parse_args()
+
+    if args.command == "generate":
+        text = database_from(args)
+        if args.output:
+            with open(args.output, "w", encoding="utf-8") as out:
+                out.write(text)
+        else:
+            sys.stdout.write(text)
+        return
+
+    if args.db:
+        with open(args.db, "rb") as db:
+            StandIn.database = db.read()
+    else:
+        StandIn.database = database_from(args).encode("utf-8")
+    StandIn.image_size = args.image_size
+    StandIn.delay = args.delay_ms / 1000.0
+    StandIn.fail_rate = args.fail_rate
+    server = Server((args.host, args.port), StandIn)
+    server.verbose = args.verbose
+    scheme = "http"
+    if args.cert:
+        context = ssl.SSLContext(ssl.PROTOCOL_TLS_SERVER)
+        context.load_cert_chain(args.cert, args.key)
+        server.socket = context.wrap_socket(server.socket, server_side=True)
+        scheme = "https"
+    print("Serving %d bytes of database on %s://%s:%d/api/amiibo/" % (len(StandIn.database), scheme, args.host, args.port),
+          file=sys.stderr)
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,271 @@
+#!/usr/bin/env python3
+"""Rasterize printable ASCII from a monospace TrueType font into include/fontatlas.hpp.
+
+Usage: tools/fontgen.py <font.ttf> [cell_width cell_height] > include/fontatlas.hpp
+
+Glyphs are stored as 4-bit coverage, two pixels per byte (high nibble first),
+one cell_width x cell_height tile per character. Only simple and offset/scale
+composite glyphs are supported, which covers ASCII in common fonts.
+"""
+
+import struct
+import sys
+
+FIRST_CHAR = 32
+LAST_CHAR = 126
+SUBSAMPLES = 16
+
+
+class Font:
+    def __init__(self, data):
+        self.data = data
+        num_tables = struct.unpack_from(">H", data, 4)[0]
+        self.tables = {}
+        for i in range(num_tables):
+            tag, _, offset, length = struct.unpack_from(">4sIII", data, 12 + i * 16)
+            self.tables[tag.decode("latin-1")] = (offset, length)
+
+        head = self.tables["head"][0]
+        self.units_per_em = struct.unpack_from(">H", data, head + 18)[0]
+        self.long_loca = struct.unpack_from(">h", data, head + 50)[0] == 1
+        self.num_glyphs = struct.unpack_from(">H", data, self.tables["maxp"][0] + 4)[0]
+
+        hhea = self.tables["hhea"][0]
+        self.ascender, self.descender = struct.unpack_from(">hh", data, hhea + 4)
+        num_hmetrics = struct.unpack_from(">H", data, hhea + 34)[0]
+        self.advances = [struct.unpack_from(">H", data, self.tables["hmtx"][0] + i * 4)[0] for i in range(num_hmetrics)]
+        self.cmap = self._parse_cmap()
+
+    def _parse_cmap(self):
+        base = self.tables["cmap"][0]
+        count = struct.unpack_from(">H", self.data, base + 2)[0]
+        for i in range(count):
+            platform, encoding, offset = struct.unpack_from(">HHI", self.data, base + 4 + i * 8)
+            sub = base + offset
+            if struct.unpack_from(">H", self.data, sub)[0] == 4 and (platform, encoding) in ((3, 1), (0, 3), (0, 4)):
+                return self._parse_format4(sub)
+        raise ValueError("no format 4 cmap subtable")
+
+    def _parse_format4(self, sub):
+        seg_x2 = struct.unpack_from(">H", self.data, sub + 6)[0]
+        ends = sub + 14
+        starts = ends + seg_x2 + 2
+        deltas = starts + seg_x2
+        ranges = deltas + seg_x2
+        mapping = {}
+        for s in range(seg_x2 // 2):
+            end = struct.unpack_from(">H", self.data, ends + s * 2)[0]
+            start = struct.unpack_from(">H", self.data, starts + s * 2)[0]
+            delta = struct.unpack_from(">h", self.data, deltas + s * 2)[0]
+            range_offset = struct.unpack_from(">H", self.data, ranges + s * 2)[0]
+            for c in range(max(start, FIRST_CHAR), min(end, LAST_CHAR) + 1):
+                if range_offset == 0:
+                    mapping[c] = (c + delta) & 0xFFFF
+                else:
+                    addr = ranges + s * 2 + range_offset + (c - start) * 2
+                    glyph = struct.unpack_from(">H", self.data, addr)[0]
+                    mapping[c] = (glyph + delta) & 0xFFFF if glyph else 0
+        return mapping
+
+    def _glyph_range(self, glyph):
+        loca = self.tables["loca"][0]
+        if self.long_loca:
+            start, end = struct.unpack_from(">II", self.data, loca + glyph * 4)
+        else:
+            start, end = (v * 2 for v in struct.unpack_from(">HH", self.data, loca + glyph * 2))
+        return self.tables["glyf"][0] + start, end - start
+
+    def contours(self, glyph):
+        """List of contours, each a list of (x, y, on_curve) in font units."""
+        offset, length = self._glyph_range(glyph)
+        if length == 0:
+            return []
+        num_contours = struct.unpack_from(">h", self.data, offset)[0]
+        if num_contours < 0:
+            return self._composite(offset + 10)
+
+        end_pts = struct.unpack_from(">%dH" % num_contours, self.data, offset + 10)
+        num_points = end_pts[-1] + 1 if num_contours else 0
+        pos = offset + 10 + num_contours * 2
+        pos += 2 + struct.unpack_from(">H", self.data, pos)[0]
+
+        flags = []
+        while len(flags) < num_points:
+            flag = self.data[pos]
+            pos += 1
+            flags.append(flag)
+            if flag & 8:
+                flags.extend([flag] * self.data[pos])
+                pos += 1
+
+        def read_coords(short_bit, same_bit):
+            nonlocal pos
+            coords, value = [], 0
+            for flag in flags:
+                if flag & short_bit:
+                    delta = self.data[pos]
+                    pos += 1
+                    value += delta if flag & same_bit else -delta
+                elif not flag & same_bit:
+                    value += struct.unpack_from(">h", self.data, pos)[0]
+                    pos += 2
+                coords.append(value)
+            return coords
+
+        xs = read_coords(2, 16)
+        ys = read_coords(4, 32)
+        result, start = [], 0
+        for end in end_pts:
+            result.append([(xs[i], ys[i], bool(flags[i] & 1)) for i in range(start, end + 1)])
+            start = end + 1
+        return result
+
+    def _composite(self, pos):
+        result = []
+        while True:
+            flags, glyph = struct.unpack_from(">HH", self.data, pos)
+            pos += 4
+            if flags & 1:
+                dx, dy = struct.unpack_from(">hh", self.data, pos)
+                pos += 4
+            else:
+                dx, dy = struct.unpack_from(">bb", self.data, pos)
+                pos += 2
+            if not flags & 2:
+                raise ValueError("point-matched composite glyphs are not supported")
+            a, b, c, d = 1.0, 0.0, 0.0, 1.0
+            if flags & 8:
+                a = d = struct.unpack_from(">h", self.data, pos)[0] / 16384.0
+                pos += 2
+            elif flags & 0x40:
+                a, d = (v / 16384.0 for v in struct.unpack_from(">hh", self.data, pos))
+                pos += 4
+            elif flags & 0x80:
+                a, b, c, d = (v / 16384.0 for v in struct.unpack_from(">hhhh", self.data, pos))
+                pos += 8
+            for contour in self.contours(glyph):
+                result.append([(x * a + y * c + dx, x * b + y * d + dy, on) for x, y, on in contour])
+            if not flags & 0x20:
+                return result
+
+
+def flatten(contour, steps=8):
+    """Turn a quadratic TrueType contour into a closed polyline."""
+    points = []
+    n = len(contour)
+    # Start from an on-curve point, synthesizing one if the contour has none
+    start = next((i for i, p in enumerate(contour) if p[2]), None)
+    if start is None:
+        a, b = contour[0], contour[1]
+        contour = [((a[0] + b[0]) / 2, (a[1] + b[1]) / 2, True)] + contour[1:] + contour[:1]
+        start, n = 0, len(contour)
+    ordered = contour[start:] + contour[:start] + [contour[start]]
+
+    current = ordered[0][:2]
+    points.append(current)
+    control = None
+    for x, y, on in ordered[1:]:
+        if on:
+            if control is None:
+                points.append((x, y))
+            else:
+                points.extend(quad(current, control, (x, y), steps))
+                control = None
+            current = (x, y)
+        else:
+            if control is not None:
+                mid = ((control[0] + x) / 2, (control[1] + y) / 2)
+                points.extend(quad(current, control, mid, steps))
+                current = mid
+            control = (x, y)
+    if control is not None:
+        points.extend(quad(current, control, ordered[0][:2], steps))
+    return points
+
+
+def quad(p0, p1, p2, steps):
+    out = []
+    for i in range(1, steps + 1):
+        t = i / steps
+        u = 1 - t
+        out.append((u * u * p0[0] + 2 * u * t * p1[0] + t * t * p2[0],
+                    u * u * p0[1] + 2 * u * t * p1[1] + t * t * p2[1]))
+    return out
+
+
+def rasterize(edges, width, height):
+    """Non-zero winding coverage, SUBSAMPLES scanlines per pixel row, exact in x."""
+    coverage = [0.0] * (width * height)
+    for row in range(height * SUBSAMPLES):
+        sy = (row + 0.5) / SUBSAMPLES
+        crossings = []
+        for (x0, y0), (x1, y1) in edges:
+            if (y0 <= sy < y1) or (y1 <= sy < y0):
+                x = x0 + (sy - y0) * (x1 - x0) / (y1 - y0)
+                crossings.append((x, 1 if y1 > y0 else -1))
+        crossings.sort()
+        winding, span_start = 0, 0.0
+        for x, direction in crossings:
+            previous = winding
+            winding += direction
+            if previous == 0 and winding != 0:
+                span_start = x
+            elif previous != 0 and winding == 0:
+                add_span(coverage, width, int(sy), span_start, x)
+    return coverage
+
+
+def add_span(coverage, width, y, xa, xb):
+    xa, xb = max(xa, 0.0), min(xb, float(width))
+    weight = 1.0 / SUBSAMPLES
+    px = int(xa)
+    while px < width and px < xb:
+        left, right = max(xa, px), min(xb, px + 1)
+        if right > left:
+            coverage[y * width + px] += (right - left) * weight
+        px += 1
+
+
+def main():
+    if len(sys.argv) not in (2, 4):
+        sys.exit(__doc__)
+    font = Font(open(sys.argv[1], "rb").read())
+    cell_w, cell_h = (int(sys.argv[2]), int(sys.argv[3])) if len(sys.argv) == 4 else (8, 15)
+
+    scale = cell_h / (font.ascender - font.descender)
+    baseline = font.ascender * scale
+    advance = font.advances[min(font.cmap.get(ord("M"), 0), len(font.advances) - 1)] * scale
+    pad_x = (cell_w - advance) / 2
+
+    tiles = []
+    for c in range(FIRST_CHAR, LAST_CHAR + 1):
+        edges = []
+        for contour in font.contours(font.cmap.get(c, 0)):
+            pts = [(pad_x + x * scale, baseline - y * scale) for x, y in flatten(contour)]
+            edges.extend(zip(pts, pts[1:] + pts[:1]))
+        coverage = rasterize(edges, cell_w, cell_h)
+        tiles.append([min(15, int(v * 15 + 0.5)) for v in coverage])
+
+    name = sys.argv[1].replace("\\", "/").rsplit("/", 1)[-1]
+    out = sys.stdout
+    out.write("#pragma once\n\n")
+    out.write("// Generated by tools/fontgen.py from %s, do not edit.\n\n" % name)
+    out.write("#include <cstdint>\n\nnamespace UI::FONT\n{\n")
+    out.write("    inline constexpr int GLYPH_WIDTH = %d;\n" % cell_w)
+    out.write("    inline constexpr int GLYPH_HEIGHT = %d;\n" % cell_h)
+    out.write("    inline constexpr int FIRST_CHAR = %d;\n" % FIRST_CHAR)
+    out.write("    inline constexpr int CHAR_COUNT = %d;\n\n" % (LAST_CHAR - FIRST_CHAR + 1))
+    out.write("    // 4-bit coverage, two pixels per byte, high nibble first\n")
+    out.write("    inline constexpr uint8_t GLYPHS[CHAR_COUNT * GLYPH_WIDTH * GLYPH_HEIGHT / 2] = {\n")
+    for c, tile in zip(range(FIRST_CHAR, LAST_CHAR + 1), tiles):
+        packed = [(tile[i] << 4) | tile[i + 1] for i in range(0, len(tile), 2)]
+        label = chr(c) if c != 92 else "backslash"
+        out.write("        // '%s'\n" % label)
+        row_bytes = cell_w // 2
+        for i in range(0, len(packed), row_bytes):
+            out.write("        " + ", ".join("0x%02X" % b for b in packed[i:i + row_bytes]) + ",\n")
+    out.write("    };\n} // namespace UI::FONT\n")
+
+
+if __name__ == "__main__":
+    main()
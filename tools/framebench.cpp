@@ -0,0 +1,163 @@
+// Host benchmark for Terminal frame time, drawing inline into the memory framebuffer:
+//   - full redraw: every row's text changes each frame, the worst case and about what a
+//     console that reprints the screen pays;
+//   - scroll: the list under a fixed header moves one row per frame;
+//   - cursor move: the highlight steps down a full list, the common case;
+//   - cursor move with a preview image beside the list, replaced every 8 frames;
+//   - idle: present() with nothing changed.
+// Reports rows drawn per frame and frame time (mean, 99th percentile, worst) from
+// Terminal::stats(), against the 16.7 ms a 60 fps frame has.
+//
+// Usage: g++ -std=c++17 -O2 -Iinclude tools/framebench.cpp -lpthread -o framebench && ./framebench
+//
+// Exits non-zero if a partial redraw draws more rows than changed.
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "terminal.hpp"
+
+namespace
+{
+    using UI::Terminal;
+
+    constexpr int FRAMES = 3000;
+    constexpr int LIST_TOP = 2, LIST_ROWS = Terminal::ROWS - 4; // header and footer, as in the menu
+
+    std::string itemText(int item)
+    {
+        char text[Terminal::COLS + 1];
+        std::snprintf(text, sizeof(text), "  %05d  Amiibo figure name %-40d Series name        Type", item, item * 7919 % 100000);
+        return text;
+    }
+
+    struct Result
+    {
+        double meanUs = 0, p99Us = 0, worstUs = 0;
+        int minRows = Terminal::ROWS, maxRows = 0;
+        uint64_t skipped = 0;
+    };
+
+    // Runs `frame(i)` then present() FRAMES times, collecting the per-frame stats. The
+    // first frame into each buffer is a full one and not counted.
+    template <typename Frame>
+    Result measure(Terminal &terminal, Frame &&frame)
+    {
+        std::vector<double> times;
+        Result result;
+        uint64_t skippedBefore = 0;
+        for (int i = 0; i < FRAMES + UI::FRAMEBUFFER_COUNT; ++i)
+        {
+            if (i == UI::FRAMEBUFFER_COUNT)
+                skippedBefore = terminal.stats().skipped;
+            frame(i);
+            const uint64_t framesBefore = terminal.stats().frames;
+            terminal.present();
+            const UI::FrameStats stats = terminal.stats();
+            if (i < UI::FRAMEBUFFER_COUNT || stats.frames == framesBefore)
+                continue;
+            times.push_back(stats.frameNs / 1e3);
+            result.minRows = std::min(result.minRows, stats.rowsDrawn);
+            result.maxRows = std::max(result.maxRows, stats.rowsDrawn);
+        }
+        result.skipped = terminal.stats().skipped - skippedBefore;
+        if (times.empty())
+        {
+            result.minRows = 0;
+            return result;
+        }
+        std::sort(times.begin(), times.end());
+        for (const double t : times)
+            result.meanUs += t / times.size();
+        result.p99Us = times[times.size() * 99 / 100];
+        result.worstUs = times.back();
+        return result;
+    }
+
+    void print(const char *name, const Result &result)
+    {
+        std::printf("%-30s rows %2d-%-2d  mean %7.1f us  p99 %7.1f us  worst %7.1f us  (%4.1f%% of 16.7 ms)",
+                    name, result.minRows, result.maxRows, result.meanUs, result.p99Us, result.worstUs, result.meanUs / 166.7);
+        if (result.skipped)
+            std::printf("  %llu presents skipped", static_cast<unsigned long long>(result.skipped));
+        std::printf("\n");
+    }
+
+    void header(Terminal &terminal)
+    {
+        terminal.setLine(0, "  Amiibo Generator", UI::STYLE_HEADER);
+        terminal.setLine(Terminal::ROWS - 1, "  A : Select   B : Back   + : Exit", UI::STYLE_HEADER);
+    }
+
+    // List starting at `first` with the highlight on `cursor`
+    void list(Terminal &terminal, int first, int cursor, int styleCols = Terminal::COLS)
+    {
+        for (int r = 0; r < LIST_ROWS; ++r)
+            terminal.setLine(LIST_TOP + r, itemText(first + r), first + r == cursor ? UI::STYLE_CURSOR : UI::STYLE_NORMAL, styleCols);
+    }
+} // namespace
+
+int main()
+{
+    bool ok = true;
+    {
+        auto terminal = std::make_unique<Terminal>();
+        const Result result = measure(*terminal, [&](int i)
+                                      {
+                                          for (int r = 0; r < Terminal::ROWS; ++r)
+                                              terminal->setLine(r, itemText(i * Terminal::ROWS + r)); });
+        print("full redraw", result);
+        ok &= result.minRows == Terminal::ROWS;
+    }
+    {
+        auto terminal = std::make_unique<Terminal>();
+        header(*terminal);
+        const Result result = measure(*terminal, [&](int i)
+                                      { list(*terminal, i, i + LIST_ROWS / 2); });
+        print("scroll by one row", result);
+        ok &= result.maxRows <= LIST_ROWS;
+    }
+    {
+        auto terminal = std::make_unique<Terminal>();
+        header(*terminal);
+        const Result result = measure(*terminal, [&](int i)
+                                      { list(*terminal, 0, i % LIST_ROWS); });
+        print("cursor move", result);
+        ok &= result.maxRows <= 2;
+    }
+    {
+        std::mt19937 rng(81);
+        std::vector<std::vector<uint8_t>> previews;
+        for (int k = 0; k < 4; ++k)
+        {
+            std::vector<uint8_t> &rgba = previews.emplace_back(static_cast<size_t>(150) * 200 * 4);
+            for (uint8_t &v : rgba)
+                v = static_cast<uint8_t>(rng());
+        }
+        constexpr int STYLE_COLS = 120, IMAGE_X = 1000, IMAGE_Y = 60; // list clear of the preview
+        auto terminal = std::make_unique<Terminal>();
+        header(*terminal);
+        const Result result = measure(*terminal, [&](int i)
+                                      {
+                                          list(*terminal, 0, i % LIST_ROWS, STYLE_COLS);
+                                          if (i % 8 == 0)
+                                              terminal->setImage(IMAGE_X, IMAGE_Y, 150, 200, previews[(i / 8) % previews.size()].data()); });
+        print("cursor move, preview image", result);
+    }
+    {
+        auto terminal = std::make_unique<Terminal>();
+        header(*terminal);
+        const Result result = measure(*terminal, [&](int i)
+                                      {
+                                          if (i < UI::FRAMEBUFFER_COUNT) // fill both buffers, then change nothing
+                                              list(*terminal, 0, i); });
+        print("idle", result);
+        ok &= result.skipped == FRAMES;
+    }
+    std::puts(ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,156 @@
+// Host benchmark for thumbnail profiles: writes the sample images as PNG files, then
+// generates 1, 2 and 3 thumbnail sizes per image with loadAndResizeImageInRatio, once as a
+// single call (one decode, each size resized from the previous one) and once as a
+// separate call per size (one decode each). Reports the time per image for both (best of
+// several runs, PNG encoding and file writes included, as on the console) and the decode
+// time alone, then checks the cascaded sizes against the ones resized straight from the
+// source, by PSNR on premultiplied RGBA. Cropping is off so both ways give the same sizes.
+//
+// Usage: g++ -std=c++17 -O2 -Iinclude tools/mipbench.cpp source/stb_impl.cpp -lcurl -lpthread -o mipbench && ./mipbench [image.png...]
+//
+// Without arguments it runs on synthetic figure renders. Files go to a temporary
+// directory, removed afterwards. Exits non-zero if a call fails or a cascaded size falls
+// below 35 dB.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "benchimage.hpp"
+#include "util.hpp"
+
+namespace
+{
+    constexpr int RUNS = 5;
+    constexpr double MIN_PSNR = 35.0;
+
+    // loadAndResizeImageInRatio replaces the downloaded file with its thumbnail, so every
+    // run starts from a fresh copy of the source; copying is not timed
+    template <typename Setup, typename Work>
+    [[nodiscard]] double bestMs(Setup &&setup, Work &&work)
+    {
+        double best = 1e30;
+        for (int run = 0; run < RUNS; ++run)
+        {
+            setup();
+            const auto start = std::chrono::steady_clock::now();
+            work();
+            best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+        return best;
+    }
+
+    [[nodiscard]] std::vector<uint8_t> loadRgba(const std::string &path, int &width, int &height)
+    {
+        int channels = 0;
+        unsigned char *pixels = stbi_load(path.c_str(), &width, &height, &channels, 4);
+        std::vector<uint8_t> rgba;
+        if (pixels)
+            rgba.assign(pixels, pixels + static_cast<size_t>(width) * height * 4);
+        stbi_image_free(pixels);
+        return rgba;
+    }
+
+    [[nodiscard]] double psnr(const std::vector<uint8_t> &a, const std::vector<uint8_t> &b)
+    {
+        if (a.size() != b.size() || a.empty())
+            return 0.0;
+        double sum = 0;
+        for (size_t i = 0; i < a.size(); i += 4)
+        {
+            for (int c = 0; c < 3; ++c)
+            {
+                const double d = (a[i + c] * a[i + 3] - b[i + c] * b[i + 3]) / 255.0;
+                sum += d * d;
+            }
+            sum += static_cast<double>(a[i + 3] - b[i + 3]) * (a[i + 3] - b[i + 3]);
+        }
+        const double mse = sum / static_cast<double>(a.size());
+        return mse == 0 ? 99.0 : 10.0 * std::log10(255.0 * 255.0 / mse);
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    namespace fs = std::filesystem;
+    const fs::path dir = fs::temp_directory_path() / "mipbench-images";
+    fs::create_directories(dir);
+
+    const std::vector<std::vector<int>> PROFILES = {{150}, {150, 64}, {256, 150, 64}};
+    std::vector<std::string> sources;
+    for (const BENCH::Image &image : BENCH::corpus(argc, argv))
+    {
+        const std::string path = (dir / ("figure" + std::to_string(sources.size()) + ".png")).string();
+        if (!stbi_write_png(path.c_str(), image.width, image.height, 4, image.rgba.data(), image.width * 4))
+            return 1;
+        sources.push_back(path);
+    }
+
+    const auto copy = [](const std::string &from, const std::string &to)
+    { fs::copy_file(from, to, fs::copy_options::overwrite_existing); };
+
+    bool ok = true;
+    double decodeMs = 0;
+    for (const std::string &source : sources)
+        decodeMs += bestMs([] {}, [&]
+                           { const UTIL::ImageData img(source); });
+    std::printf("%zu images, decode alone %.2f ms per image\n", sources.size(), decodeMs / sources.size());
+
+    for (const std::vector<int> &heights : PROFILES)
+    {
+        double single = 0, separate = 0, worst = 99.0;
+        for (size_t i = 0; i < sources.size(); ++i)
+        {
+            const std::string out = (dir / ("thumb" + std::to_string(i) + ".png")).string();
+            std::vector<std::string> paths;
+            for (const int height : heights)
+                paths.push_back(height == heights.front() ? out : UTIL::thumbnailPath(out, height));
+
+            UTIL::ImageOptions options;
+            options.heights = heights;
+            options.cropTransparent = false; // its padding depends on the largest size, so sizes would differ
+            single += bestMs([&]
+                             { copy(sources[i], out); },
+                             [&]
+                             { ok &= UTIL::loadAndResizeImageInRatio(out, options); });
+            std::vector<std::vector<uint8_t>> cascaded;
+            for (const std::string &path : paths)
+            {
+                int w = 0, h = 0;
+                cascaded.push_back(loadRgba(path, w, h));
+            }
+
+            separate += bestMs([&]
+                               {
+                                   for (const std::string &path : paths)
+                                       copy(sources[i], path); },
+                               [&]
+                               {
+                                   for (size_t k = 0; k < heights.size(); ++k)
+                                   {
+                                       UTIL::ImageOptions one = options;
+                                       one.heights = {heights[k]};
+                                       ok &= UTIL::loadAndResizeImageInRatio(paths[k], one);
+                                   } });
+            for (size_t k = 0; k < heights.size(); ++k)
+            {
+                int w = 0, h = 0;
+                worst = std::min(worst, psnr(cascaded[k], loadRgba(paths[k], w, h)));
+            }
+        }
+        std::string label;
+        for (const int height : heights)
+            label += (label.empty() ? "" : ", ") + std::to_string(height) + " px";
+        std::printf("%-20s one call %6.2f ms, separate calls %6.2f ms per image (%.0f%%), cascaded sizes worst %.1f dB vs direct\n",
+                    label.c_str(), single / sources.size(), separate / sources.size(), 100.0 * single / separate, worst);
+        ok &= worst >= MIN_PSNR;
+    }
+
+    std::error_code ec;
+    fs::remove_all(dir, ec);
+    std::puts(ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,132 @@
+// Host benchmark for paletted thumbnails: for each sample image, at its own size and
+// resized to the 150 px thumbnail height, compares the 32-bit RGBA PNG the generator used
+// to write (stb_image_write) with quantizeRgba + encodePalettedPng, with and without
+// dithering. Reports output bytes, encode time (best of several runs) and PSNR of the
+// decoded palette image against the source, on premultiplied RGBA so errors under
+// transparent pixels do not count.
+//
+// Usage: g++ -std=c++17 -O2 -Iinclude tools/palettebench.cpp source/stb_impl.cpp -lcurl -lpthread -o palettebench && ./palettebench [image.png...]
+//
+// Without arguments it runs on synthetic figure renders. Exits non-zero if a paletted PNG
+// does not decode back to its palette image, or if PSNR drops below 30 dB.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "benchimage.hpp"
+#include "palette.hpp"
+#include "util.hpp"
+
+namespace
+{
+    constexpr int RUNS = 5;
+    constexpr double MIN_PSNR = 30.0;
+
+    template <typename Work>
+    [[nodiscard]] double bestMs(Work &&work)
+    {
+        double best = 1e30;
+        for (int run = 0; run < RUNS; ++run)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            work();
+            best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+        return best;
+    }
+
+    [[nodiscard]] double psnr(const uint8_t *a, const uint8_t *b, size_t pixels)
+    {
+        double sum = 0;
+        for (size_t i = 0; i < pixels; ++i, a += 4, b += 4)
+        {
+            for (int c = 0; c < 3; ++c)
+            {
+                const double d = (a[c] * a[3] - b[c] * b[3]) / 255.0;
+                sum += d * d;
+            }
+            sum += static_cast<double>(a[3] - b[3]) * (a[3] - b[3]);
+        }
+        const double mse = sum / (static_cast<double>(pixels) * 4);
+        return mse == 0 ? 99.0 : 10.0 * std::log10(255.0 * 255.0 / mse);
+    }
+
+    struct Totals
+    {
+        size_t rgbaBytes = 0, palettedBytes[2] = {};
+        double rgbaMs = 0, palettedMs[2] = {};
+        double worstPsnr[2] = {99.0, 99.0};
+    };
+
+    bool measure(const char *name, int width, int height, const std::vector<uint8_t> &rgba, Totals &totals)
+    {
+        std::vector<uint8_t> png;
+        const double rgbaMs = bestMs([&]
+                                     {
+                                         png.clear();
+                                         stbi_write_png_to_func(UTIL::appendPngBytes, &png, width, height, 4, rgba.data(), width * 4); });
+        std::printf("%-34s %4dx%-4d  rgba %7zu B %6.2f ms", name, width, height, png.size(), rgbaMs);
+        totals.rgbaBytes += png.size();
+        totals.rgbaMs += rgbaMs;
+
+        bool ok = true;
+        for (const bool dither : {false, true})
+        {
+            UTIL::PalettedImage image;
+            std::vector<uint8_t> paletted;
+            const double ms = bestMs([&]
+                                     {
+                                         image = UTIL::quantizeRgba(rgba.data(), width, height, dither);
+                                         paletted = UTIL::encodePalettedPng(image); });
+
+            std::vector<uint8_t> expanded(rgba.size());
+            for (size_t i = 0; i < image.indices.size(); ++i)
+                std::copy_n(&image.palette[image.indices[i] * 4u], 4, &expanded[i * 4]);
+            int w = 0, h = 0, channels = 0;
+            unsigned char *decoded = stbi_load_from_memory(paletted.data(), static_cast<int>(paletted.size()), &w, &h, &channels, 4);
+            const bool roundTrips = decoded && w == width && h == height && std::equal(expanded.begin(), expanded.end(), decoded);
+            stbi_image_free(decoded);
+
+            const double quality = psnr(rgba.data(), expanded.data(), static_cast<size_t>(width) * height);
+            std::printf(" | %s %6zu B (%3.0f%%) %6.2f ms %5.1f dB", dither ? "dither" : "plain", paletted.size(),
+                        100.0 * paletted.size() / png.size(), ms, quality);
+            if (!roundTrips)
+                std::printf(" DOES NOT DECODE");
+            ok &= roundTrips && quality >= MIN_PSNR;
+            totals.palettedBytes[dither] += paletted.size();
+            totals.palettedMs[dither] += ms;
+            totals.worstPsnr[dither] = std::min(totals.worstPsnr[dither], quality);
+        }
+        std::printf("\n");
+        return ok;
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    bool ok = true;
+    Totals full, thumbnails;
+    for (const BENCH::Image &image : BENCH::corpus(argc, argv))
+    {
+        ok &= measure(image.name.c_str(), image.width, image.height, image.rgba, full);
+
+        // What the generator writes: the thumbnail-height resize
+        const int height = UTIL::TARGET_IMAGE_HEIGHT;
+        const int width = std::max(1, image.width * height / image.height);
+        std::vector<uint8_t> small(static_cast<size_t>(width) * height * 4);
+        if (!UTIL::resizeImage(image.rgba.data(), image.width, image.height, image.width * 4, small.data(), width, height, 4,
+                               UTIL::ResizeQuality::Linear))
+            return 1;
+        ok &= measure("  at thumbnail height", width, height, small, thumbnails);
+    }
+
+    for (const auto &[label, totals] : {std::pair<const char *, const Totals &>{"full size", full}, {"thumbnails", thumbnails}})
+        std::printf("%-10s rgba %8zu B %7.2f ms | plain %8zu B (%3.0f%%) %7.2f ms, worst %4.1f dB | dither %8zu B (%3.0f%%) %7.2f ms, worst %4.1f dB\n",
+                    label, totals.rgbaBytes, totals.rgbaMs, totals.palettedBytes[0], 100.0 * totals.palettedBytes[0] / totals.rgbaBytes,
+                    totals.palettedMs[0], totals.worstPsnr[0], totals.palettedBytes[1], 100.0 * totals.palettedBytes[1] / totals.rgbaBytes,
+                    totals.palettedMs[1], totals.worstPsnr[1]);
+    std::puts(ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
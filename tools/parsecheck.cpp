@@ -0,0 +1,210 @@
+// Host check for the structural-index JSON parser: parseJsonIndexed must build the same
+// tree as nlohmann::json::parse, and reject the same documents, for
+//   - hand-written edge cases (escapes, surrogate pairs, number forms, a BOM, invalid input),
+//   - random documents, printed compact and with whitespace that moves strings and escapes
+//     across the 64-byte blocks the first pass classifies,
+//   - random byte mutations of those documents,
+//   - a database file given on the command line, e.g. from tools/dbgen.py generate, which
+//     is also timed with both parsers.
+// Trees are compared by their dump, so 1 and 1.0 or 1 and 1u count as different.
+//
+// Usage: g++ -std=c++17 -O2 -Iinclude tools/parsecheck.cpp -o parsecheck
+//        ./parsecheck [amiibos.json]
+//
+// Exits non-zero on the first disagreement.
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "jsonindex.hpp"
+
+namespace
+{
+    // Empty when the parser rejected the text
+    [[nodiscard]] std::string reference(std::string_view text)
+    {
+        const nlohmann::json tree = nlohmann::json::parse(text.begin(), text.end(), nullptr, false);
+        return tree.is_discarded() ? std::string() : tree.dump();
+    }
+
+    [[nodiscard]] std::string indexed(std::string_view text)
+    {
+        const nlohmann::json tree = UTIL::parseJsonIndexed(text);
+        return tree.is_discarded() ? std::string() : tree.dump();
+    }
+
+    [[nodiscard]] std::string printable(std::string_view text)
+    {
+        std::string out;
+        for (const char c : text.substr(0, 200))
+        {
+            char hex[8];
+            std::snprintf(hex, sizeof(hex), "\\x%02x", static_cast<unsigned char>(c));
+            out += c >= 0x20 && c < 0x7F ? std::string(1, c) : std::string(hex);
+        }
+        return text.size() > 200 ? out + "..." : out;
+    }
+
+    bool same(std::string_view text, const char *what)
+    {
+        const std::string expected = reference(text), actual = indexed(text);
+        if (expected == actual)
+            return true;
+        std::fprintf(stderr, "%s: parsers disagree on\n  %s\nnlohmann: %s\nindexed:  %s\n", what, printable(text).c_str(),
+                     expected.empty() ? "(rejected)" : printable(expected).c_str(), actual.empty() ? "(rejected)" : printable(actual).c_str());
+        return false;
+    }
+
+    const char *const CASES[] = {
+        R"({})", R"([])", R"("")", R"(0)", R"(-0)", R"(-0.0)", R"(true)", R"(false)", R"(null)",
+        R"({"a":1,"b":[1,2,{"c":null}],"d":{"e":{}}})",
+        R"(  {  "a"  :  [ 1 , 2 ]  }  )",
+        "\t\r\n[\n1\n]\n",
+        R"("\"\\\/\b\f\n\r\t")",
+        R"("Aé中😀")",
+        R"("𝄞")",
+        R"("\ud800")", R"("\udc00")", R"("\ud800A")", R"("\u12")", R"("\x")", R"("\)",
+        "\"caf\xC3\xA9 \xE3\x83\x9E\xE3\x83\xAA\xE3\x82\xAA \xF0\x9F\x8E\xAE\"",
+        "\"\xC3\"", "\"\xE3\x83\"", "\"\xF0\x9F\x8E\"", "\"\xC0\xAF\"", "\"\xED\xA0\x80\"", "\"\xFF\"",
+        "\"a\x01" "b\"", "\"tab\there\"",
+        "\xEF\xBB\xBF{\"bom\":true}",
+        R"(1)", R"(-1)", R"(18446744073709551615)", R"(18446744073709551616)", R"(9223372036854775807)",
+        R"(-9223372036854775808)", R"(-9223372036854775809)", R"(1.5)", R"(1e3)", R"(1E+3)", R"(1e-3)",
+        R"(-1.25e-7)", R"(1.7976931348623157e308)", R"(1e400)", R"(4.9e-324)", R"(0.1)",
+        R"(01)", R"(1.)", R"(.5)", R"(-)", R"(+1)", R"(1e)", R"(1e+)", R"(0x10)", R"(NaN)", R"(Infinity)",
+        R"({"a":1,})", R"([1,])", R"([,1])", R"({"a" 1})", R"({1:2})", R"({"a":1 "b":2})", R"([1 2])",
+        R"({"a":1}})", R"([[1])", R"({"a":)", R"(tru)", R"(nul)", R"(truex)", R"([true false])", "", " ",
+        R"({"a":1}{"b":2})", R"("unterminated)", R"({"k":"v"} x)",
+        R"({"dup":1,"dup":2})",
+        R"([[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[[]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]]])",
+    };
+
+    // Random value; strings favour quotes, backslashes and multi-byte text
+    nlohmann::json randomValue(std::mt19937 &rng, int depth)
+    {
+        const auto pick = [&](int n)
+        { return static_cast<int>(rng() % static_cast<unsigned>(n)); };
+        const auto randomString = [&]
+        {
+            static const char *const PIECES[] = {"a", "Mario", " ", "\"", "\\", "/", "\n", "\t", "\x01", "\xC3\xA9",
+                                                 "\xE3\x83\x9E", "\xF0\x9F\x8E\xAE", "{", "}", "[", "]", ":", ","};
+            std::string s;
+            for (int i = pick(12); i > 0; --i)
+                s += PIECES[pick(static_cast<int>(std::size(PIECES)))];
+            return s;
+        };
+        switch (depth >= 5 ? pick(6) : pick(8))
+        {
+        case 0:
+            return nullptr;
+        case 1:
+            return pick(2) == 0;
+        case 2:
+            return static_cast<int64_t>(rng()) - static_cast<int64_t>(rng()) * (pick(2) ? 1 : 100000);
+        case 3:
+            return static_cast<uint64_t>(rng()) << 32 | rng();
+        case 4:
+            return std::ldexp(static_cast<double>(rng()) / 4294967296.0 - 0.5, pick(200) - 100);
+        case 5:
+            return randomString();
+        case 6:
+        {
+            nlohmann::json array = nlohmann::json::array();
+            for (int i = pick(6); i > 0; --i)
+                array.push_back(randomValue(rng, depth + 1));
+            return array;
+        }
+        default:
+        {
+            nlohmann::json object = nlohmann::json::object();
+            for (int i = pick(6); i > 0; --i)
+                object[randomString()] = randomValue(rng, depth + 1);
+            return object;
+        }
+        }
+    }
+
+    bool checkFile(const char *path)
+    {
+        std::string text;
+        if (!UTIL::readTextFile(path, text))
+        {
+            std::fprintf(stderr, "cannot read %s\n", path);
+            return false;
+        }
+        const auto time = [&](auto &&parse)
+        {
+            double best = 1e30;
+            for (int run = 0; run < 3; ++run)
+            {
+                const auto start = std::chrono::steady_clock::now();
+                const nlohmann::json tree = parse();
+                best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+            }
+            return best;
+        };
+        const double stock = time([&]
+                                  { return nlohmann::json::parse(text.begin(), text.end(), nullptr, false); });
+        const double simd = time([&]
+                                 { return UTIL::parseJsonIndexed(text); });
+        std::printf("%s: %.1f MB, nlohmann %.1f ms, indexed %.1f ms (%.2fx)\n", path, text.size() / 1e6, stock, simd, stock / simd);
+        return same(text, path);
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    int cases = 0;
+    for (const char *text : CASES)
+    {
+        if (!same(text, "case"))
+            return 1;
+        ++cases;
+    }
+
+    std::mt19937 rng(88);
+    int documents = 0, mutations = 0, rejected = 0;
+    for (int i = 0; i < 3000; ++i)
+    {
+        const nlohmann::json value = randomValue(rng, 0);
+        std::string text = value.dump(i % 3 == 0 ? -1 : static_cast<int>(i % 7), i % 2 ? ' ' : '\t', i % 5 == 0);
+        text.insert(0, i % 64, ' '); // shifts everything against the 64-byte blocks
+        if (!same(text, "random document"))
+            return 1;
+        ++documents;
+
+        for (int m = 0; m < 10 && !text.empty(); ++m)
+        {
+            std::string mutated = text;
+            const size_t at = rng() % mutated.size();
+            static const char BYTES[] = "\"\\{}[]:,0e-. \x01\x80\xC3\xFF";
+            switch (rng() % 3)
+            {
+            case 0:
+                mutated[at] = BYTES[rng() % (sizeof(BYTES) - 1)];
+                break;
+            case 1:
+                mutated.erase(at, 1);
+                break;
+            default:
+                mutated.insert(at, 1, BYTES[rng() % (sizeof(BYTES) - 1)]);
+                break;
+            }
+            if (!same(mutated, "mutated document"))
+                return 1;
+            ++mutations;
+            rejected += reference(mutated).empty() ? 1 : 0;
+        }
+    }
+    std::printf("%d edge cases, %d random documents, %d mutations (%d invalid): same trees, same rejections\n", cases,
+                documents, mutations, rejected);
+
+    for (int i = 1; i < argc; ++i)
+        if (!checkFile(argv[i]))
+            return 1;
+    std::puts("ok");
+    return 0;
+}
@@ -0,0 +1,151 @@
+// Host check for PreviewLoader: replays scrolling over a list whose figures have local
+// images, at the menu's frame rate, and reports the preview cache hit rate per pattern.
+// Fails if an image path is ever resolved on the UI (calling) thread, or if the row the
+// cursor stops on never becomes ready.
+//
+// Usage: g++ -std=c++17 -O2 -Iinclude tools/previewcheck.cpp source/stb_impl.cpp -lcurl -lpthread -o previewcheck
+//        ./previewcheck [directory]   (default /tmp/previewcheck, created and removed)
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <thread>
+#include <vector>
+
+#include "preview.hpp"
+
+namespace
+{
+    constexpr int ROWS = 500;
+    constexpr auto FRAME = std::chrono::microseconds(16667);
+
+    struct Pattern
+    {
+        const char *name;
+        std::vector<int> cursor; // cursor row per frame
+    };
+
+    [[nodiscard]] std::vector<Pattern> patterns()
+    {
+        std::vector<Pattern> out;
+        Pattern hold{"hold down (1 row / 3 frames)", {}};
+        for (int f = 0; f < 3 * 120; ++f)
+            hold.cursor.push_back(f / 3);
+        out.push_back(std::move(hold));
+
+        Pattern flick{"flick (5 rows / frame)", {}};
+        for (int f = 0; f < 60; ++f)
+            flick.cursor.push_back(120 + f * 5);
+        for (int f = 0; f < 30; ++f)
+            flick.cursor.push_back(120 + 59 * 5); // settles
+        out.push_back(std::move(flick));
+
+        Pattern browse{"browse back and forth over 20 rows", {}};
+        for (int pass = 0; pass < 6; ++pass)
+            for (int f = 0; f < 3 * 20; ++f)
+                browse.cursor.push_back(pass % 2 == 0 ? 40 + f / 3 : 59 - f / 3);
+        out.push_back(std::move(browse));
+        return out;
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    const std::filesystem::path dir = argc > 1 ? argv[1] : "/tmp/previewcheck";
+    std::filesystem::create_directories(dir);
+
+    // One 240x320 RGBA image per row, transparent border around an opaque figure
+    std::vector<std::string> paths(ROWS);
+    std::vector<unsigned char> pixels(240 * 320 * 4);
+    for (int row = 0; row < ROWS; ++row)
+    {
+        for (int y = 0; y < 320; ++y)
+            for (int x = 0; x < 240; ++x)
+            {
+                unsigned char *p = &pixels[(static_cast<size_t>(y) * 240 + x) * 4];
+                const bool inside = x > 30 && x < 210 && y > 20 && y < 300;
+                p[0] = static_cast<unsigned char>(x + row);
+                p[1] = static_cast<unsigned char>(y * 3 + row);
+                p[2] = static_cast<unsigned char>(x ^ y);
+                p[3] = inside ? 255 : 0;
+            }
+        paths[row] = (dir / ("row" + std::to_string(row) + ".png")).string();
+        if (!stbi_write_png(paths[row].c_str(), 240, 320, 4, pixels.data(), 240 * 4))
+        {
+            std::fprintf(stderr, "cannot write %s\n", paths[row].c_str());
+            return 1;
+        }
+    }
+
+    UTIL::Scheduler scheduler;
+    UTIL::Downloader downloader;
+    UTIL::PreviewLoader loader(scheduler, downloader, false);
+    const std::thread::id uiThread = std::this_thread::get_id();
+    std::atomic<int> resolvedOnUi{0};
+
+    const auto source = [&](int row)
+    {
+        return UTIL::PreviewSource{"row" + std::to_string(row), std::string(), [&, row]
+                                   {
+                                       if (std::this_thread::get_id() == uiThread)
+                                           resolvedOnUi.fetch_add(1);
+                                       return paths[row];
+                                   }};
+    };
+
+    bool ok = true;
+    UTIL::PreviewStats before{};
+    for (const Pattern &pattern : patterns())
+    {
+        double slowestWantUs = 0;
+        int readyFrames = 0;
+        int lastWanted = -1;
+        for (const int cursor : pattern.cursor)
+        {
+            const auto frameStart = std::chrono::steady_clock::now();
+            if (cursor != lastWanted) // the menu republishes on every cursor move
+            {
+                std::vector<UTIL::PreviewSource> sources{source(cursor)};
+                for (int d = 1; d <= UTIL::PREVIEW_PREFETCH_ROWS; ++d)
+                    for (const int row : {cursor + d, cursor - d})
+                        if (row >= 0 && row < ROWS)
+                            sources.push_back(source(row));
+                const auto t = std::chrono::steady_clock::now();
+                loader.want(std::move(sources));
+                slowestWantUs = std::max(slowestWantUs, std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t).count());
+                lastWanted = cursor;
+            }
+            std::shared_ptr<const UTIL::PreviewImage> image;
+            readyFrames += loader.get("row" + std::to_string(cursor), image) == UTIL::PreviewLoader::State::Ready ? 1 : 0;
+            std::this_thread::sleep_until(frameStart + FRAME);
+        }
+
+        // Where the cursor stopped must load
+        std::shared_ptr<const UTIL::PreviewImage> image;
+        const std::string last = "row" + std::to_string(pattern.cursor.back());
+        for (int wait = 0; wait < 200 && loader.get(last, image) != UTIL::PreviewLoader::State::Ready; ++wait)
+            std::this_thread::sleep_for(FRAME);
+        ok &= image != nullptr;
+
+        const UTIL::PreviewStats now = loader.stats();
+        UTIL::PreviewStats delta;
+        delta.hits = now.hits - before.hits;
+        delta.misses = now.misses - before.misses;
+        std::printf("%-36s %4zu frames: hit rate %5.1f%%, cursor preview shown on %5.1f%% of frames, "
+                    "%3llu decoded, %3llu evicted, slowest want() %.0f us%s\n",
+                    pattern.name, pattern.cursor.size(), delta.hitRate() * 100.0, 100.0 * readyFrames / pattern.cursor.size(),
+                    static_cast<unsigned long long>(now.decoded - before.decoded), static_cast<unsigned long long>(now.evicted - before.evicted),
+                    slowestWantUs, image ? "" : "  FINAL ROW NEVER LOADED");
+        before = now;
+    }
+
+    if (resolvedOnUi.load() != 0)
+    {
+        std::fprintf(stderr, "%d image paths were resolved on the UI thread\n", resolvedOnUi.load());
+        ok = false;
+    }
+    std::error_code ec;
+    std::filesystem::remove_all(dir, ec);
+    std::puts(ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,133 @@
+// Host check for ProgressChannel overflow. A full ring must drop, and count, exactly the
+// events it had no room for, hand every accepted event to drain() once and in each
+// producer's order, and work again once drained, lap after lap. Checked single-threaded,
+// then with eight producers racing a consumer too slow to keep up, reporting through
+// ProgressScope as the generation workers do.
+//
+// Usage: g++ -std=c++17 -O2 -Iinclude tools/progresscheck.cpp -lcurl -lpthread -o progresscheck && ./progresscheck
+//
+// Exits non-zero if a check fails.
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "progress.hpp"
+
+namespace
+{
+    bool ok = true;
+
+    void expect(bool condition, const char *what)
+    {
+        std::printf("%-72s %s\n", what, condition ? "ok" : "FAILED");
+        ok &= condition;
+    }
+
+    void singleThreaded()
+    {
+        auto channel = std::make_unique<UTIL::ProgressChannel>();
+        constexpr size_t EXTRA = 100;
+        size_t accepted = 0;
+        for (size_t i = 0; i < UTIL::PROGRESS_CAPACITY + EXTRA; ++i)
+            accepted += channel->post({0, UTIL::ProgressStage::Item, UTIL::ProgressCode::Ok, static_cast<int32_t>(i)}) ? 1 : 0;
+        expect(accepted == UTIL::PROGRESS_CAPACITY && channel->dropped() == EXTRA, "full ring: accepts its capacity, drops and counts the rest");
+
+        int32_t expected = 0;
+        bool inOrder = true;
+        const size_t drained = channel->drain([&](const UTIL::ProgressEvent &event)
+                                              { inOrder &= event.detail == expected++; });
+        expect(drained == UTIL::PROGRESS_CAPACITY && inOrder, "drain: the accepted events, oldest first, none of the dropped ones");
+        expect(channel->drain([](const UTIL::ProgressEvent &) {}) == 0, "drained ring is empty");
+
+        // Fill and empty it many times over, with a different fill level each lap
+        bool laps = true;
+        int32_t next = 0;
+        for (int lap = 0; lap < 1000; ++lap)
+        {
+            const size_t fill = 1 + (static_cast<size_t>(lap) * 37) % UTIL::PROGRESS_CAPACITY;
+            const int32_t first = next;
+            for (size_t i = 0; i < fill; ++i)
+                laps &= channel->post({0, UTIL::ProgressStage::Item, UTIL::ProgressCode::Ok, next++});
+            int32_t seen = first;
+            laps &= channel->drain([&](const UTIL::ProgressEvent &event)
+                                   { laps &= event.detail == seen++; }) == fill;
+        }
+        expect(laps && channel->dropped() == EXTRA, "1000 laps at varying fill: nothing dropped, order kept");
+    }
+
+    void producers()
+    {
+        constexpr int THREADS = 8;
+        constexpr int32_t EACH = 200000;
+        auto channel = std::make_unique<UTIL::ProgressChannel>();
+        std::atomic<int> running{THREADS};
+        std::vector<uint64_t> refused(THREADS);
+        std::vector<std::thread> threads;
+        const auto start = std::chrono::steady_clock::now();
+        for (int t = 0; t < THREADS; ++t)
+            threads.emplace_back([&, t]
+                                 {
+                                     UTIL::ProgressScope scope(*channel, static_cast<uint32_t>(t));
+                                     for (int32_t i = 0; i < EACH; ++i)
+                                     {
+                                         // Half through report(), as workers do; it does not say whether the event fitted
+                                         if (i % 2 != 0)
+                                             UTIL::report(UTIL::ProgressStage::Download, UTIL::ProgressCode::Ok, i);
+                                         else if (!channel->post({static_cast<uint32_t>(t), UTIL::ProgressStage::Download, UTIL::ProgressCode::Ok, i}))
+                                             ++refused[t];
+                                         if (i % 256 == 0) // bursts, so the ring fills and empties many times
+                                             std::this_thread::sleep_for(std::chrono::microseconds(20));
+                                     }
+                                     running.fetch_sub(1); });
+
+        // Slow consumer: drains in bursts, like a UI frame
+        std::vector<int32_t> last(THREADS, -1);
+        uint64_t drained = 0;
+        bool ordered = true, tagged = true;
+        const auto take = [&](const UTIL::ProgressEvent &event)
+        {
+            if (event.item >= THREADS)
+            {
+                tagged = false;
+                return;
+            }
+            ordered &= event.detail > last[event.item];
+            last[event.item] = event.detail;
+            ++drained;
+        };
+        while (running.load() > 0)
+        {
+            channel->drain(take);
+            std::this_thread::sleep_for(std::chrono::microseconds(500));
+        }
+        for (std::thread &thread : threads)
+            thread.join();
+        channel->drain(take);
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        const uint64_t total = static_cast<uint64_t>(THREADS) * EACH;
+        const uint64_t dropped = channel->dropped();
+        uint64_t refusedPosts = 0;
+        for (const uint64_t r : refused)
+            refusedPosts += r;
+        std::printf("  %d producers, %llu events in %.2f s: %llu drained, %llu dropped (%.1f%%)\n", THREADS,
+                    static_cast<unsigned long long>(total), seconds, static_cast<unsigned long long>(drained),
+                    static_cast<unsigned long long>(dropped), 100.0 * dropped / total);
+        expect(tagged, "every event carries its producer's ProgressScope item");
+        expect(drained + dropped == total, "drained + dropped == posted, nothing lost or doubled");
+        expect(refusedPosts <= dropped && dropped > 0, "post() returned false for dropped events, and the ring did overflow");
+        expect(ordered, "each producer's events drained in the order it posted them");
+    }
+} // namespace
+
+int main()
+{
+    singleThreaded();
+    producers();
+    std::puts(ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,181 @@
+// Host benchmark for the thumbnail resize tiers. Each sample image is scaled to the 150 px
+// thumbnail height with Fast (resizeBoxUint8), Linear and High (stb_image_resize), and each
+// tier reports source megapixels per second (best of several runs) and PSNR against the
+// High output, on premultiplied RGBA so hidden colors under transparent pixels do not
+// count. Fast is also timed against a plain per-pixel box filter, which it must match
+// byte for byte, here and on random sizes, strides and channel counts; that covers the
+// SIMD row accumulation (SSE2 on x86-64, NEON on the Switch).
+//
+// Usage: g++ -std=c++17 -O2 -Iinclude tools/resizebench.cpp source/stb_impl.cpp -lcurl -lpthread -o resizebench && ./resizebench [image.png...]
+//
+// Without arguments it runs on synthetic figure renders. Exits non-zero if Fast differs
+// from the plain filter.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "benchimage.hpp"
+#include "util.hpp"
+
+namespace
+{
+    constexpr int RUNS = 7;
+
+    template <typename Work>
+    [[nodiscard]] double bestMs(Work &&work)
+    {
+        double best = 1e30;
+        for (int run = 0; run < RUNS; ++run)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            work();
+            best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+        return best;
+    }
+
+    // One output pixel at a time, straight from the definition in boxresize.hpp
+    void plainBox(const uint8_t *src, int srcWidth, int srcHeight, int srcStride, uint8_t *dst, int dstWidth, int dstHeight, int channels)
+    {
+        const auto span = [](int out, int srcSize, int dstSize, int &begin, int &end)
+        {
+            begin = static_cast<int>(static_cast<int64_t>(out) * srcSize / dstSize);
+            end = std::min(std::max(static_cast<int>(static_cast<int64_t>(out + 1) * srcSize / dstSize), begin + 1), srcSize);
+        };
+        for (int oy = 0; oy < dstHeight; ++oy)
+            for (int ox = 0; ox < dstWidth; ++ox)
+            {
+                int x0, x1, y0, y1;
+                span(ox, srcWidth, dstWidth, x0, x1);
+                span(oy, srcHeight, dstHeight, y0, y1);
+                uint64_t sum[4] = {0, 0, 0, 0};
+                for (int y = y0; y < y1; ++y)
+                    for (int x = x0; x < x1; ++x)
+                    {
+                        const uint8_t *p = src + static_cast<size_t>(y) * srcStride + static_cast<size_t>(x) * channels;
+                        for (int ch = 0; ch < channels; ++ch)
+                            sum[ch] += channels == 4 && ch < 3 ? static_cast<uint64_t>(p[ch]) * p[3] : p[ch];
+                    }
+                const uint64_t count = static_cast<uint64_t>(x1 - x0) * (y1 - y0);
+                uint8_t *px = dst + (static_cast<size_t>(oy) * dstWidth + ox) * channels;
+                for (int ch = 0; ch < channels; ++ch)
+                    if (channels == 4 && ch < 3)
+                        px[ch] = sum[3] ? static_cast<uint8_t>((sum[ch] + sum[3] / 2) / sum[3]) : 0;
+                    else
+                        px[ch] = static_cast<uint8_t>((sum[ch] + count / 2) / count);
+            }
+    }
+
+    [[nodiscard]] double psnr(const std::vector<uint8_t> &a, const std::vector<uint8_t> &b)
+    {
+        double sum = 0;
+        for (size_t i = 0; i < a.size(); i += 4)
+        {
+            for (int c = 0; c < 3; ++c)
+            {
+                const double d = (a[i + c] * a[i + 3] - b[i + c] * b[i + 3]) / 255.0;
+                sum += d * d;
+            }
+            sum += static_cast<double>(a[i + 3] - b[i + 3]) * (a[i + 3] - b[i + 3]);
+        }
+        const double mse = sum / static_cast<double>(a.size());
+        return mse == 0 ? 99.0 : 10.0 * std::log10(255.0 * 255.0 / mse);
+    }
+
+    [[nodiscard]] bool randomSizes()
+    {
+        std::mt19937 rng(78);
+        int cases = 0;
+        for (int round = 0; round < 3000; ++round)
+        {
+            const int channels = 1 + static_cast<int>(rng() % 4);
+            const int sw = 1 + static_cast<int>(rng() % 300), sh = 1 + static_cast<int>(rng() % 300);
+            const int dw = 1 + static_cast<int>(rng() % 200), dh = 1 + static_cast<int>(rng() % 200);
+            const int stride = sw * channels + static_cast<int>(rng() % 9);
+            std::vector<uint8_t> src(static_cast<size_t>(stride) * sh);
+            const bool sparse = rng() % 2; // mostly transparent, like a figure's margins
+            for (uint8_t &v : src)
+                v = sparse && rng() % 3 ? 0 : static_cast<uint8_t>(rng());
+            std::vector<uint8_t> fast(static_cast<size_t>(dw) * dh * channels), plain(fast.size());
+            if (!UTIL::resizeBoxUint8(src.data(), sw, sh, stride, fast.data(), dw, dh, channels))
+                return false;
+            plainBox(src.data(), sw, sh, stride, plain.data(), dw, dh, channels);
+            if (fast != plain)
+            {
+                std::fprintf(stderr, "%dx%d (stride %d, %d channels) -> %dx%d differs from the plain filter\n", sw, sh, stride, channels, dw, dh);
+                return false;
+            }
+            ++cases;
+        }
+        std::printf("%d random sizes, strides and channel counts: Fast matches the plain filter\n", cases);
+        return true;
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+#if defined(AMIIBO_BOXRESIZE_NEON)
+    std::puts("box filter rows: NEON");
+#elif defined(AMIIBO_BOXRESIZE_SSE2)
+    std::puts("box filter rows: SSE2");
+#else
+    std::puts("box filter rows: scalar");
+#endif
+    bool ok = randomSizes();
+
+    constexpr UTIL::ResizeQuality TIERS[] = {UTIL::ResizeQuality::Fast, UTIL::ResizeQuality::Linear, UTIL::ResizeQuality::High};
+    double totalMs[UTIL::RESIZE_QUALITY_COUNT] = {}, plainMs = 0, worstPsnr[UTIL::RESIZE_QUALITY_COUNT] = {99, 99, 99};
+    double megapixels = 0;
+    for (const BENCH::Image &image : BENCH::corpus(argc, argv))
+    {
+        const int height = UTIL::TARGET_IMAGE_HEIGHT;
+        const int width = std::max(1, image.width * height / image.height);
+        std::vector<uint8_t> out[UTIL::RESIZE_QUALITY_COUNT];
+        double ms[UTIL::RESIZE_QUALITY_COUNT];
+        for (const UTIL::ResizeQuality tier : TIERS)
+        {
+            const int t = static_cast<int>(tier);
+            out[t].resize(static_cast<size_t>(width) * height * 4);
+            ms[t] = bestMs([&]
+                           {
+                               if (!UTIL::resizeImage(image.rgba.data(), image.width, image.height, image.width * 4, out[t].data(), width, height, 4, tier))
+                                   std::exit(1); });
+            totalMs[t] += ms[t];
+        }
+        std::vector<uint8_t> plain(out[0].size());
+        const double plainImageMs = bestMs([&]
+                                           { plainBox(image.rgba.data(), image.width, image.height, image.width * 4, plain.data(), width, height, 4); });
+        plainMs += plainImageMs;
+        const bool same = plain == out[0];
+        ok &= same;
+
+        const double mp = static_cast<double>(image.width) * image.height / 1e6;
+        megapixels += mp;
+        std::printf("%-22s -> %3dx%d:", image.name.c_str(), width, height);
+        for (const UTIL::ResizeQuality tier : TIERS)
+        {
+            const int t = static_cast<int>(tier);
+            const double quality = psnr(out[t], out[2]);
+            worstPsnr[t] = std::min(worstPsnr[t], quality);
+            std::printf("  %s %6.3f ms %5.0f MP/s", UTIL::RESIZE_QUALITY_NAMES[t].data(), ms[t], mp / ms[t] * 1e3);
+            if (tier != UTIL::ResizeQuality::High)
+                std::printf(" %4.1f dB", quality);
+        }
+        std::printf("  | plain box %6.3f ms%s\n", plainImageMs, same ? "" : " DIFFERS");
+    }
+
+    std::printf("total %.1f MP:", megapixels);
+    for (const UTIL::ResizeQuality tier : TIERS)
+    {
+        const int t = static_cast<int>(tier);
+        std::printf("  %s %6.2f ms %5.0f MP/s", UTIL::RESIZE_QUALITY_NAMES[t].data(), totalMs[t], megapixels / totalMs[t] * 1e3);
+        if (tier != UTIL::ResizeQuality::High)
+            std::printf(" worst %4.1f dB vs high", worstPsnr[t]);
+    }
+    std::printf("  | plain box %.2f ms\n", plainMs);
+    std::puts(ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
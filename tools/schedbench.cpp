@@ -0,0 +1,186 @@
+// Host benchmark for Scheduler priorities: a three-worker pool, as on the Switch, runs a
+// 1000-figure batch (each task decodes a full-size PNG, resizes it to the thumbnail height
+// and encodes the result, like loadAndResizeImageInRatio without the SD card) while a UI
+// loop moves the cursor every 16.7 ms frame, queueing the cursor's preview as Interactive
+// and six visible rows as Prefetch, each a thumbnail decode. Reports how long preview tasks
+// wait to start and to finish, and batch throughput, for:
+//   - the UI alone, and the batch alone, as baselines;
+//   - both together with priorities;
+//   - both together with the previews queued as Batch, i.e. one FIFO pool.
+//
+// Usage: g++ -std=c++17 -O2 -Iinclude tools/schedbench.cpp source/stb_impl.cpp -lcurl -lpthread -o schedbench && ./schedbench
+//
+// Exits non-zero if a batch task is lost or if, with priorities, cursor previews under the
+// batch wait more than 2 ms to start: at the 99th percentile when there is a hardware
+// thread per worker, at the median otherwise (the OS then time-slices the workers, which
+// no queue order can help).
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "benchimage.hpp"
+#include "scheduler.hpp"
+#include "util.hpp"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr int WORKERS = 3, FIGURES = 1000, PREFETCH_ROWS = 6;
+    constexpr auto FRAME = std::chrono::microseconds(16667);
+
+    struct Samples
+    {
+        std::mutex mutex;
+        std::vector<double> startUs, doneUs;
+
+        void add(Clock::time_point submitted, Clock::time_point started)
+        {
+            const auto now = Clock::now();
+            std::lock_guard<std::mutex> lock(mutex);
+            startUs.push_back(std::chrono::duration<double, std::micro>(started - submitted).count());
+            doneUs.push_back(std::chrono::duration<double, std::micro>(now - submitted).count());
+        }
+    };
+
+    [[nodiscard]] double percentile(std::vector<double> values, int p)
+    {
+        if (values.empty())
+            return 0.0;
+        std::sort(values.begin(), values.end());
+        return values[std::min(values.size() - 1, values.size() * static_cast<size_t>(p) / 100)];
+    }
+
+    [[nodiscard]] std::vector<uint8_t> encodePng(const BENCH::Image &image)
+    {
+        std::vector<uint8_t> png;
+        stbi_write_png_to_func(UTIL::appendPngBytes, &png, image.width, image.height, 4, image.rgba.data(), image.width * 4);
+        return png;
+    }
+
+    void decodeResizeEncode(const std::vector<uint8_t> &png)
+    {
+        int w = 0, h = 0, channels = 0;
+        unsigned char *pixels = stbi_load_from_memory(png.data(), static_cast<int>(png.size()), &w, &h, &channels, 4);
+        if (!pixels)
+            return;
+        const int height = UTIL::TARGET_IMAGE_HEIGHT, width = std::max(1, w * height / h);
+        std::vector<uint8_t> small(static_cast<size_t>(width) * height * 4), out;
+        if (UTIL::resizeImage(pixels, w, h, w * 4, small.data(), width, height, 4, UTIL::ResizeQuality::Linear))
+            stbi_write_png_to_func(UTIL::appendPngBytes, &out, width, height, 4, small.data(), width * 4);
+        stbi_image_free(pixels);
+    }
+
+    void decode(const std::vector<uint8_t> &png)
+    {
+        int w = 0, h = 0, channels = 0;
+        stbi_image_free(stbi_load_from_memory(png.data(), static_cast<int>(png.size()), &w, &h, &channels, 4));
+    }
+
+    struct Inputs
+    {
+        std::vector<std::vector<uint8_t>> figures, thumbnails;
+    };
+
+    struct Outcome
+    {
+        Samples cursor, prefetch;
+        int frames = 0, batchDone = 0;
+        double batchSeconds = 0;
+    };
+
+    // Runs the batch (if any) and the UI loop (for `uiFrames`, or for as long as the batch
+    // runs when 0) on one pool, then waits for every task
+    void run(const Inputs &inputs, bool batch, bool ui, int uiFrames, UTIL::TaskPriority cursorPriority,
+             UTIL::TaskPriority prefetchPriority, Outcome &outcome)
+    {
+        std::atomic<int> batchDone{0};
+        Clock::time_point batchStart = Clock::now(), batchEnd = batchStart;
+        std::mutex endMutex;
+        {
+            UTIL::Scheduler scheduler(WORKERS);
+            if (batch)
+                for (int i = 0; i < FIGURES; ++i)
+                    scheduler.submit(UTIL::TaskPriority::Batch, [&, i]
+                                     {
+                                         decodeResizeEncode(inputs.figures[static_cast<size_t>(i) % inputs.figures.size()]);
+                                         if (batchDone.fetch_add(1) + 1 == FIGURES)
+                                         {
+                                             std::lock_guard<std::mutex> lock(endMutex);
+                                             batchEnd = Clock::now();
+                                         } });
+
+            auto next = Clock::now();
+            for (int frame = 0; ui && (uiFrames ? frame < uiFrames : batchDone.load() < FIGURES); ++frame)
+            {
+                const auto submitted = Clock::now();
+                for (int row = 0; row <= PREFETCH_ROWS; ++row)
+                {
+                    Samples &samples = row == 0 ? outcome.cursor : outcome.prefetch;
+                    const std::vector<uint8_t> &png = inputs.thumbnails[static_cast<size_t>(frame + row) % inputs.thumbnails.size()];
+                    scheduler.submit(row == 0 ? cursorPriority : prefetchPriority, [&samples, &png, submitted]
+                                     {
+                                         const auto started = Clock::now();
+                                         decode(png);
+                                         samples.add(submitted, started); });
+                }
+                ++outcome.frames;
+                next += FRAME;
+                std::this_thread::sleep_until(next);
+            }
+        }
+        outcome.batchDone = batchDone.load();
+        outcome.batchSeconds = std::chrono::duration<double>(batchEnd - batchStart).count();
+    }
+
+    void print(const char *name, const Outcome &outcome)
+    {
+        std::printf("%s\n", name);
+        if (outcome.frames)
+            for (const auto &[label, samples] : {std::pair<const char *, const Samples &>{"cursor preview", outcome.cursor}, {"prefetch rows", outcome.prefetch}})
+                std::printf("  %-15s %5zu tasks  start p50 %8.0f us  p99 %8.0f us  worst %8.0f us | done p50 %8.0f us  p99 %8.0f us\n",
+                            label, samples.startUs.size(), percentile(samples.startUs, 50), percentile(samples.startUs, 99),
+                            percentile(samples.startUs, 100), percentile(samples.doneUs, 50), percentile(samples.doneUs, 99));
+        if (outcome.batchDone)
+            std::printf("  batch           %5d figures in %.2f s (%.0f per second)\n", outcome.batchDone, outcome.batchSeconds,
+                        outcome.batchDone / outcome.batchSeconds);
+    }
+} // namespace
+
+int main()
+{
+    Inputs inputs;
+    for (uint32_t seed = 1; seed <= 8; ++seed)
+    {
+        const BENCH::Image figure = BENCH::syntheticFigure(480, 640, seed);
+        inputs.figures.push_back(encodePng(figure));
+        BENCH::Image thumbnail{"", 112, UTIL::TARGET_IMAGE_HEIGHT, std::vector<uint8_t>(static_cast<size_t>(112) * UTIL::TARGET_IMAGE_HEIGHT * 4)};
+        if (!UTIL::resizeImage(figure.rgba.data(), figure.width, figure.height, figure.width * 4, thumbnail.rgba.data(), thumbnail.width,
+                               thumbnail.height, 4, UTIL::ResizeQuality::Linear))
+            return 1;
+        inputs.thumbnails.push_back(encodePng(thumbnail));
+    }
+    std::printf("%d workers on %u hardware threads\n", WORKERS, std::thread::hardware_concurrency());
+
+    using UTIL::TaskPriority;
+    Outcome idle, alone, prioritized, fifo;
+    run(inputs, false, true, 300, TaskPriority::Interactive, TaskPriority::Prefetch, idle);
+    print("UI alone, 300 frames", idle);
+    run(inputs, true, false, 0, TaskPriority::Interactive, TaskPriority::Prefetch, alone);
+    print("batch alone", alone);
+    run(inputs, true, true, 0, TaskPriority::Interactive, TaskPriority::Prefetch, prioritized);
+    print("batch and UI, with priorities", prioritized);
+    run(inputs, true, true, 0, TaskPriority::Batch, TaskPriority::Batch, fifo);
+    print("batch and UI, previews queued as batch (one FIFO pool)", fifo);
+
+    const bool ownCores = std::thread::hardware_concurrency() >= WORKERS;
+    const double start = percentile(prioritized.cursor.startUs, ownCores ? 99 : 50);
+    const bool ok = prioritized.batchDone == FIGURES && fifo.batchDone == FIGURES && start <= 2000.0;
+    std::puts(ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
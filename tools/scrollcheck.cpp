@@ -0,0 +1,202 @@
+// Host check for KineticScroller: replays touch histories (finger y per frame, or lifted)
+// frame by frame the way AmiiboMenu::touchHandler feeds them. Checks that taps stay taps,
+// drags follow the finger, flings decay, stop and respect both ends, a touch stops a
+// fling, and a fling released at the same speed travels as far at 30 as at 60 fps.
+//
+// Usage: g++ -std=c++17 -O2 -Iinclude tools/scrollcheck.cpp -o scrollcheck && ./scrollcheck
+//
+// Exits non-zero if a check fails.
+
+#include <cmath>
+#include <cstdio>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include "kinetic.hpp"
+
+namespace
+{
+    constexpr float ROW = 15.0f; // UI::FONT::GLYPH_HEIGHT
+    constexpr int VISIBLE = 20;
+
+    using History = std::vector<std::optional<float>>; // finger y per frame, nullopt when lifted
+
+    struct Replay
+    {
+        UI::KineticScroller scroller{ROW};
+        int taps = 0;
+        float lowest = 1e9f, highest = -1e9f;
+        bool monotonicAfterRelease = true;
+        int framesToRest = -1; // after the last release
+
+        Replay(int rows) { scroller.setRange(rows, VISIBLE); }
+
+        // Plus `settle` frames without a finger
+        void run(const History &history, float dt, int settle)
+        {
+            bool held = false;
+            int released = -1;
+            float last = scroller.position();
+            const auto frame = [&](const std::optional<float> &finger, int index)
+            {
+                if (finger && !held)
+                {
+                    held = true;
+                    scroller.press(*finger);
+                }
+                else if (finger)
+                    scroller.drag(*finger, dt);
+                else if (held)
+                {
+                    held = false;
+                    taps += scroller.release() ? 1 : 0;
+                    released = index;
+                    last = scroller.position();
+                }
+                scroller.step(dt);
+                const float position = scroller.position();
+                lowest = std::min(lowest, position);
+                highest = std::max(highest, position);
+                if (released >= 0 && !held)
+                {
+                    // A fling keeps going one way
+                    if ((scroller.velocity() > 0.0f && position < last) || (scroller.velocity() < 0.0f && position > last))
+                        monotonicAfterRelease = false;
+                    if (framesToRest < 0 && !scroller.moving())
+                        framesToRest = index - released;
+                }
+                last = position;
+            };
+            int index = 0;
+            for (const auto &finger : history)
+                frame(finger, index++);
+            for (int i = 0; i < settle; ++i)
+                frame(std::nullopt, index++);
+        }
+    };
+
+    // Finger from `from` to `to` over `frames` frames, then `hold` frames still, then lifted
+    History swipe(float from, float to, int frames, int hold = 0)
+    {
+        History history;
+        for (int i = 0; i <= frames; ++i)
+            history.push_back(from + (to - from) * static_cast<float>(i) / static_cast<float>(std::max(frames, 1)));
+        for (int i = 0; i < hold; ++i)
+            history.push_back(to);
+        history.push_back(std::nullopt);
+        return history;
+    }
+
+    bool ok = true;
+
+    void expect(bool condition, const char *what)
+    {
+        std::printf("%-64s %s\n", what, condition ? "ok" : "FAILED");
+        ok &= condition;
+    }
+} // namespace
+
+int main()
+{
+    constexpr float DT = 1.0f / 60.0f;
+
+    {
+        Replay replay(500);
+        replay.scroller.jumpTo(50);
+        replay.run({300.0f, 301.0f, 299.0f, 302.0f, 301.0f, std::nullopt}, DT, 30);
+        expect(replay.taps == 1 && replay.scroller.firstRow() == 50 && !replay.scroller.moving(), "tap that wanders 5 px: counted as a tap, list stays put");
+    }
+    {
+        Replay replay(500);
+        replay.scroller.jumpTo(100);
+        replay.run(swipe(400.0f, 250.0f, 60, 15), DT, 120);
+        expect(replay.taps == 0 && std::fabs(replay.scroller.position() - 110.0f) < 0.5f,
+               "slow drag of 150 px, held, released: follows the finger by 10 rows");
+    }
+    {
+        Replay replay(5000);
+        replay.run(swipe(600.0f, 300.0f, 6), DT, 600);
+        const float released = 300.0f / ROW;
+        std::printf("  fling: %.1f rows at release, came to rest at row %.1f after %d frames\n", released,
+                    replay.scroller.position(), replay.framesToRest);
+        expect(replay.scroller.position() > released + 20.0f && replay.monotonicAfterRelease && replay.framesToRest > 0 &&
+                   replay.framesToRest < 5 * 60,
+               "fling: keeps going after release, one way, rests within 5 s");
+    }
+    {
+        Replay replay(5000);
+        replay.run(swipe(100.0f, 600.0f, 4), DT, 600);
+        expect(replay.lowest == 0.0f && replay.highest == 0.0f && !replay.scroller.moving(), "fling past the top: stays at row 0 and stops");
+    }
+    {
+        Replay replay(60);
+        replay.run(swipe(700.0f, 100.0f, 5), DT, 600);
+        expect(replay.scroller.position() == 40.0f && replay.highest == 40.0f && !replay.scroller.moving(),
+               "fling past the end of 60 rows: stops at the last page (row 40)");
+    }
+    {
+        Replay replay(5000);
+        History history = swipe(600.0f, 300.0f, 6);
+        for (int i = 0; i < 10; ++i)
+            history.push_back(std::nullopt);
+        history.push_back(500.0f); // finger down again mid-fling
+        history.push_back(500.0f);
+        replay.run(history, DT, 0);
+        const float caught = replay.scroller.position();
+        replay.run({500.0f, std::nullopt}, DT, 120);
+        expect(replay.taps == 1 && replay.scroller.position() == caught, "touch during a fling: stops it, and that touch is a tap");
+    }
+    {
+        Replay replay(5000);
+        replay.run(swipe(600.0f, 300.0f, 6), DT, 20);
+        replay.scroller.setRange(30, VISIBLE);
+        replay.run({}, DT, 120);
+        expect(replay.scroller.position() <= 10.0f && !replay.scroller.moving(), "list shrinks mid-fling: position clamps to the new end");
+    }
+    {
+        Replay replay(100000);
+        replay.run(swipe(700.0f, 0.0f, 1), DT, 0);
+        expect(replay.scroller.velocity() <= UI::SCROLL_MAX_VELOCITY, "flick of 700 px in a frame: velocity capped");
+    }
+    {
+        // Noisy samples around a steady 30 rows/s drag
+        std::mt19937 rng(83);
+        std::normal_distribution<float> noise(0.0f, 2.0f);
+        Replay replay(5000);
+        History history;
+        for (int i = 0; i <= 40; ++i)
+            history.push_back(700.0f - i * 30.0f * ROW * DT + noise(rng));
+        replay.run(history, DT, 0);
+        replay.scroller.release();
+        std::printf("  jittery drag at 30 rows/s: released at %.1f rows/s\n", replay.scroller.velocity());
+        expect(std::fabs(replay.scroller.velocity() - 30.0f) < 6.0f, "jittery drag: release velocity within 20% of the finger's");
+    }
+    {
+        // Same finger speed sampled at 60 and 30 Hz. The velocity estimate is smoothed per
+        // sample, so the drag lasts long enough (0.5 s) for it to settle at either rate.
+        float travel[2];
+        for (const int rate : {60, 30})
+        {
+            Replay replay(100000);
+            const float dt = 1.0f / static_cast<float>(rate);
+            History history;
+            for (int i = 0; i <= rate / 2; ++i)
+                history.push_back(700.0f - i * 40.0f * ROW * dt); // 40 rows/s for 0.5 s
+            history.push_back(std::nullopt);
+            replay.run(history, dt, rate * 10);
+            travel[rate == 60 ? 0 : 1] = replay.scroller.position();
+        }
+        std::printf("  fling at 40 rows/s: %.1f rows at 60 fps, %.1f rows at 30 fps\n", travel[0], travel[1]);
+        expect(std::fabs(travel[0] - travel[1]) < 0.05f * travel[0], "fling distance at 30 fps within 5% of 60 fps");
+    }
+    {
+        Replay replay(500);
+        replay.run(swipe(600.0f, 300.0f, 6), DT, 5);
+        replay.scroller.jumpTo(1000);
+        expect(replay.scroller.position() == 480.0f && !replay.scroller.moving(), "D-pad jump during a fling: stops it, clamped to the end");
+    }
+
+    std::puts(ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
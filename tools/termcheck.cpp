@@ -0,0 +1,209 @@
+// Host stress check for Terminal's inbox and render thread. Each case drives a terminal
+// from several threads, stops the render thread (which draws the last published state)
+// and compares the presented frame pixel for pixel with a fresh terminal that drew the
+// expected final grid in one full frame:
+//   - posters on four threads queue single characters while the owner presents: none
+//     may be lost or doubled, so the wrapped text must fill exactly as many cells;
+//   - one poster queues numbered lines: the last screen must show them in order;
+//   - the owner rewrites random rows, styles and a preview image as fast as it can while
+//     the render thread draws only what changed in each buffer.
+// Also prints frame statistics (frames, coalesced states, frame time, input latency).
+//
+// Usage: g++ -std=c++17 -O2 -Iinclude tools/termcheck.cpp -lpthread -o termcheck && ./termcheck
+//
+// Exits non-zero if a frame differs.
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "terminal.hpp"
+
+namespace
+{
+    using UI::Terminal;
+
+    struct Line
+    {
+        std::string text;
+        UI::Style style = UI::STYLE_NORMAL;
+        int styleCols = Terminal::COLS;
+    };
+
+    struct Picture
+    {
+        int x = 0, y = 0, width = 0, height = 0;
+        const std::vector<uint8_t> *rgba = nullptr;
+    };
+
+    // What a terminal that drew `lines` and `picture` from scratch shows
+    [[nodiscard]] std::vector<uint32_t> expectedFrame(const std::vector<Line> &lines, const Picture &picture)
+    {
+        auto terminal = std::make_unique<Terminal>();
+        for (int r = 0; r < Terminal::ROWS && r < static_cast<int>(lines.size()); ++r)
+            terminal->setLine(r, lines[r].text, lines[r].style, lines[r].styleCols);
+        if (picture.rgba)
+            terminal->setImage(picture.x, picture.y, picture.width, picture.height, picture.rgba->data());
+        terminal->present();
+        const uint32_t *front = terminal->framebuffer().front();
+        return std::vector<uint32_t>(front, front + static_cast<size_t>(UI::SCREEN_WIDTH) * UI::SCREEN_HEIGHT);
+    }
+
+    bool compare(const char *name, const Terminal &terminal, const std::vector<uint32_t> &expected)
+    {
+        const uint32_t *front = terminal.framebuffer().front();
+        size_t differing = 0, first = expected.size();
+        for (size_t i = 0; i < expected.size(); ++i)
+            if (!front || front[i] != expected[i])
+            {
+                first = std::min(first, i);
+                ++differing;
+            }
+        const UI::FrameStats stats = terminal.stats();
+        std::printf("%-28s %6llu frames, %6llu coalesced, %6llu skipped, last frame %4.0f us, worst input latency %5.2f ms: %s\n",
+                    name, static_cast<unsigned long long>(stats.frames), static_cast<unsigned long long>(stats.coalesced),
+                    static_cast<unsigned long long>(stats.skipped), stats.frameNs / 1e3, stats.maxLatencyNs / 1e6,
+                    differing == 0 ? "matches" : "DIFFERS");
+        if (differing)
+            std::fprintf(stderr, "  %zu pixels differ, first at (%zu, %zu)\n", differing, first % UI::SCREEN_WIDTH, first / UI::SCREEN_WIDTH);
+        return differing == 0;
+    }
+
+    // Owner presents until `done`, the way the menu loop does between inputs
+    template <typename Done>
+    void presentUntil(Terminal &terminal, Done &&done)
+    {
+        while (!done())
+        {
+            terminal.present();
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+        terminal.present();
+    }
+
+    bool posterCount()
+    {
+        constexpr int THREADS = 4, EACH = 1500; // 6000 cells: 37 full rows and a partial one
+        auto terminal = std::make_unique<Terminal>();
+        terminal->startRendering();
+        std::atomic<int> finished{0};
+        std::vector<std::thread> posters;
+        for (int t = 0; t < THREADS; ++t)
+            posters.emplace_back([&]
+                                 {
+                                     for (int i = 0; i < EACH; ++i)
+                                     {
+                                         terminal->post("x");
+                                         if (i % 5 == 0) // spread over many presents
+                                             std::this_thread::sleep_for(std::chrono::microseconds(50));
+                                     }
+                                     finished.fetch_add(1); });
+        presentUntil(*terminal, [&]
+                     { return finished.load() == THREADS; });
+        for (std::thread &poster : posters)
+            poster.join();
+        terminal->present();
+        terminal->stopRendering();
+
+        std::vector<Line> lines;
+        for (int cells = THREADS * EACH; cells > 0; cells -= Terminal::COLS)
+            lines.push_back({std::string(static_cast<size_t>(std::min(cells, Terminal::COLS)), 'x')});
+        return compare("4 posters, 6000 cells", *terminal, expectedFrame(lines, {}));
+    }
+
+    bool posterOrder()
+    {
+        constexpr int LINES = 20000;
+        auto terminal = std::make_unique<Terminal>();
+        terminal->startRendering();
+        std::atomic<bool> finished{false};
+        std::thread poster([&]
+                           {
+                               char line[32];
+                               for (int i = 0; i < LINES; ++i)
+                               {
+                                   std::snprintf(line, sizeof(line), "line %05d\n", i);
+                                   terminal->post(line, i % 2 ? UI::STYLE_ERROR : UI::STYLE_NORMAL);
+                                   if (i % 20 == 0)
+                                       std::this_thread::sleep_for(std::chrono::microseconds(50));
+                               }
+                               finished = true; });
+        presentUntil(*terminal, [&]
+                     { return finished.load(); });
+        poster.join();
+        terminal->present();
+        terminal->stopRendering();
+
+        // The last line's newline scrolled the screen, leaving the bottom row empty
+        std::vector<Line> lines;
+        char text[32];
+        for (int i = LINES - (Terminal::ROWS - 1); i < LINES; ++i)
+        {
+            std::snprintf(text, sizeof(text), "line %05d", i);
+            lines.push_back({text, i % 2 ? UI::STYLE_ERROR : UI::STYLE_NORMAL});
+        }
+        return compare("1 poster, 20000 lines", *terminal, expectedFrame(lines, {}));
+    }
+
+    bool redraws(bool threaded)
+    {
+        std::mt19937 rng(82);
+        const UI::Style styles[] = {UI::STYLE_NORMAL, UI::STYLE_CURSOR, UI::STYLE_HEADER, UI::STYLE_ERROR};
+        std::vector<std::vector<uint8_t>> images;
+        for (int i = 0; i < 3; ++i)
+        {
+            std::vector<uint8_t> &rgba = images.emplace_back(static_cast<size_t>(200) * 260 * 4);
+            for (size_t p = 0; p < rgba.size(); ++p)
+                rgba[p] = static_cast<uint8_t>(rng());
+        }
+
+        auto terminal = std::make_unique<Terminal>();
+        if (threaded)
+            terminal->startRendering();
+        std::vector<Line> lines(Terminal::ROWS);
+        Picture picture;
+        const auto end = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while (std::chrono::steady_clock::now() < end)
+        {
+            // A cursor move or a few rewritten rows, sometimes a new preview or none
+            for (int k = 1 + static_cast<int>(rng() % 3); k > 0; --k)
+            {
+                Line &line = lines[rng() % Terminal::ROWS];
+                line.text = std::string(rng() % (Terminal::COLS + 20), static_cast<char>('A' + rng() % 26));
+                line.style = styles[rng() % 4];
+                line.styleCols = rng() % 2 ? Terminal::COLS : 100;
+                terminal->setLine(static_cast<int>(&line - lines.data()), line.text, line.style, line.styleCols);
+            }
+            if (rng() % 8 == 0)
+            {
+                if (rng() % 4 == 0)
+                {
+                    picture = {};
+                    terminal->hideImage();
+                }
+                else
+                {
+                    picture = {1000 + static_cast<int>(rng() % 120), 60 + static_cast<int>(rng() % 300), 200, 260, &images[rng() % images.size()]};
+                    terminal->setImage(picture.x, picture.y, picture.width, picture.height, picture.rgba->data());
+                }
+            }
+            terminal->markInput();
+            terminal->present();
+        }
+        terminal->stopRendering();
+        for (Line &line : lines)
+            line.text.resize(std::min<size_t>(line.text.size(), Terminal::COLS));
+        return compare(threaded ? "random redraws, threaded" : "random redraws, inline", *terminal, expectedFrame(lines, picture));
+    }
+} // namespace
+
+int main()
+{
+    const bool ok = posterCount() & posterOrder() & redraws(false) & redraws(true);
+    std::puts(ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
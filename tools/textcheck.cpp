@@ -0,0 +1,188 @@
+// Host check for text folding: accented Latin, full-width, CJK, emoji, typographic
+// punctuation and malformed UTF-8 names must fold into the expected display, search
+// (sort) and path forms. Then, on random byte strings and random mixes of those pieces:
+// validUtf8 and asciiPrefix agree with a plain decoder at every alignment, display forms
+// are printable ASCII, search forms are idempotent, path forms hold nothing SD file
+// systems reject, and whatever non-ASCII text survives is still well-formed UTF-8.
+//
+// Usage: g++ -std=c++17 -O2 -Iinclude tools/textcheck.cpp -o textcheck && ./textcheck
+//
+// Exits non-zero if a check fails.
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "textnorm.hpp"
+
+namespace
+{
+    struct Case
+    {
+        const char *name, *display, *search, *path;
+    };
+
+    const Case CASES[] = {
+        {"Pokémon", "Pokemon", "pokemon", "Pokemon"},
+        {"POKÉMON", "POKEMON", "pokemon", "POKEMON"},
+        {"Çà Déjà Vu!", "Ca Deja Vu!", "ca deja vu", "Ca Deja Vu"},
+        {"Ænima Œuvre", "AEnima OEuvre", "aenima oeuvre", "AEnima OEuvre"},
+        {"Straße", "Strasse", "strasse", "Strasse"},
+        {"Łódź Ħ", "Lodz H", "lodz h", "Lodz H"},
+        {"Mario – Wedding", "Mario - Wedding", "mario wedding", "Mario - Wedding"},
+        {"Wolf Link…", "Wolf Link...", "wolf link", "Wolf Link"},
+        {"“Quoted” ‘Name’", "\"Quoted\" 'Name'", "quoted name", "Quoted Name"},
+        {"Ｍａｒｉｏ", "Mario", "mario", "Mario"},
+        {"Ｐｏｋéｍｏｎ　Ｃｅｎｔｅｒ", "Pokemon Center", "pokemon center", "Pokemon Center"},
+        {"ピカチュウ", "?????", "ピカチュウ", "ピカチュウ"},
+        {"Pikachu (ピカチュウ)", "Pikachu (????" "?)", "pikachu ピカチュウ", "Pikachu (ピカチュウ)"},
+        {"皮卡丘", "???", "皮卡丘", "皮卡丘"},
+        {"피카츄", "???", "피카츄", "피카츄"},
+        {"🎮 Player", "? Player", "🎮 player", "🎮 Player"},
+        {"Zelda: Breath of the Wild", "Zelda: Breath of the Wild", "zelda breath of the wild", "Zelda Breath of the Wild"},
+        {"Mr. Game & Watch", "Mr. Game & Watch", "mr game watch", "Mr Game & Watch"},
+        {"AC/DC", "AC/DC", "ac dc", "AC_DC"},
+        {"  Link  ", "  Link  ", "link", "Link"},
+        {"Dr. Mario?", "Dr. Mario?", "dr mario", "Dr Mario"},
+        {"Bad\xFFName", "Bad?Name", "badname", "BadName"},
+        {"\xC0\xAF", "??", "", ""},
+        {"\xED\xA0\x80", "???", "", ""},
+        {"Cut\xE3\x83", "Cut??", "cut", "Cut"},
+        {"", "", "", ""},
+    };
+
+    // Plain decoder, one byte at a time, for comparison
+    [[nodiscard]] bool plainValid(std::string_view text)
+    {
+        size_t i = 0;
+        while (i < text.size())
+        {
+            const auto c = static_cast<uint8_t>(text[i]);
+            size_t len;
+            uint32_t cp, min;
+            if (c < 0x80)
+                len = 1, cp = c, min = 0;
+            else if ((c & 0xE0) == 0xC0)
+                len = 2, cp = c & 0x1F, min = 0x80;
+            else if ((c & 0xF0) == 0xE0)
+                len = 3, cp = c & 0x0F, min = 0x800;
+            else if ((c & 0xF8) == 0xF0)
+                len = 4, cp = c & 0x07, min = 0x10000;
+            else
+                return false;
+            if (i + len > text.size())
+                return false;
+            for (size_t k = 1; k < len; ++k)
+            {
+                const auto b = static_cast<uint8_t>(text[i + k]);
+                if ((b & 0xC0) != 0x80)
+                    return false;
+                cp = cp << 6 | (b & 0x3F);
+            }
+            if (cp < min || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF))
+                return false;
+            i += len;
+        }
+        return true;
+    }
+
+    [[nodiscard]] size_t plainAsciiPrefix(std::string_view text)
+    {
+        size_t i = 0;
+        while (i < text.size() && static_cast<uint8_t>(text[i]) < 0x80)
+            ++i;
+        return i;
+    }
+
+    [[nodiscard]] std::string quoted(std::string_view text)
+    {
+        std::string out = "\"";
+        for (const char c : text)
+        {
+            char hex[8];
+            std::snprintf(hex, sizeof(hex), "\\x%02X", static_cast<uint8_t>(c));
+            out += static_cast<uint8_t>(c) >= 0x20 && c != '"' ? std::string(1, c) : std::string(hex);
+        }
+        return out + "\"";
+    }
+} // namespace
+
+int main()
+{
+    bool ok = true;
+    int folded = 0;
+    for (const Case &c : CASES)
+    {
+        const std::pair<UTIL::TextForm, const char *> forms[] = {
+            {UTIL::TextForm::Display, c.display}, {UTIL::TextForm::Search, c.search}, {UTIL::TextForm::Path, c.path}};
+        for (const auto &[form, expected] : forms)
+        {
+            const std::string actual = UTIL::foldText(c.name, form);
+            if (actual != expected)
+            {
+                std::fprintf(stderr, "%s as %s: %s, expected %s\n", quoted(c.name).c_str(),
+                             form == UTIL::TextForm::Display ? "display" : form == UTIL::TextForm::Search ? "search" : "path",
+                             quoted(actual).c_str(), quoted(expected).c_str());
+                ok = false;
+            }
+            ++folded;
+        }
+    }
+    std::printf("%d names folded into %d forms as expected\n", static_cast<int>(std::size(CASES)), folded);
+
+    // Names differing only in accents, case or width sort together
+    const char *const SAME[] = {"Pokémon", "Pokemon", "POKÉMON", "Ｐｏｋｅｍｏｎ", "pokémon!"};
+    for (const char *name : SAME)
+        if (UTIL::foldText(name, UTIL::TextForm::Search) != "pokemon")
+        {
+            std::fprintf(stderr, "%s does not sort with pokemon\n", quoted(name).c_str());
+            ok = false;
+        }
+
+    std::mt19937 rng(90);
+    const char *const PIECES[] = {"a", "Z", "9", " ", "  ", ".", "!", "/", ":", "\t", "é", "Œ", "ß", "ｍ", "　", "–", "…",
+                                  "ピ", "皮", "🎮", "\xFF", "\xC0\xAF", "\xED\xA0\x80", "\xE3\x83", "\xF4\x90\x80\x80"};
+    int strings = 0;
+    for (int round = 0; round < 200000 && ok; ++round)
+    {
+        std::string text;
+        if (round % 2 == 0)
+            for (int k = static_cast<int>(rng() % 24); k > 0; --k)
+                text += PIECES[rng() % std::size(PIECES)];
+        else
+            for (int k = static_cast<int>(rng() % 48); k > 0; --k)
+                text += static_cast<char>(rng() % 3 == 0 ? rng() : rng() % 0x80);
+
+        for (size_t offset = 0; offset < std::min<size_t>(text.size(), 17); ++offset)
+        {
+            const std::string_view view = std::string_view(text).substr(offset);
+            if (UTIL::validUtf8(view) != plainValid(view) || UTIL::asciiPrefix(view) != plainAsciiPrefix(view))
+            {
+                std::fprintf(stderr, "validUtf8/asciiPrefix disagree with a plain decoder on %s\n", quoted(view).c_str());
+                ok = false;
+            }
+        }
+
+        const std::string display = UTIL::foldText(text, UTIL::TextForm::Display);
+        const std::string search = UTIL::foldText(text, UTIL::TextForm::Search);
+        const std::string path = UTIL::foldText(text, UTIL::TextForm::Path);
+        bool printable = true, safe = !path.empty() ? path.front() != ' ' && path.back() != ' ' : true;
+        for (const char c : display)
+            printable &= c >= 0x20 && c < 0x7F;
+        for (const char c : path)
+            safe &= c != '/' && !UTIL::detail::unsafeInPath(c);
+        const bool stable = UTIL::foldText(search, UTIL::TextForm::Search) == search;
+        if (!printable || !safe || !stable || !plainValid(search) || !plainValid(path))
+        {
+            std::fprintf(stderr, "%s: display %s%s, search %s%s, path %s%s\n", quoted(text).c_str(), quoted(display).c_str(),
+                         printable ? "" : " (not printable)", quoted(search).c_str(), stable && plainValid(search) ? "" : " (unstable or malformed)",
+                         quoted(path).c_str(), safe && plainValid(path) ? "" : " (unsafe or malformed)");
+            ok = false;
+        }
+        ++strings;
+    }
+    std::printf("%d random strings: validation matches a plain decoder, folded forms well-formed\n", strings);
+    std::puts(ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
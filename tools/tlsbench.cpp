@@ -0,0 +1,165 @@
+// Host benchmark and check for TlsContext against the HTTPS stand-in server. Every request
+// uses a new curl handle and connection, like transfers to hosts the downloader has no
+// idle connection to, so each one costs a TLS handshake. Reports request and handshake
+// latency and, from the server, how many handshakes were full or resumed. Then checks
+// that verification fails closed: a missing bundle and an untrusted server both fail,
+// and only verify = false gets through without a bundle.
+//
+// Host curl uses OpenSSL, which parses the bundle for every handshake in all three modes,
+// so only session resumption shows here; the chain TlsContext parses once is the mbedTLS
+// path on the Switch. Pass a large bundle (system certificates plus cert.pem) to see what
+// that parse costs per handshake.
+//
+// Usage: openssl req -x509 -newkey rsa:2048 -nodes -keyout key.pem -out cert.pem -days 30 -subj /CN=127.0.0.1 -addext subjectAltName=IP:127.0.0.1
+//        tools/dbgen.py serve --port 8443 --cert cert.pem --key key.pem &
+//        g++ -std=c++17 -O2 -Iinclude tools/tlsbench.cpp -lcurl -o tlsbench
+//        ./tlsbench https://127.0.0.1:8443 cert.pem [requests]
+//
+// Exits non-zero if a check fails.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <utility>
+
+#include "tls.hpp"
+
+namespace
+{
+    size_t collect(char *data, size_t size, size_t count, void *out)
+    {
+        static_cast<std::string *>(out)->append(data, size * count);
+        return size * count;
+    }
+
+    struct Result
+    {
+        CURLcode code = CURLE_OK;
+        double totalMs = 0, handshakeMs = 0;
+        std::string body;
+    };
+
+    // One request on a new handle; setup applies the TLS options under test
+    template <typename Setup>
+    Result get(const std::string &url, Setup &&setup)
+    {
+        Result result;
+        CURL *curl = curl_easy_init();
+        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, collect);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &result.body);
+        setup(curl);
+        const auto start = std::chrono::steady_clock::now();
+        result.code = curl_easy_perform(curl);
+        result.totalMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        curl_off_t connect = 0, appConnect = 0;
+        curl_easy_getinfo(curl, CURLINFO_CONNECT_TIME_T, &connect);
+        curl_easy_getinfo(curl, CURLINFO_APPCONNECT_TIME_T, &appConnect);
+        result.handshakeMs = static_cast<double>(appConnect - connect) / 1000.0;
+        curl_easy_cleanup(curl);
+        return result;
+    }
+
+    // {"full": n, "resumed": m} from the stand-in
+    [[nodiscard]] std::pair<long, long> serverHandshakes(const std::string &base)
+    {
+        const Result stats = get(base + "/stats", [](CURL *curl)
+                                 {
+                                     curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
+                                     curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0L); });
+        const auto number = [&](const char *name)
+        {
+            const size_t at = stats.body.find(name);
+            return at == std::string::npos ? -1L : std::strtol(stats.body.c_str() + at + std::string(name).size() + 2, nullptr, 10);
+        };
+        return {number("\"full\""), number("\"resumed\"")};
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        std::fprintf(stderr, "usage: %s <https://host:port> <ca.pem> [requests]\n", argv[0]);
+        return 2;
+    }
+    const std::string base = argv[1], bundle = argv[2];
+    const int requests = argc > 3 ? std::atoi(argv[3]) : 50;
+    const std::string url = base + "/images/icon_00000000-00000002.png";
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+
+    UTIL::TlsContext shared;
+    UTIL::TlsOptions options;
+    options.caBundle = bundle;
+    if (!shared.configure(options))
+    {
+        std::fprintf(stderr, "no certificates in %s\n", bundle.c_str());
+        return 1;
+    }
+
+    struct Mode
+    {
+        const char *name;
+        std::function<void(CURL *)> setup;
+    };
+    const Mode modes[] = {
+        {"no verification (baseline)", [](CURL *curl)
+         {
+             curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
+             curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0L);
+         }},
+        {"verify, CA file read per handle", [&](CURL *curl)
+         { curl_easy_setopt(curl, CURLOPT_CAINFO, bundle.c_str()); }},
+        {"verify, TlsContext (shared)", [&](CURL *curl)
+         { shared.apply(curl); }},
+    };
+
+    bool ok = true;
+    for (const Mode &mode : modes)
+    {
+        const auto before = serverHandshakes(base);
+        double total = 0, handshake = 0;
+        int succeeded = 0;
+        for (int i = 0; i < requests; ++i)
+        {
+            const Result result = get(url, mode.setup);
+            total += result.totalMs;
+            handshake += result.handshakeMs;
+            succeeded += result.code == CURLE_OK && !result.body.empty() ? 1 : 0;
+            if (result.code != CURLE_OK && i == 0)
+                std::fprintf(stderr, "  %s: %s\n", mode.name, curl_easy_strerror(result.code));
+        }
+        const auto after = serverHandshakes(base);
+        std::printf("%-34s %d/%d ok, %6.2f ms/request, handshake %6.2f ms, server: %ld full, %ld resumed\n", mode.name,
+                    succeeded, requests, total / requests, handshake / requests, after.first - before.first, after.second - before.second);
+        ok &= succeeded == requests;
+    }
+
+    // Fails closed: verification stays on without a usable bundle
+    const auto expect = [&](const char *what, const UTIL::TlsOptions &tlsOptions, bool configures, bool transfers)
+    {
+        UTIL::TlsContext context;
+        const bool configured = context.configure(tlsOptions);
+        const Result result = get(url, [&](CURL *curl)
+                                  { context.apply(curl); });
+        const bool passed = configured == configures && (result.code == CURLE_OK) == transfers;
+        std::printf("%-34s configure %s, transfer: %s%s\n", what, configured ? "ok" : "failed",
+                    result.code == CURLE_OK ? "ok" : curl_easy_strerror(result.code), passed ? "" : "  UNEXPECTED");
+        ok &= passed;
+    };
+    UTIL::TlsOptions missing;
+    missing.caBundle = "/nonexistent/cacert.pem";
+    expect("missing bundle", missing, false, false);
+    UTIL::TlsOptions untrusted;
+    untrusted.caBundle = "/etc/ssl/certs/ca-certificates.crt"; // a real bundle, without the test CA
+    expect("untrusted server", untrusted, true, false);
+    UTIL::TlsOptions off = missing;
+    off.verify = false;
+    expect("missing bundle, verify = false", off, true, true);
+
+    curl_global_cleanup();
+    std::puts(ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,200 @@
+// Host check for the tracer: two named threads record nested TraceScopes and async spans
+// that end on the other thread, then the trace is dumped, read back and parsed as JSON.
+// Per tid every complete event ('X') must nest inside the one around it (no partial
+// overlap), the counts must match what was recorded, and every async begin ('b') must
+// have exactly one end ('e') with its id, not earlier. Also checks that a dump drains
+// the rings and that events past a full ring are counted as dropped.
+//
+// Usage: g++ -std=c++17 -O2 -Iinclude tools/tracecheck.cpp -lpthread -o tracecheck
+//        ./tracecheck [trace.json]   (default /tmp/tracecheck.json)
+//
+// Exits non-zero if a check fails.
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <thread>
+#include <vector>
+
+#include "libs/json.hpp"
+#include "trace.hpp"
+
+namespace
+{
+    constexpr int DEPTH = 4, FANOUT = 3, ROUNDS = 20, ASYNC = 50;
+
+    // Scopes nest(depth) records
+    constexpr int scopes(int depth) { return depth == DEPTH ? 0 : FANOUT * (1 + scopes(depth + 1)); }
+
+    void nest(int depth)
+    {
+        if (depth == DEPTH)
+            return;
+        for (int i = 0; i < FANOUT; ++i)
+        {
+            UTIL::TraceScope scope(depth % 2 == 0 ? "outer" : "inner", "check", depth);
+            nest(depth + 1);
+        }
+    }
+
+    struct Span
+    {
+        long long begin, end; // ns
+    };
+
+    [[nodiscard]] long long nanoseconds(const nlohmann::json &us) { return std::llround(us.get<double>() * 1000.0); }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    const std::string path = argc > 1 ? argv[1] : "/tmp/tracecheck.json";
+    UTIL::Tracer &tracer = UTIL::tracer();
+    tracer.setEnabled(true);
+
+    // Both record at once; async spans begin on "first" and end on "second"
+    std::vector<uint64_t> ids;
+    std::atomic<bool> begun{false};
+    std::thread first([&]
+                      {
+                          tracer.nameThread("first \"worker\"");
+                          for (int round = 0; round < ROUNDS; ++round)
+                              nest(0);
+                          for (int i = 0; i < ASYNC; ++i)
+                              ids.push_back(UTIL::traceAsyncBegin("queued", "check", i));
+                          begun.store(true, std::memory_order_release); });
+    std::thread second([&]
+                       {
+                           tracer.nameThread("second");
+                           for (int round = 0; round < ROUNDS; ++round)
+                           {
+                               UTIL::TraceScope scope("round", "check", round);
+                               nest(1);
+                           }
+                           while (!begun.load(std::memory_order_acquire))
+                               std::this_thread::yield();
+                           for (const uint64_t id : ids)
+                               UTIL::traceAsyncEnd(id, "queued", "check"); });
+    first.join();
+    second.join();
+
+    size_t events = 0;
+    uint64_t dropped = 0;
+    if (!tracer.dumpChromeTrace(path, &events, &dropped))
+    {
+        std::fprintf(stderr, "cannot write %s\n", path.c_str());
+        return 1;
+    }
+    nlohmann::json trace;
+    try
+    {
+        std::ifstream(path) >> trace;
+    }
+    catch (const std::exception &e)
+    {
+        std::fprintf(stderr, "%s is not valid JSON: %s\n", path.c_str(), e.what());
+        return 1;
+    }
+
+    bool ok = true;
+    const auto expect = [&](bool condition, const char *what)
+    {
+        if (!condition)
+            std::fprintf(stderr, "%s\n", what);
+        ok &= condition;
+    };
+
+    // Rings get tids in the order threads first touch the tracer, so look them up by name
+    std::map<unsigned, size_t> recorded;
+    std::map<unsigned, std::vector<Span>> complete;
+    std::map<unsigned, std::string> names;
+    std::map<std::string, std::pair<int, long long>> begins, ends; // id: count, ts
+    for (const auto &event : trace.at("traceEvents"))
+    {
+        const std::string phase = event.at("ph");
+        const unsigned tid = event.at("tid");
+        if (phase == "M")
+            names[tid] = event.at("args").at("name");
+        else if (phase == "X")
+        {
+            const long long begin = nanoseconds(event.at("ts"));
+            complete[tid].push_back({begin, begin + nanoseconds(event.at("dur"))});
+        }
+        else if (phase == "b" || phase == "e")
+        {
+            auto &slot = (phase == "b" ? begins : ends)[event.at("id").get<std::string>()];
+            ++slot.first;
+            slot.second = nanoseconds(event.at("ts"));
+        }
+    }
+
+    expect(names.size() == 2, "expected two thread_name records");
+    for (const auto &[tid, name] : names)
+        recorded[tid] = name == "second" ? ROUNDS * (1 + scopes(1)) : ROUNDS * scopes(0);
+    expect(std::count_if(names.begin(), names.end(), [](const auto &entry)
+                         { return entry.second == "first \"worker\""; }) == 1,
+           "first thread's name did not survive escaping");
+    expect(complete.size() == 2, "expected complete events from two tids");
+    size_t total = 0;
+    for (auto &[tid, spans] : complete)
+    {
+        total += spans.size();
+        const auto expected = recorded.find(tid);
+        if (expected == recorded.end() || spans.size() != expected->second)
+        {
+            std::fprintf(stderr, "tid %u: %zu complete events, expected %zu\n", tid, spans.size(),
+                         expected == recorded.end() ? size_t{0} : expected->second);
+            ok = false;
+        }
+
+        // Outer spans first on equal starts; each span must end inside the one enclosing it
+        std::sort(spans.begin(), spans.end(), [](const Span &a, const Span &b)
+                  { return a.begin != b.begin ? a.begin < b.begin : a.end > b.end; });
+        std::vector<Span> open;
+        size_t deepest = 0, crossing = 0;
+        for (const Span &span : spans)
+        {
+            while (!open.empty() && open.back().end <= span.begin)
+                open.pop_back();
+            if (!open.empty() && span.end > open.back().end)
+                ++crossing;
+            open.push_back(span);
+            deepest = std::max(deepest, open.size());
+        }
+        std::printf("tid %u (%s): %zu complete events, nesting depth %zu, %zu crossing\n", tid, names[tid].c_str(),
+                    spans.size(), deepest, crossing);
+        expect(crossing == 0, "complete events overlap without nesting");
+        expect(deepest == DEPTH, "nesting depth differs from what was recorded");
+    }
+
+    size_t unpaired = 0;
+    for (const auto &[id, begin] : begins)
+    {
+        const auto end = ends.find(id);
+        unpaired += begin.first != 1 || end == ends.end() || end->second.first != 1 || end->second.second < begin.second ? 1 : 0;
+    }
+    std::printf("%zu async spans, %zu ends, %zu unpaired\n", begins.size(), ends.size(), unpaired);
+    expect(begins.size() == ASYNC && ends.size() == ASYNC && unpaired == 0, "async begin/end events do not pair up");
+    expect(events == total + begins.size() + ends.size() && dropped == 0, "dump reported a different event count");
+
+    // A second dump is empty: the first one drained the rings
+    size_t again = 0;
+    (void)tracer.drainChromeTrace(&again);
+    expect(again == 0, "a second drain returned events again");
+
+    // Past a full ring, events are dropped and counted, not overwritten
+    std::thread flood([]
+                      {
+                          for (size_t i = 0; i < UTIL::TRACE_THREAD_CAPACITY + 100; ++i)
+                              UTIL::TraceScope scope("flood", "check"); });
+    flood.join();
+    (void)tracer.drainChromeTrace(&events, &dropped);
+    std::printf("full ring: %zu kept, %llu dropped\n", events, static_cast<unsigned long long>(dropped));
+    expect(events == UTIL::TRACE_THREAD_CAPACITY && dropped == 100, "a full ring did not drop exactly the overflow");
+
+    std::remove(path.c_str());
+    std::puts(ok ? "ok" : "FAILED");
+    return ok ? 0 : 1;
+}